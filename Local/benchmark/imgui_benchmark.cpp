@@ -0,0 +1,2281 @@
+// Dear ImGui: headless benchmark
+// - Runs fixed workloads for N frames on a context with a pre-built font atlas and no renderer: draw data is generated but never submitted.
+// - Input is scripted (mouse path, clicks, wheel, keys) through the regular ImGuiIO event functions, so two runs submit the exact same frames.
+// - Also runs a few micro-benchmarks for core helpers (ID hashing, ImGuiStorage, ImGuiSelectionBasicStorage, ImDrawList primitives, text layout cache, concave polygon fill, UTF-8 decoding, deferred text).
+// - Exits with an error code when a correctness check fails (SIMD vs scalar draw list output, ID hashes vs a reference CRC, ...).
+// - Reports NewFrame()/EndFrame()/Render() timings, allocations and vertex/index counts as JSON, for regression tracking.
+// Usage:
+//   imgui_benchmark [--frames N] [--warmup N] [--workload NAME]... [--out FILE] [--profile] [--trace PREFIX] [--damage] [--verify-damage] [--rect-instances] [--compact-vtx] [--defer-text THREADS] [--shape-cache] [--text-layout-cache] [--list]
+//   --profile       record profiler zones during the measured frames (to measure the profiler overhead)
+//   --trace PREFIX  same including per-window zones, and write the recorded frames of each workload to PREFIX<workload>.json (Chrome Trace Event format)
+//   --damage        set ImGuiBackendFlags_RendererHasDamageRects and report the damaged area of each frame
+//   --verify-damage same, and render every frame with a software rasterizer both fully and only within the damage rectangles
+//                   (on top of the previous frame), then compare the two images pixel by pixel
+//   --rect-instances set ImGuiBackendFlags_RendererHasRectInstances and report the number of rectangle instances of each frame
+//                   (the software rasterizer expands them with a signed distance function)
+//   --compact-vtx   set ImGuiBackendFlags_RendererHasVtxCompact + ImGuiBackendFlags_RendererHasIdx32, check the converted buffers
+//                   against the regular ones, and report upload bytes with the alternate formats (always reported)
+//   --defer-text THREADS set io.ConfigDrawListsDeferText: text vertices are written during Render(), by THREADS threads including the main one
+//                   (1 = no worker pool). Output is the same for any number of threads.
+//   --shape-cache   set io.ConfigDrawListsShapeCache (see the 'gauges' workload and the 'shapes' micro-benchmark)
+//   --text-layout-cache set io.ConfigDrawListsTextLayoutCache (see the 'labels' workload and the 'text_layout' micro-benchmark)
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// [SECTION] Helpers
+//-----------------------------------------------------------------------------
+
+static double BenchGetTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Deterministic pseudo-random numbers (LCG), so every run uses the same inputs
+static unsigned int BenchRandom(unsigned int* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static float BenchRandomFloat(unsigned int* state, float min, float max)
+{
+    return min + (max - min) * (float)(BenchRandom(state) & 0xFFFF) / 65535.0f;
+}
+
+// Count every allocation made by Dear ImGui
+struct BenchAllocStats
+{
+    ImU64   Count;
+    ImU64   Bytes;
+};
+static BenchAllocStats GBenchAllocStats = { 0, 0 };
+
+static void* BenchMallocWrapper(size_t size, void* user_data)
+{
+    IM_UNUSED(user_data);
+    GBenchAllocStats.Count++;
+    GBenchAllocStats.Bytes += size;
+    return malloc(size);
+}
+
+static void BenchFreeWrapper(void* ptr, void* user_data)
+{
+    IM_UNUSED(user_data);
+    free(ptr);
+}
+
+// Number of failed correctness checks, main() returns an error code if not zero
+static int GBenchFailures = 0;
+
+// Per-frame samples of one measurement
+struct BenchSeries
+{
+    ImVector<double> Samples;
+
+    void    Add(double v)   { Samples.push_back(v); }
+    double  Mean() const    { double sum = 0.0; for (double v : Samples) sum += v; return Samples.Size ? sum / Samples.Size : 0.0; }
+    double  Max() const     { double m = 0.0; for (double v : Samples) m = ImMax(m, v); return m; }
+    double  Percentile(float p) const
+    {
+        if (Samples.Size == 0)
+            return 0.0;
+        ImVector<double> sorted;
+        sorted.resize(Samples.Size);
+        memcpy(sorted.Data, Samples.Data, (size_t)Samples.Size * sizeof(double));
+        ImQsort(sorted.Data, (size_t)sorted.Size, sizeof(double), [](const void* a, const void* b) { double da = *(const double*)a, db = *(const double*)b; return da < db ? -1 : da > db ? +1 : 0; });
+        return sorted[ImClamp((int)(p * (sorted.Size - 1) + 0.5f), 0, sorted.Size - 1)];
+    }
+};
+
+static void BenchWriteSeries(FILE* f, const char* name, const BenchSeries& series, bool last = false)
+{
+    fprintf(f, "      \"%s\": { \"mean\": %.5f, \"p50\": %.5f, \"p95\": %.5f, \"max\": %.5f }%s\n", name, series.Mean(), series.Percentile(0.50f), series.Percentile(0.95f), series.Max(), last ? "" : ",");
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Scripted input
+//-----------------------------------------------------------------------------
+
+// Mouse follows a Lissajous curve over the display, with a short click every 45 frames,
+// a wheel notch every 20 frames, and a few navigation keys.
+static void BenchFeedInput(ImGuiIO& io, int frame)
+{
+    const float t = frame / 60.0f;
+    io.AddMousePosEvent(io.DisplaySize.x * (0.5f + 0.45f * sinf(t * 1.3f)), io.DisplaySize.y * (0.5f + 0.45f * sinf(t * 1.7f + 0.5f)));
+    io.AddMouseButtonEvent(ImGuiMouseButton_Left, (frame % 45) >= 42);
+    if (frame % 20 == 0)
+        io.AddMouseWheelEvent(0.0f, ((frame / 20) % 8) < 4 ? -1.0f : +1.0f);
+    io.AddKeyEvent(ImGuiKey_DownArrow, (frame % 30) == 10);
+    io.AddKeyEvent(ImGuiKey_UpArrow, (frame % 90) == 50);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Frame workloads
+//-----------------------------------------------------------------------------
+
+static void BenchBeginFullscreenWindow(const char* name, ImGuiWindowFlags flags = 0)
+{
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(viewport->WorkPos);
+    ImGui::SetNextWindowSize(viewport->WorkSize);
+    ImGui::Begin(name, NULL, flags | ImGuiWindowFlags_NoSavedSettings);
+}
+
+static void Workload_Demo(int frame)
+{
+    ImGui::ShowDemoWindow();
+    if (frame == 0)
+    {
+        // Open the top-level sections, otherwise the demo is a list of collapsed headers
+        static const char* headers[] = { "Help", "Configuration", "Window options", "Widgets", "Layout & Scrolling", "Popups & Modal windows", "Tables & Columns", "Inputs & Focus" };
+        ImGui::SetWindowSize("Dear ImGui Demo", ImVec2(800.0f, 1000.0f));
+        ImGui::Begin("Dear ImGui Demo");
+        for (const char* header : headers)
+            ImGui::GetStateStorage()->SetInt(ImGui::GetID(header), 1);
+        ImGui::End();
+    }
+}
+
+static void TableWorkloadRow(int row)
+{
+    ImGui::PushID(row);
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::Text("%04d", row);
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted((row % 3) == 0 ? "Apricot" : (row % 3) == 1 ? "Banana" : "Cherry");
+    ImGui::TableNextColumn();
+    ImGui::SmallButton("Delete");
+    ImGui::TableNextColumn();
+    ImGui::Text("%d", (row * 7919) % 1000);
+    ImGui::TableNextColumn();
+    ImGui::ProgressBar(((row * 31) % 100) / 100.0f, ImVec2(-FLT_MIN, 0.0f));
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted("Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+    ImGui::PopID();
+}
+
+static void TableWorkload(int frame, bool use_clipper)
+{
+    const int ROWS_COUNT = 10000;
+    BenchBeginFullscreenWindow("Table");
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable;
+    if (ImGui::BeginTable("##table", 6, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Action", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Quantity");
+        ImGui::TableSetupColumn("Progress");
+        ImGui::TableSetupColumn("Description", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        if (use_clipper)
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin(ROWS_COUNT);
+            while (clipper.Step())
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                    TableWorkloadRow(row);
+        }
+        else
+        {
+            for (int row = 0; row < ROWS_COUNT; row++)
+                TableWorkloadRow(row);
+        }
+        ImGui::SetScrollY(fmodf(frame * 53.0f, ImMax(ImGui::GetScrollMaxY(), 1.0f)));
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void Workload_Table10k(int frame)          { TableWorkload(frame, true); }
+static void Workload_Table10kNoClipper(int frame) { TableWorkload(frame, false); }
+
+// A table with 64 narrow columns all visible at once (as in a register or parameter map): one draw channel per column to merge every frame
+static void Workload_Table64Columns(int frame)
+{
+    const int COLUMNS_COUNT = 64;
+    const int ROWS_COUNT = 1000;
+    BenchBeginFullscreenWindow("Table 64 Columns");
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("##table", COLUMNS_COUNT, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        for (int column = 0; column < COLUMNS_COUNT; column++)
+        {
+            char label[8];
+            ImFormatString(label, IM_ARRAYSIZE(label), "%02X", column);
+            ImGui::TableSetupColumn(label, ImGuiTableColumnFlags_WidthFixed, 20.0f);
+        }
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(ROWS_COUNT);
+        while (clipper.Step())
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                ImGui::TableNextRow();
+                for (int column = 0; column < COLUMNS_COUNT; column++)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%02X", (row * 31 + column * 7 + frame / 30) & 0xFF);
+                }
+            }
+        ImGui::SetScrollY(fmodf(frame * 53.0f, ImMax(ImGui::GetScrollMaxY(), 1.0f)));
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static ImGuiTextBuffer GBenchLargeText;
+
+static void Workload_LargeText(int frame)
+{
+    if (GBenchLargeText.empty())
+        for (int n = 0; n < 100000; n++)
+            GBenchLargeText.appendf("%06d The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs.\n", n);
+    BenchBeginFullscreenWindow("Large Text");
+    ImGui::BeginChild("##text", ImVec2(0.0f, 0.0f), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+    ImGui::TextUnformatted(GBenchLargeText.begin(), GBenchLargeText.end());
+    ImGui::SetScrollY(fmodf(frame * 997.0f, ImMax(ImGui::GetScrollMaxY(), 1.0f)));
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+// A log growing by a few lines every frame and following its last line, as with a telemetry log.
+// The indexed variant uses ImGui::TextUnformattedIndexed() which only processes visible and new lines, the regular one scans the whole log.
+// Both produce the same draw data.
+static ImGuiTextBuffer GBenchLargeLog[2];
+static int GBenchLargeLogLines[2] = {};
+static ImGuiTextIndex GBenchLargeLogIndex;
+
+static void LargeLogWorkload(bool indexed)
+{
+    ImGuiTextBuffer& log = GBenchLargeLog[indexed ? 1 : 0];
+    int& lines = GBenchLargeLogLines[indexed ? 1 : 0];
+    const int new_lines = (lines == 0) ? 100000 : 20;
+    for (int n = 0; n < new_lines; n++, lines++)
+        log.appendf("[%07d] knob %d: position %.3f, velocity %.3f, detent %d\n", lines, lines % 4, sinf(lines * 0.01f), cosf(lines * 0.01f), lines % 24);
+    BenchBeginFullscreenWindow("Large Log");
+    ImGui::BeginChild("##log", ImVec2(0.0f, 0.0f), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+    if (indexed)
+        ImGui::TextUnformattedIndexed(log.begin(), log.end(), &GBenchLargeLogIndex);
+    else
+        ImGui::TextUnformatted(log.begin(), log.end());
+    if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+        ImGui::SetScrollHereY(1.0f);
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+static void Workload_LargeLog(int)          { LargeLogWorkload(false); }
+static void Workload_LargeLogIndexed(int)   { LargeLogWorkload(true); }
+
+static void DeepTreeNode(int depth, int index)
+{
+    const int BRANCHES = 2;
+    const int MAX_DEPTH = 12;
+    for (int n = 0; n < BRANCHES; n++)
+    {
+        ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+        const int child_index = index * BRANCHES + n;
+        if (depth + 1 < MAX_DEPTH)
+        {
+            if (ImGui::TreeNode((void*)(intptr_t)child_index, "Node %d (depth %d)", child_index, depth))
+            {
+                DeepTreeNode(depth + 1, child_index);
+                ImGui::TreePop();
+            }
+        }
+        else
+        {
+            ImGui::TreeNodeEx((void*)(intptr_t)child_index, ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen, "Leaf %d", child_index);
+        }
+    }
+}
+
+// A binary tree 12 levels deep, all open. The hashed variant opts the window's state storage (open state of each node) into ImGuiStorage::SetHashIndex().
+static void DeepTreeWorkload(int frame, bool hashed)
+{
+    BenchBeginFullscreenWindow("Deep Tree");
+    if (hashed)
+        ImGui::GetStateStorage()->SetHashIndex(true);
+    DeepTreeNode(0, 1);
+    ImGui::SetScrollY(fmodf(frame * 211.0f, ImMax(ImGui::GetScrollMaxY(), 1.0f)));
+    ImGui::End();
+}
+
+static void Workload_DeepTree(int frame)        { DeepTreeWorkload(frame, false); }
+static void Workload_DeepTreeHashed(int frame)  { DeepTreeWorkload(frame, true); }
+
+static void Workload_Docking(int frame)
+{
+    const int WINDOWS_COUNT = 48;
+    const ImGuiID dockspace_id = ImHashStr("BenchDockSpace");
+    if (frame == 0)
+    {
+        // Four nodes, 12 tabbed windows each
+        const ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImGui::DockBuilderRemoveNode(dockspace_id);
+        ImGui::DockBuilderAddNode(dockspace_id, ImGuiDockNodeFlags_DockSpace);
+        ImGui::DockBuilderSetNodeSize(dockspace_id, viewport->WorkSize);
+        ImGuiID left, right, nodes[4];
+        ImGui::DockBuilderSplitNode(dockspace_id, ImGuiDir_Left, 0.5f, &left, &right);
+        ImGui::DockBuilderSplitNode(left, ImGuiDir_Up, 0.5f, &nodes[0], &nodes[1]);
+        ImGui::DockBuilderSplitNode(right, ImGuiDir_Up, 0.5f, &nodes[2], &nodes[3]);
+        for (int n = 0; n < WINDOWS_COUNT; n++)
+        {
+            char name[32];
+            ImFormatString(name, IM_ARRAYSIZE(name), "Docked %02d", n);
+            ImGui::DockBuilderDockWindow(name, nodes[n % 4]);
+        }
+        ImGui::DockBuilderFinish(dockspace_id);
+    }
+    ImGui::DockSpaceOverViewport(dockspace_id);
+
+    static float values[WINDOWS_COUNT][64];
+    static bool checked[WINDOWS_COUNT];
+    for (int n = 0; n < WINDOWS_COUNT; n++)
+    {
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Docked %02d", n);
+        ImGui::Begin(name);
+        ImGui::Text("Window %d, frame %d", n, frame);
+        ImGui::Button("Button");
+        ImGui::SameLine();
+        ImGui::Checkbox("Check", &checked[n]);
+        ImGui::SliderFloat("Slider", &values[n][1], 0.0f, 1.0f);
+        for (int i = 0; i < 64; i++)
+            values[n][i] = sinf((frame + i + n) * 0.1f);
+        ImGui::PlotLines("Lines", values[n], 64, 0, NULL, -1.0f, 1.0f, ImVec2(0.0f, 80.0f));
+        ImGui::End();
+    }
+}
+
+// A grid of static control panels (as in a mixer/controller app): data only changes twice per second.
+// The retained variant uses ImGuiWindowRefreshFlags_RefreshOnChange so only hovered windows and windows with new data are rebuilt.
+static void StaticPanelsWorkload(int frame, bool retained)
+{
+    const int PANELS_X = 4;
+    const int PANELS_Y = 4;
+    const int CHANNELS = 4;
+    const int DATA_PERIOD = 30;
+    static float volumes[PANELS_X * PANELS_Y][CHANNELS];
+    static bool mutes[PANELS_X * PANELS_Y][CHANNELS];
+    static float history[PANELS_X * PANELS_Y][32];
+
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    const ImVec2 panel_size(viewport->WorkSize.x / PANELS_X, viewport->WorkSize.y / PANELS_Y);
+    const int data_version = frame / DATA_PERIOD;
+    for (int n = 0; n < PANELS_X * PANELS_Y; n++)
+    {
+        // Data of each panel is updated at a different frame
+        const ImU32 content_version = (ImU32)((frame + n) / DATA_PERIOD);
+        if (frame == 0 || (frame + n) % DATA_PERIOD == 0)
+        {
+            for (int c = 0; c < CHANNELS; c++)
+                volumes[n][c] = 0.5f + 0.5f * sinf((float)(data_version + n + c));
+            for (int i = 0; i < IM_ARRAYSIZE(history[n]); i++)
+                history[n][i] = 0.5f + 0.5f * sinf((data_version + i + n) * 0.3f);
+        }
+
+        char name[32];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Panel %02d", n);
+        ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + (n % PANELS_X) * panel_size.x, viewport->WorkPos.y + (n / PANELS_X) * panel_size.y));
+        ImGui::SetNextWindowSize(panel_size);
+        if (retained)
+            ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags_RefreshOnChange, content_version);
+        if (ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings))
+        {
+            ImGui::Text("Endpoint %d", n);
+            for (int c = 0; c < CHANNELS; c++)
+            {
+                ImGui::PushID(c);
+                ImGui::Checkbox("##mute", &mutes[n][c]);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x * 0.5f);
+                ImGui::SliderFloat("##volume", &volumes[n][c], 0.0f, 1.0f, "%.2f");
+                ImGui::SameLine();
+                ImGui::ProgressBar(volumes[n][c], ImVec2(-FLT_MIN, 0.0f));
+                ImGui::PopID();
+            }
+            ImGui::Button("Default");
+            ImGui::SameLine();
+            ImGui::Button("Solo");
+            ImGui::SameLine();
+            ImGui::Button("Reset");
+            ImGui::PlotHistogram("##history", history[n], IM_ARRAYSIZE(history[n]), 0, NULL, 0.0f, 1.0f, ImVec2(-FLT_MIN, ImGui::GetContentRegionAvail().y));
+        }
+        ImGui::End();
+    }
+}
+
+// Custom rendering of more than 64K vertices in a single window (needs VtxOffset or 32-bit indices)
+static void Workload_LargeMesh(int frame)
+{
+    const int POINTS_COUNT = 20000;
+    const int MARKERS_COUNT = 2000;
+    static ImVector<ImVec2> points;
+    points.resize(POINTS_COUNT);
+    BenchBeginFullscreenWindow("Large Mesh");
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+    const ImVec2 size = ImGui::GetContentRegionAvail();
+    for (int n = 0; n < POINTS_COUNT; n++)
+        points[n] = ImVec2(p0.x + size.x * n / (POINTS_COUNT - 1), p0.y + size.y * (0.5f + 0.4f * sinf(n * 0.01f + frame * 0.05f)));
+    draw_list->AddPolyline(points.Data, points.Size, IM_COL32(255, 200, 0, 255), ImDrawFlags_None, 2.0f);
+    for (int n = 0; n < MARKERS_COUNT; n++)
+        draw_list->AddCircleFilled(points[n * (POINTS_COUNT / MARKERS_COUNT)], 3.0f, IM_COL32(0, 160, 255, 255));
+    ImGui::End();
+}
+
+// A wall of rotary gauges drawn with ImDrawList (as in a controller app): many circles of the same few sizes
+static void Workload_Gauges(int frame)
+{
+    const int GAUGES_X = 24;
+    const int GAUGES_Y = 12;
+    const float A_MIN = IM_PI * 0.75f;
+    const float A_MAX = IM_PI * 2.25f;
+    BenchBeginFullscreenWindow("Gauges");
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 p0 = ImGui::GetCursorScreenPos();
+    const ImVec2 size = ImGui::GetContentRegionAvail();
+    const float cell = ImMin(size.x / GAUGES_X, size.y / GAUGES_Y);
+    const float radius = cell * 0.4f;
+    for (int n = 0; n < GAUGES_X * GAUGES_Y; n++)
+    {
+        const ImVec2 center(p0.x + (n % GAUGES_X + 0.5f) * cell, p0.y + (n / GAUGES_X + 0.5f) * cell);
+        const float a = A_MIN + (A_MAX - A_MIN) * (0.5f + 0.5f * sinf(frame * 0.05f + n * 0.37f));
+        draw_list->AddCircleFilled(center, radius, IM_COL32(40, 40, 48, 255));
+        draw_list->AddCircle(center, radius, IM_COL32(90, 90, 100, 255), 0, 2.0f);
+        draw_list->PathArcTo(center, radius - 4.0f, A_MIN, a);
+        draw_list->PathStroke(IM_COL32(0, 180, 255, 255), ImDrawFlags_None, 3.0f);
+        draw_list->AddCircleFilled(center, radius * 0.55f, IM_COL32(70, 70, 80, 255));
+        draw_list->AddNgon(center, radius * 0.55f, IM_COL32(20, 20, 24, 255), 12, 1.0f);
+        draw_list->AddLine(center, ImVec2(center.x + cosf(a) * radius * 0.5f, center.y + sinf(a) * radius * 0.5f), IM_COL32_WHITE, 2.0f);
+        draw_list->AddCircleFilled(ImVec2(center.x + cosf(A_MIN) * radius * 0.8f, center.y + sinf(A_MIN) * radius * 0.8f), 2.0f, IM_COL32(255, 80, 80, 255));
+        draw_list->AddCircleFilled(ImVec2(center.x + cosf(A_MAX) * radius * 0.8f, center.y + sinf(A_MAX) * radius * 0.8f), 2.0f, IM_COL32(255, 80, 80, 255));
+    }
+    ImGui::End();
+}
+
+// Property editor: mostly static labels and word-wrapped help text, with a few values changing every frame (see --text-layout-cache)
+static void Workload_Labels(int frame)
+{
+    static const char* names[] = { "Position", "Rotation", "Scale", "Velocity", "Mass", "Friction", "Restitution", "Damping" };
+    BenchBeginFullscreenWindow("Labels");
+    for (int n = 0; n < 160; n++)
+    {
+        ImGui::PushID(n);
+        for (int column = 0; column < 4; column++)
+        {
+            const int item = n * 4 + column;
+            if (column > 0)
+                ImGui::SameLine(column * 320.0f);
+            ImGui::Text("%s %d", names[item % IM_ARRAYSIZE(names)], item / IM_ARRAYSIZE(names));
+            ImGui::SameLine(column * 320.0f + 130.0f);
+            if (item % 16 == 0)
+                ImGui::Text("%.3f", sinf(frame * 0.05f + item));
+            else
+                ImGui::TextUnformatted("(default)");
+            ImGui::SameLine(column * 320.0f + 220.0f);
+            ImGui::PushID(column);
+            ImGui::SmallButton("Reset");
+            ImGui::PopID();
+        }
+        if (n % 8 == 7)
+        {
+            ImGui::PushTextWrapPos(600.0f);
+            ImGui::Text("%s: the values above apply to every body of group %d. Changes are applied on the next simulation step, reset restores the default value.", names[n / 8 % IM_ARRAYSIZE(names)], n / 8);
+            ImGui::PopTextWrapPos();
+        }
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+static void Workload_StaticPanels(int frame)          { StaticPanelsWorkload(frame, false); }
+static void Workload_StaticPanelsRetained(int frame)  { StaticPanelsWorkload(frame, true); }
+
+struct BenchWorkload
+{
+    const char* Name;
+    void        (*Frame)(int frame);
+};
+
+static const BenchWorkload GBenchWorkloads[] =
+{
+    { "demo",                   Workload_Demo },
+    { "table_10k",              Workload_Table10k },
+    { "table_10k_noclip",       Workload_Table10kNoClipper },
+    { "table_64col",            Workload_Table64Columns },
+    { "large_text",             Workload_LargeText },
+    { "large_log",              Workload_LargeLog },
+    { "large_log_indexed",      Workload_LargeLogIndexed },
+    { "deep_tree",              Workload_DeepTree },
+    { "deep_tree_hashed",       Workload_DeepTreeHashed },
+    { "docking_48",             Workload_Docking },
+    { "static_panels",          Workload_StaticPanels },
+    { "static_panels_retained", Workload_StaticPanelsRetained },
+    { "large_mesh",             Workload_LargeMesh },
+    { "gauges",                 Workload_Gauges },
+    { "labels",                 Workload_Labels },
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Software rasterizer (damage rectangles verification)
+//-----------------------------------------------------------------------------
+
+// Minimal reference rasterizer: samples at pixel centers, nearest texture filtering, non-premultiplied alpha blending.
+// The result of a pixel never depends on the scissor rectangle, so drawing a frame in several scissored passes
+// gives the exact same image as drawing it in one pass.
+struct BenchRasterImage
+{
+    int             Width = 0;
+    int             Height = 0;
+    ImVector<ImU32> Pixels;
+
+    void    Create(int w, int h)    { Width = w; Height = h; Pixels.resize(w * h); }
+};
+
+static void BenchRasterClear(BenchRasterImage* image, int x0, int y0, int x1, int y1)
+{
+    for (int y = y0; y < y1; y++)
+        for (int x = x0; x < x1; x++)
+            image->Pixels[y * image->Width + x] = IM_COL32(16, 16, 16, 255);
+}
+
+static inline ImU32 BenchRasterBlend(ImU32 dst, const int src[4])
+{
+    const int a = src[3];
+    ImU32 out = IM_COL32_A_MASK;
+    for (int c = 0; c < 3; c++)
+        out |= (ImU32)((src[c] * a + (int)((dst >> (c * 8)) & 0xFF) * (255 - a) + 127) / 255) << (c * 8);
+    return out;
+}
+
+static void BenchRasterTriangle(BenchRasterImage* image, const BenchRasterImage& tex, const ImDrawVert* v[3], const ImVec2& origin, const ImVec2& scale, int clip_x0, int clip_y0, int clip_x1, int clip_y1)
+{
+    ImVec2 p[3];
+    for (int n = 0; n < 3; n++)
+        p[n] = ImVec2((v[n]->pos.x - origin.x) * scale.x, (v[n]->pos.y - origin.y) * scale.y);
+    const int x0 = ImMax(clip_x0, (int)floorf(ImMin(ImMin(p[0].x, p[1].x), p[2].x)));
+    const int y0 = ImMax(clip_y0, (int)floorf(ImMin(ImMin(p[0].y, p[1].y), p[2].y)));
+    const int x1 = ImMin(clip_x1, (int)ceilf(ImMax(ImMax(p[0].x, p[1].x), p[2].x)));
+    const int y1 = ImMin(clip_y1, (int)ceilf(ImMax(ImMax(p[0].y, p[1].y), p[2].y)));
+    const float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+    if (area == 0.0f || x0 >= x1 || y0 >= y1)
+        return;
+
+    // Edge functions as e(x,y) = a*x + b*y + c, normalized so that they are barycentric weights
+    float ea[3], eb[3], ec[3];
+    for (int n = 0; n < 3; n++)
+    {
+        const ImVec2& pa = p[(n + 1) % 3];
+        const ImVec2& pb = p[(n + 2) % 3];
+        ea[n] = -(pb.y - pa.y) / area;
+        eb[n] = (pb.x - pa.x) / area;
+        ec[n] = -(ea[n] * pa.x + eb[n] * pa.y);
+    }
+
+    // Solid color and texture coordinates: the source color is the same for all pixels
+    const bool flat = v[0]->col == v[1]->col && v[0]->col == v[2]->col && v[0]->uv.x == v[1]->uv.x && v[0]->uv.y == v[1]->uv.y && v[0]->uv.x == v[2]->uv.x && v[0]->uv.y == v[2]->uv.y;
+    int flat_src[4] = {};
+    if (flat)
+    {
+        const ImU32 texel = tex.Pixels[ImClamp((int)(v[0]->uv.y * tex.Height), 0, tex.Height - 1) * tex.Width + ImClamp((int)(v[0]->uv.x * tex.Width), 0, tex.Width - 1)];
+        for (int c = 0; c < 4; c++)
+            flat_src[c] = (int)(((v[0]->col >> (c * 8)) & 0xFF) * ((texel >> (c * 8)) & 0xFF) / 255.0f + 0.5f);
+    }
+
+    for (int y = y0; y < y1; y++)
+    {
+        const float py = y + 0.5f;
+        ImU32* row = &image->Pixels[y * image->Width];
+        for (int x = x0; x < x1; x++)
+        {
+            const float px = x + 0.5f;
+            const float w0 = ea[0] * px + eb[0] * py + ec[0];
+            const float w1 = ea[1] * px + eb[1] * py + ec[1];
+            const float w2 = ea[2] * px + eb[2] * py + ec[2];
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                continue;
+            if (flat)
+            {
+                row[x] = BenchRasterBlend(row[x], flat_src);
+                continue;
+            }
+            const float u = w0 * v[0]->uv.x + w1 * v[1]->uv.x + w2 * v[2]->uv.x;
+            const float t = w0 * v[0]->uv.y + w1 * v[1]->uv.y + w2 * v[2]->uv.y;
+            const ImU32 texel = tex.Pixels[ImClamp((int)(t * tex.Height), 0, tex.Height - 1) * tex.Width + ImClamp((int)(u * tex.Width), 0, tex.Width - 1)];
+            int src[4];
+            for (int c = 0; c < 4; c++)
+            {
+                const float col = w0 * ((v[0]->col >> (c * 8)) & 0xFF) + w1 * ((v[1]->col >> (c * 8)) & 0xFF) + w2 * ((v[2]->col >> (c * 8)) & 0xFF);
+                src[c] = (int)(col * ((texel >> (c * 8)) & 0xFF) / 255.0f + 0.5f);
+            }
+            row[x] = BenchRasterBlend(row[x], src);
+        }
+    }
+}
+
+// Reference expansion of an ImDrawRectInstance: coverage from the signed distance to the (rounded) rectangle, 1 pixel anti-aliasing.
+static void BenchRasterRectInstance(BenchRasterImage* image, const ImDrawRectInstance& inst, const ImVec2& origin, const ImVec2& scale, int clip_x0, int clip_y0, int clip_x1, int clip_y1)
+{
+    const ImVec2 p_min((inst.Min.x - origin.x) * scale.x, (inst.Min.y - origin.y) * scale.y);
+    const ImVec2 p_max((inst.Max.x - origin.x) * scale.x, (inst.Max.y - origin.y) * scale.y);
+    const float half_thickness = inst.Thickness * scale.x * 0.5f;
+    const float pad = half_thickness + 1.0f;
+    const int x0 = ImMax(clip_x0, (int)floorf(p_min.x - pad));
+    const int y0 = ImMax(clip_y0, (int)floorf(p_min.y - pad));
+    const int x1 = ImMin(clip_x1, (int)ceilf(p_max.x + pad));
+    const int y1 = ImMin(clip_y1, (int)ceilf(p_max.y + pad));
+    const ImVec2 center((p_min.x + p_max.x) * 0.5f, (p_min.y + p_max.y) * 0.5f);
+    const ImVec2 half_size((p_max.x - p_min.x) * 0.5f, (p_max.y - p_min.y) * 0.5f);
+    int src[4];
+    for (int c = 0; c < 4; c++)
+        src[c] = (int)((inst.Col >> (c * 8)) & 0xFF);
+    const int src_a = src[3];
+
+    for (int y = y0; y < y1; y++)
+    {
+        const float qy = y + 0.5f - center.y;
+        ImU32* row = &image->Pixels[y * image->Width];
+        for (int x = x0; x < x1; x++)
+        {
+            const float qx = x + 0.5f - center.x;
+            const ImDrawFlags corner = (qx < 0.0f) ? ((qy < 0.0f) ? ImDrawFlags_RoundCornersTopLeft : ImDrawFlags_RoundCornersBottomLeft) : ((qy < 0.0f) ? ImDrawFlags_RoundCornersTopRight : ImDrawFlags_RoundCornersBottomRight);
+            const float r = (inst.Flags & corner) ? inst.Rounding * scale.x : 0.0f;
+            const float dx = ImFabs(qx) - half_size.x + r;
+            const float dy = ImFabs(qy) - half_size.y + r;
+            const float dist = ImSqrt(ImMax(dx, 0.0f) * ImMax(dx, 0.0f) + ImMax(dy, 0.0f) * ImMax(dy, 0.0f)) + ImMin(ImMax(dx, dy), 0.0f) - r;
+            const float coverage = ImSaturate((inst.Thickness > 0.0f) ? (half_thickness + 0.5f - ImFabs(dist)) : (0.5f - dist));
+            if (coverage <= 0.0f)
+                continue;
+            src[3] = (int)(src_a * coverage + 0.5f);
+            row[x] = BenchRasterBlend(row[x], src);
+        }
+    }
+}
+
+// Draw all lists of 'draw_data', restricted to 'scissor' (in framebuffer pixels)
+static void BenchRasterDrawData(BenchRasterImage* image, const BenchRasterImage& tex, const ImDrawData* draw_data, int sx0, int sy0, int sx1, int sy1)
+{
+    const ImVec2 origin = draw_data->DisplayPos;
+    const ImVec2 scale = draw_data->FramebufferScale;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            if (cmd.UserCallback != NULL)
+                continue;
+            const int clip_x0 = ImMax(sx0, (int)((cmd.ClipRect.x - origin.x) * scale.x));
+            const int clip_y0 = ImMax(sy0, (int)((cmd.ClipRect.y - origin.y) * scale.y));
+            const int clip_x1 = ImMin(sx1, (int)((cmd.ClipRect.z - origin.x) * scale.x));
+            const int clip_y1 = ImMin(sy1, (int)((cmd.ClipRect.w - origin.y) * scale.y));
+            if (clip_x1 <= clip_x0 || clip_y1 <= clip_y0)
+                continue;
+            for (unsigned int n = 0; n < cmd.RectInstCount; n++)
+                BenchRasterRectInstance(image, draw_list->RectInstBuffer[cmd.RectInstOffset + n], origin, scale, clip_x0, clip_y0, clip_x1, clip_y1);
+            const ImDrawIdx* idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+            const ImDrawVert* vtx = draw_list->VtxBuffer.Data + cmd.VtxOffset;
+            for (unsigned int n = 0; n + 2 < cmd.ElemCount; n += 3)
+            {
+                const ImDrawVert* tri[3] = { &vtx[idx[n]], &vtx[idx[n + 1]], &vtx[idx[n + 2]] };
+                BenchRasterTriangle(image, tex, tri, origin, scale, clip_x0, clip_y0, clip_x1, clip_y1);
+            }
+        }
+}
+
+// Track a full render and a damage-only render of the same frames
+struct BenchDamageVerifier
+{
+    BenchRasterImage    Texture;
+    BenchRasterImage    Full;
+    BenchRasterImage    Partial;    // Persistent: only damage rectangles are redrawn
+    int                 Frames = 0;
+    int                 MismatchFrames = 0;
+    ImS64               MismatchPixels = 0;
+
+    void    Init(ImFontAtlas* atlas, int w, int h)
+    {
+        unsigned char* tex_pixels;
+        int tex_w, tex_h;
+        atlas->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+        Texture.Create(tex_w, tex_h);
+        memcpy(Texture.Pixels.Data, tex_pixels, (size_t)Texture.Pixels.size_in_bytes());
+        Full.Create(w, h);
+        Partial.Create(w, h);
+        BenchRasterClear(&Partial, 0, 0, w, h);
+    }
+
+    void    Verify(const ImDrawData* draw_data)
+    {
+        BenchRasterClear(&Full, 0, 0, Full.Width, Full.Height);
+        BenchRasterDrawData(&Full, Texture, draw_data, 0, 0, Full.Width, Full.Height);
+        if (!draw_data->DamageRectsValid)
+        {
+            memcpy(Partial.Pixels.Data, Full.Pixels.Data, (size_t)Full.Pixels.size_in_bytes());
+            return;
+        }
+        const ImVec2 origin = draw_data->DisplayPos;
+        const ImVec2 scale = draw_data->FramebufferScale;
+        for (const ImVec4& r : draw_data->DamageRects)
+        {
+            const int x0 = ImMax(0, (int)((r.x - origin.x) * scale.x));
+            const int y0 = ImMax(0, (int)((r.y - origin.y) * scale.y));
+            const int x1 = ImMin(Partial.Width, (int)((r.z - origin.x) * scale.x));
+            const int y1 = ImMin(Partial.Height, (int)((r.w - origin.y) * scale.y));
+            BenchRasterClear(&Partial, x0, y0, x1, y1);
+            BenchRasterDrawData(&Partial, Texture, draw_data, x0, y0, x1, y1);
+        }
+        int mismatch_pixels = 0;
+        for (int n = 0; n < Full.Pixels.Size; n++)
+            if (Full.Pixels[n] != Partial.Pixels[n])
+                mismatch_pixels++;
+        Frames++;
+        if (mismatch_pixels > 0)
+        {
+            MismatchFrames++;
+            MismatchPixels += mismatch_pixels;
+            memcpy(Partial.Pixels.Data, Full.Pixels.Data, (size_t)Full.Pixels.size_in_bytes()); // Resynchronize so each frame is checked independently
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Micro-benchmarks
+//-----------------------------------------------------------------------------
+
+// Each micro-benchmark adds one or more named results, in nanoseconds per operation
+struct BenchMicroResult
+{
+    char        Name[64];
+    double      NsPerOp;
+};
+
+static void BenchAddMicroResult(ImVector<BenchMicroResult>& results, const char* name, double seconds, double ops)
+{
+    BenchMicroResult result;
+    ImStrncpy(result.Name, name, IM_ARRAYSIZE(result.Name));
+    result.NsPerOp = seconds * 1e9 / ops;
+    results.push_back(result);
+}
+
+// Reference hashes: one byte at a time with a bitwise CRC (same polynomial as the lookup table selected by IMGUI_USE_CRC32C_HASH),
+// and resetting to the seed on every "###" as ImHashStr() used to.
+static ImU32 BenchCrcReference(ImU32 crc, unsigned char c)
+{
+#ifdef IMGUI_USE_CRC32C_HASH
+    const ImU32 poly = 0x82F63B78;
+#else
+    const ImU32 poly = 0xEDB88320;
+#endif
+    crc ^= c;
+    for (int bit = 0; bit < 8; bit++)
+        crc = (crc >> 1) ^ (poly & (0u - (crc & 1)));
+    return crc;
+}
+
+static ImGuiID BenchHashDataReference(const void* data, size_t data_size, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    for (size_t n = 0; n < data_size; n++)
+        crc = BenchCrcReference(crc, ((const unsigned char*)data)[n]);
+    return ~crc;
+}
+
+static ImGuiID BenchHashStrReference(const char* data, size_t data_size, ImGuiID seed)
+{
+    seed = ~seed;
+    ImU32 crc = seed;
+    const unsigned char* src = (const unsigned char*)data;
+    if (data_size != 0)
+    {
+        while (data_size-- != 0)
+        {
+            unsigned char c = *src++;
+            if (c == '#' && data_size >= 2 && src[0] == '#' && src[1] == '#')
+                crc = seed;
+            crc = BenchCrcReference(crc, c);
+        }
+    }
+    else
+    {
+        while (unsigned char c = *src++)
+        {
+            if (c == '#' && src[0] == '#' && src[1] == '#')
+                crc = seed;
+            crc = BenchCrcReference(crc, c);
+        }
+    }
+    return ~crc;
+}
+
+static int BenchCompareIDs(const void* a, const void* b)
+{
+    const ImGuiID ia = *(const ImGuiID*)a, ib = *(const ImGuiID*)b;
+    return ia < ib ? -1 : ia > ib ? +1 : 0;
+}
+
+// IM_LITERAL_ID() compared to hashing the same strings at runtime: ImHashStr() from several seeds, then GetID() and PushID() through the ID stack of a window.
+static int BenchCheckLiteralIDs()
+{
+    struct LiteralCase { const char* Str; ImGuiLiteralID LitId; };
+#define BENCH_LITERAL(_STR) { _STR, IM_LITERAL_ID(_STR) }
+    const LiteralCase cases[] =
+    {
+        BENCH_LITERAL(""), BENCH_LITERAL("#"), BENCH_LITERAL("##"), BENCH_LITERAL("###"), BENCH_LITERAL("####x"), BENCH_LITERAL("OK"),
+        BENCH_LITERAL("##VolumeSlider"), BENCH_LITERAL("Label##Suffix"), BENCH_LITERAL("trailing##"), BENCH_LITERAL("Title###StableWindowId"),
+        BENCH_LITERAL("a###b###c"), BENCH_LITERAL("##a###"), BENCH_LITERAL("###x"), BENCH_LITERAL("Some much longer label used in a tree node with text ##id_for_it"),
+    };
+#undef BENCH_LITERAL
+    int errors = 0;
+    unsigned int state = 1;
+    for (const LiteralCase& c : cases)
+    {
+        if (c.LitId.StrEnd - c.LitId.Str != (ptrdiff_t)strlen(c.Str) || ImHashLiteral(c.LitId) != ImHashStr(c.Str))
+            errors++;
+        for (int seed_n = 0; seed_n < 1000; seed_n++)
+        {
+            const ImGuiID seed = (seed_n < 2) ? (seed_n ? 0xFFFFFFFF : 1) : BenchRandom(&state) ^ (BenchRandom(&state) << 16);
+            if (ImHashLiteral(c.LitId, seed) != ImHashStr(c.Str, 0, seed))
+                errors++;
+        }
+    }
+
+    ImGuiContext* prev_ctx = ImGui::GetCurrentContext();
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(800.0f, 600.0f);
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImGui::NewFrame();
+    ImGui::Begin("Literal IDs");
+    ImGui::PushID("Parent");
+    ImGui::PushID(42);
+    for (const LiteralCase& c : cases)
+    {
+        if (ImGui::GetID(c.LitId) != ImGui::GetID(c.Str) || ImGui::GetCurrentWindow()->GetID(c.LitId) != ImGui::GetCurrentWindow()->GetID(c.Str))
+            errors++;
+        ImGui::PushID(c.LitId);
+        const ImGuiID child_id = ImGui::GetID("Child");
+        ImGui::PopID();
+        ImGui::PushID(c.Str);
+        if (ImGui::GetID("Child") != child_id)
+            errors++;
+        ImGui::PopID();
+    }
+    ImGui::PopID();
+    ImGui::PopID();
+    ImGui::End();
+    ImGui::EndFrame();
+    ImGui::DestroyContext(ctx);
+    ImGui::SetCurrentContext(prev_ctx);
+    return errors;
+}
+
+// ImHashData()/ImHashStr() compared to the reference hashes, on misaligned buffers and on strings made mostly of '#'.
+// Also checks literal IDs, and counts collisions over typical labels, which should stay close to the birthday bound of a 32-bit hash.
+static void Micro_HashStr(ImVector<BenchMicroResult>& results)
+{
+    int errors = 0;
+#ifdef IMGUI_USE_CRC32C_HASH
+    const ImGuiID check_value = 0xE3069283; // CRC-32C of "123456789"
+#else
+    const ImGuiID check_value = 0xCBF43926; // CRC-32 of "123456789"
+#endif
+    if (ImHashData("123456789", 9, 0) != check_value || BenchHashDataReference("123456789", 9, 0) != check_value)
+        errors++;
+
+    unsigned int state = 1;
+    unsigned char data[8 + 300];
+    for (int n = 0; n < 50000; n++)
+    {
+        const int offset = n % 8;
+        const int len = (int)(BenchRandom(&state) % 300);
+        for (int i = 0; i < len; i++)
+            data[offset + i] = (unsigned char)BenchRandom(&state);
+        const ImGuiID seed = (n % 3) ? BenchRandom(&state) : 0;
+        if (ImHashData(data + offset, (size_t)len, seed) != BenchHashDataReference(data + offset, (size_t)len, seed))
+            errors++;
+    }
+
+    char str[8 + 64 + 1];
+    for (int n = 0; n < 200000; n++)
+    {
+        static const char alphabet[] = "###a b";
+        const int offset = n % 8;
+        const int len = (int)(BenchRandom(&state) % 64);
+        for (int i = 0; i < len; i++)
+            str[offset + i] = alphabet[BenchRandom(&state) % (sizeof(alphabet) - 1)];
+        str[offset + len] = 0;
+        const ImGuiID seed = (n % 3) ? BenchRandom(&state) : 0;
+        const char* s = str + offset;
+        if (ImHashStr(s, 0, seed) != BenchHashStrReference(s, 0, seed))
+            errors++;
+        if (len > 0 && ImHashStr(s, (size_t)len, seed) != BenchHashStrReference(s, (size_t)len, seed))
+            errors++;
+        const size_t truncated_len = (size_t)(BenchRandom(&state) % (len + 1));
+        if (truncated_len > 0 && ImHashStr(s, truncated_len, seed) != BenchHashStrReference(s, truncated_len, seed))
+            errors++;
+    }
+    if (errors > 0)
+    {
+        fprintf(stderr, "hash: %d mismatches with reference hashes!\n", errors);
+        GBenchFailures++;
+    }
+    const int literal_errors = BenchCheckLiteralIDs();
+    if (literal_errors > 0)
+    {
+        fprintf(stderr, "hash: %d literal IDs differ from runtime IDs!\n", literal_errors);
+        GBenchFailures++;
+    }
+
+    // Collisions over 200k distinct labels, with the seeds of a few parent windows
+    const int LABELS_COUNT = 200000;
+    ImVector<ImGuiID> ids;
+    ids.resize(LABELS_COUNT);
+    char label[64];
+    for (int n = 0; n < LABELS_COUNT; n++)
+    {
+        static const char* formats[] = { "Item %d", "##row%d", "Channel###channel%d", "Button %d##toolbar" };
+        ImFormatString(label, IM_ARRAYSIZE(label), formats[n % IM_ARRAYSIZE(formats)], n / IM_ARRAYSIZE(formats));
+        ids[n] = ImHashStr(label, 0, ImHashStr((n % 8) < 4 ? "Window A" : "Window B"));
+    }
+    ImQsort(ids.Data, (size_t)ids.Size, sizeof(ImGuiID), BenchCompareIDs);
+    int collisions = 0;
+    for (int n = 1; n < ids.Size; n++)
+        if (ids[n] == ids[n - 1])
+            collisions++;
+    const double expected_collisions = (double)LABELS_COUNT * (LABELS_COUNT - 1) / 2.0 / 4294967296.0;
+    if (collisions > expected_collisions * 4 + 8)
+    {
+        fprintf(stderr, "hash: %d collisions over %d labels, expected about %.1f!\n", collisions, LABELS_COUNT, expected_collisions);
+        GBenchFailures++;
+    }
+
+    // Chained hashing of labels by length, then of a mix of typical labels
+    ImGuiID seed = 1;
+    const int label_lengths[] = { 4, 16, 64, 256 };
+    for (int len : label_lengths)
+    {
+        char labels[4][256 + 1];
+        for (int label_n = 0; label_n < 4; label_n++)
+        {
+            for (int i = 0; i < len; i++)
+                labels[label_n][i] = "abcdefghijklmnopqrstuvwxyz 0123456789"[(label_n * 7 + i) % 37];
+            labels[label_n][len] = 0;
+        }
+        const int iterations = 32000000 / (len + 16);
+        double t0 = BenchGetTime();
+        for (int n = 0; n < iterations; n++)
+            seed = ImHashStr(labels[n & 3], 0, seed);
+        char name[64];
+        ImFormatString(name, IM_ARRAYSIZE(name), "hash_str_%d", len);
+        BenchAddMicroResult(results, name, BenchGetTime() - t0, iterations);
+    }
+
+    static const char* labels[] = { "OK", "##VolumeSlider", "Output Device", "Application sessions list", "Title###StableWindowId", "Some much longer label used in a tree node with text ##id_for_it" };
+    const int ITERATIONS = 2000000;
+    double t0 = BenchGetTime();
+    for (int n = 0; n < ITERATIONS; n++)
+        seed = ImHashStr(labels[n % IM_ARRAYSIZE(labels)], 0, seed);
+    BenchAddMicroResult(results, "hash_str", BenchGetTime() - t0, ITERATIONS);
+
+    const ImGuiLiteralID literals[] = { IM_LITERAL_ID("OK"), IM_LITERAL_ID("##VolumeSlider"), IM_LITERAL_ID("Output Device"), IM_LITERAL_ID("Application sessions list"), IM_LITERAL_ID("Title###StableWindowId"), IM_LITERAL_ID("Some much longer label used in a tree node with text ##id_for_it") };
+    t0 = BenchGetTime();
+    for (int n = 0; n < ITERATIONS; n++)
+        seed = ImHashLiteral(literals[n % IM_ARRAYSIZE(literals)], seed);
+    BenchAddMicroResult(results, "hash_literal", BenchGetTime() - t0, ITERATIONS);
+    if (seed == 0)
+        printf("\n"); // Keep the result alive
+}
+
+// Storages of 10k, 100k and 1M keys: insertion of the last 10k keys (the others are added in bulk), then lookups of present and missing keys
+static void Micro_Storage(ImVector<BenchMicroResult>& results)
+{
+    const int INSERTS_COUNT = 10000;
+    const int keys_counts[] = { 10000, 100000, 1000000 };
+    for (int keys_count : keys_counts)
+        for (int hashed = 0; hashed < 2; hashed++)
+        {
+            // Keys are distinct: multiplying by an odd constant is a bijection
+            const char* mode = hashed ? "hashed" : "sorted";
+            const char* size = keys_count >= 1000000 ? "1m" : keys_count >= 100000 ? "100k" : "10k";
+            ImGuiStorage storage;
+            storage.SetHashIndex(hashed != 0);
+            storage.Data.reserve(keys_count);
+            for (int n = 0; n < keys_count - INSERTS_COUNT; n++)
+                storage.Data.push_back(ImGuiStoragePair((ImGuiID)(n + 1) * 2654435761u, n));
+            storage.BuildSortByKey();
+
+            char name[64];
+            double t0 = BenchGetTime();
+            for (int n = keys_count - INSERTS_COUNT; n < keys_count; n++)
+                storage.SetInt((ImGuiID)(n + 1) * 2654435761u, n);
+            ImFormatString(name, IM_ARRAYSIZE(name), "storage_%s_%s_insert", mode, size);
+            BenchAddMicroResult(results, name, BenchGetTime() - t0, INSERTS_COUNT);
+
+            ImU64 sum = 0;
+            t0 = BenchGetTime();
+            for (int n = 0; n < keys_count; n++)
+            {
+                const int key_n = (int)(((ImU64)n * 7919) % keys_count);
+                sum += (ImU64)storage.GetInt((ImGuiID)(key_n + 1) * 2654435761u);
+            }
+            ImFormatString(name, IM_ARRAYSIZE(name), "storage_%s_%s_lookup", mode, size);
+            BenchAddMicroResult(results, name, BenchGetTime() - t0, keys_count);
+
+            t0 = BenchGetTime();
+            for (int n = 0; n < keys_count; n++)
+                sum += (ImU64)storage.GetInt((ImGuiID)(keys_count + n + 1) * 2654435761u, 1);
+            ImFormatString(name, IM_ARRAYSIZE(name), "storage_%s_%s_lookup_miss", mode, size);
+            BenchAddMicroResult(results, name, BenchGetTime() - t0, keys_count);
+            if (sum == 0)
+                printf("\n");
+        }
+}
+
+static void Micro_Selection(ImVector<BenchMicroResult>& results)
+{
+    const int ITEMS_COUNT = 1000000;
+    for (int bitset = 0; bitset < 2; bitset++)
+    {
+        ImGuiSelectionBasicStorage selection;
+        selection.UseBitset = (bitset != 0);
+        ImGuiMultiSelectIO ms_io;
+        ms_io.ItemsCount = ITEMS_COUNT;
+        ImGuiSelectionRequest req;
+        req.RangeDirection = +1;
+        char name[64];
+
+        // Ctrl+A
+        req.Type = ImGuiSelectionRequestType_SetAll;
+        req.Selected = true;
+        ms_io.Requests.push_back(req);
+        double t0 = BenchGetTime();
+        selection.ApplyRequests(&ms_io);
+        ImFormatString(name, IM_ARRAYSIZE(name), "selection_%s_1m_select_all", bitset ? "bitset" : "sorted");
+        BenchAddMicroResult(results, name, BenchGetTime() - t0, 1);
+
+        // Click then Shift+Click over 900k items
+        ms_io.Requests.resize(0);
+        req.Type = ImGuiSelectionRequestType_SetAll;
+        req.Selected = false;
+        ms_io.Requests.push_back(req);
+        req.Type = ImGuiSelectionRequestType_SetRange;
+        req.Selected = true;
+        req.RangeFirstItem = req.RangeLastItem = 1000;
+        ms_io.Requests.push_back(req);
+        selection.ApplyRequests(&ms_io);
+        ms_io.Requests.resize(0);
+        req.RangeFirstItem = 1001;
+        req.RangeLastItem = 900000;
+        ms_io.Requests.push_back(req);
+        t0 = BenchGetTime();
+        selection.ApplyRequests(&ms_io);
+        ImFormatString(name, IM_ARRAYSIZE(name), "selection_%s_1m_shift_range", bitset ? "bitset" : "sorted");
+        BenchAddMicroResult(results, name, BenchGetTime() - t0, 1);
+
+        // Ctrl+Click toggles
+        const int TOGGLES_COUNT = 1000;
+        t0 = BenchGetTime();
+        for (int n = 0; n < TOGGLES_COUNT; n++)
+        {
+            const int idx = (int)(((ImU64)n * 7919 * 7919) % ITEMS_COUNT);
+            ms_io.Requests.resize(0);
+            req.RangeFirstItem = req.RangeLastItem = idx;
+            req.Selected = !selection.Contains((ImGuiID)idx);
+            ms_io.Requests.push_back(req);
+            selection.ApplyRequests(&ms_io);
+        }
+        ImFormatString(name, IM_ARRAYSIZE(name), "selection_%s_1m_ctrl_toggle", bitset ? "bitset" : "sorted");
+        BenchAddMicroResult(results, name, BenchGetTime() - t0, TOGGLES_COUNT);
+    }
+}
+
+// ImDrawList primitives with SIMD kernels, compared to their scalar version (ImDrawListSharedData::UseScalarKernels).
+// Both versions must produce bit-identical vertices and indices.
+
+static const int DRAWLIST_KERNELS_SHAPES = 16;
+static const int DRAWLIST_KERNELS_SHAPE_POINTS = 48;
+
+static void DrawListKernelsPrimitive(ImDrawList* draw_list, int primitive, int n, const ImVec2* shapes)
+{
+    const float x = (float)(n % 64) * 13.0f;
+    const float y = (float)(n % 37) * 17.0f + 0.25f;
+    switch (primitive)
+    {
+    case 0: draw_list->AddRectFilled(ImVec2(x, y), ImVec2(x + 40.5f, y + 12.0f), IM_COL32(200, 100, 50, 255)); break;
+    case 1: draw_list->AddImage((ImTextureID)1, ImVec2(x, y), ImVec2(x + 32.0f, y + 32.0f), ImVec2(0.25f, 0.0f), ImVec2(0.5f, 0.75f)); break;
+    case 2: draw_list->AddText(ImVec2(x, y), IM_COL32_WHITE, "The quick brown fox jumps over the lazy dog 0123456789"); break;
+    default:
+    {
+        // Wobbly circles: segments of varying lengths and angles. Convex polygons use every other point of a regular one.
+        ImVec2 points[DRAWLIST_KERNELS_SHAPE_POINTS];
+        const ImVec2* shape = &shapes[(primitive == 6 ? 0 : 1 + (n % (DRAWLIST_KERNELS_SHAPES - 1))) * DRAWLIST_KERNELS_SHAPE_POINTS];
+        const int points_count = (primitive == 6) ? DRAWLIST_KERNELS_SHAPE_POINTS / 2 : DRAWLIST_KERNELS_SHAPE_POINTS;
+        for (int i = 0; i < points_count; i++)
+            points[i] = ImVec2(x + shape[(primitive == 6) ? i * 2 : i].x, y + shape[(primitive == 6) ? i * 2 : i].y);
+        if (primitive == 3)
+            draw_list->AddPolyline(points, points_count, IM_COL32(255, 255, 0, 255), ImDrawFlags_None, 1.0f);
+        else if (primitive == 4)
+        {
+            draw_list->Flags &= ~ImDrawListFlags_AntiAliasedLinesUseTex;
+            draw_list->AddPolyline(points, points_count, IM_COL32(255, 255, 0, 255), ImDrawFlags_Closed, 1.0f);
+            draw_list->Flags |= ImDrawListFlags_AntiAliasedLinesUseTex;
+        }
+        else if (primitive == 5)
+            draw_list->AddPolyline(points, points_count, IM_COL32(255, 255, 0, 255), ImDrawFlags_None, 3.5f);
+        else
+            draw_list->AddConvexPolyFilled(points, points_count, IM_COL32(0, 128, 255, 255));
+        break;
+    }
+    }
+}
+
+// Setup shared data as NewFrame() would with default style, for ImDrawList used without a context
+static void BenchInitDrawListSharedData(ImDrawListSharedData* shared_data, ImFontAtlas* atlas)
+{
+    shared_data->TexUvWhitePixel = atlas->TexUvWhitePixel;
+    shared_data->TexUvLines = atlas->TexUvLines;
+    shared_data->Font = atlas->Fonts[0];
+    shared_data->FontSize = shared_data->Font->FontSize;
+    shared_data->FontScale = 1.0f;
+    shared_data->CurveTessellationTol = 1.25f;
+    shared_data->SetCircleTessellationMaxError(0.30f);
+    shared_data->InitialFlags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill;
+}
+
+static void Micro_DrawListKernels(ImVector<BenchMicroResult>& results)
+{
+    static const char* names[] = { "prim_rect", "prim_rect_uv", "text", "polyline_aa_tex", "polyline_aa_closed", "polyline_aa_thick", "convex_fill_aa" };
+    const int OPS_PER_BATCH = 500;
+    const int BATCHES = 40;
+
+    ImFontAtlas atlas;
+    atlas.AddFontDefault();
+    atlas.Build();
+    ImDrawListSharedData shared_data;
+    BenchInitDrawListSharedData(&shared_data, &atlas);
+
+    ImVector<ImVec2> shapes;
+    shapes.resize(DRAWLIST_KERNELS_SHAPES * DRAWLIST_KERNELS_SHAPE_POINTS);
+    for (int shape_n = 0; shape_n < DRAWLIST_KERNELS_SHAPES; shape_n++)
+        for (int i = 0; i < DRAWLIST_KERNELS_SHAPE_POINTS; i++)
+        {
+            const float a = (i * 2.0f * IM_PI) / DRAWLIST_KERNELS_SHAPE_POINTS;
+            const float r = 30.0f + (shape_n == 0 ? 0.0f : 6.0f * sinf(a * 5.0f + shape_n));
+            shapes[shape_n * DRAWLIST_KERNELS_SHAPE_POINTS + i] = ImVec2(40.0f + cosf(a) * r, 40.0f + sinf(a) * r);
+        }
+
+    ImDrawList draw_list_simd(&shared_data);
+    ImDrawList draw_list_scalar(&shared_data);
+    ImDrawList* draw_lists[2] = { &draw_list_simd, &draw_list_scalar };
+    for (int primitive = 0; primitive < IM_ARRAYSIZE(names); primitive++)
+    {
+        // Compare output of both versions, then time them
+        for (int scalar = 0; scalar < 2; scalar++)
+        {
+            shared_data.UseScalarKernels = (scalar != 0);
+            ImDrawList* draw_list = draw_lists[scalar];
+            draw_list->_ResetForNewFrame();
+            draw_list->PushClipRect(ImVec2(-8192.0f, -8192.0f), ImVec2(8192.0f, 8192.0f));
+            draw_list->PushTextureID(atlas.TexID);
+            for (int n = 0; n < OPS_PER_BATCH; n++)
+                DrawListKernelsPrimitive(draw_list, primitive, n, shapes.Data);
+        }
+        if (draw_list_simd.VtxBuffer.Size != draw_list_scalar.VtxBuffer.Size || draw_list_simd.IdxBuffer.Size != draw_list_scalar.IdxBuffer.Size
+            || memcmp(draw_list_simd.VtxBuffer.Data, draw_list_scalar.VtxBuffer.Data, (size_t)draw_list_simd.VtxBuffer.size_in_bytes()) != 0
+            || memcmp(draw_list_simd.IdxBuffer.Data, draw_list_scalar.IdxBuffer.Data, (size_t)draw_list_simd.IdxBuffer.size_in_bytes()) != 0)
+        {
+            fprintf(stderr, "drawlist_%s: SIMD and scalar output differ!\n", names[primitive]);
+            GBenchFailures++;
+        }
+
+        for (int scalar = 0; scalar < 2; scalar++)
+        {
+            shared_data.UseScalarKernels = (scalar != 0);
+            ImDrawList* draw_list = draw_lists[scalar];
+            const double t0 = BenchGetTime();
+            for (int batch = 0; batch < BATCHES; batch++)
+            {
+                draw_list->_ResetForNewFrame();
+                draw_list->PushClipRect(ImVec2(-8192.0f, -8192.0f), ImVec2(8192.0f, 8192.0f));
+                draw_list->PushTextureID(atlas.TexID);
+                for (int n = 0; n < OPS_PER_BATCH; n++)
+                    DrawListKernelsPrimitive(draw_list, primitive, n, shapes.Data);
+            }
+            char name[64];
+            ImFormatString(name, IM_ARRAYSIZE(name), "drawlist_%s_%s", names[primitive], scalar ? "scalar" : "simd");
+            BenchAddMicroResult(results, name, BenchGetTime() - t0, OPS_PER_BATCH * BATCHES);
+        }
+    }
+    shared_data.UseScalarKernels = false;
+}
+
+// Circles and n-gons with ImDrawListFlags_ShapeCache, compared to regular tessellation.
+// Points are the same but stroke/fringe offsets are computed on a unit shape, so positions may differ by a few ULP.
+static void DrawListShapesPrimitive(ImDrawList* draw_list, int primitive, int n)
+{
+    const ImVec2 center((float)(n % 64) * 13.0f + 20.0f, (float)(n % 37) * 17.0f + 20.25f);
+    const float radius = 8.0f + (float)(n % 4) * 4.0f; // Gauge-like sizes
+    switch (primitive)
+    {
+    case 0: draw_list->AddCircle(center, radius, IM_COL32(255, 255, 0, 255), 0, 1.0f); break;          // Textured anti-aliased lines
+    case 1: draw_list->AddCircle(center, radius, IM_COL32(255, 255, 0, 255), 0, 2.5f); break;          // Thick anti-aliased lines
+    case 2: draw_list->AddCircleFilled(center, radius, IM_COL32(0, 128, 255, 255)); break;
+    case 3: draw_list->AddNgon(center, radius, IM_COL32(255, 255, 0, 255), 12, 1.0f); break;
+    case 4: draw_list->AddNgonFilled(center, radius, IM_COL32(0, 128, 255, 255), 12); break;
+    case 5: draw_list->Flags &= ~ImDrawListFlags_AntiAliasedLines; draw_list->AddCircle(center, radius, IM_COL32(255, 255, 0, 255), 0, 2.0f); draw_list->Flags |= ImDrawListFlags_AntiAliasedLines; break;
+    }
+}
+
+static void Micro_DrawListShapeCache(ImVector<BenchMicroResult>& results)
+{
+    static const char* names[] = { "circle_aa_tex", "circle_aa_thick", "circle_filled_aa", "ngon_aa_tex", "ngon_filled_aa", "circle_no_aa" };
+    const int OPS_PER_BATCH = 500;
+    const int BATCHES = 40;
+
+    ImFontAtlas atlas;
+    atlas.AddFontDefault();
+    atlas.Build();
+    ImDrawListSharedData shared_data;
+    BenchInitDrawListSharedData(&shared_data, &atlas);
+
+    ImDrawList draw_list_regular(&shared_data);
+    ImDrawList draw_list_cached(&shared_data);
+    ImDrawList* draw_lists[2] = { &draw_list_regular, &draw_list_cached };
+    for (int primitive = 0; primitive < IM_ARRAYSIZE(names); primitive++)
+    {
+        // Compare output of both versions, then time them
+        for (int cached = 0; cached < 2; cached++)
+        {
+            ImDrawList* draw_list = draw_lists[cached];
+            shared_data.InitialFlags = cached ? (shared_data.InitialFlags | ImDrawListFlags_ShapeCache) : (shared_data.InitialFlags & ~ImDrawListFlags_ShapeCache);
+            draw_list->_ResetForNewFrame();
+            draw_list->PushClipRect(ImVec2(-8192.0f, -8192.0f), ImVec2(8192.0f, 8192.0f));
+            draw_list->PushTextureID(atlas.TexID);
+            for (int n = 0; n < OPS_PER_BATCH; n++)
+                DrawListShapesPrimitive(draw_list, primitive, n);
+        }
+        bool same = (draw_list_regular.VtxBuffer.Size == draw_list_cached.VtxBuffer.Size && draw_list_regular.IdxBuffer.Size == draw_list_cached.IdxBuffer.Size);
+        same = same && memcmp(draw_list_regular.IdxBuffer.Data, draw_list_cached.IdxBuffer.Data, (size_t)draw_list_regular.IdxBuffer.size_in_bytes()) == 0;
+        for (int n = 0; same && n < draw_list_regular.VtxBuffer.Size; n++)
+        {
+            const ImDrawVert& a = draw_list_regular.VtxBuffer[n];
+            const ImDrawVert& b = draw_list_cached.VtxBuffer[n];
+            same = ImFabs(a.pos.x - b.pos.x) < 0.001f && ImFabs(a.pos.y - b.pos.y) < 0.001f && a.uv.x == b.uv.x && a.uv.y == b.uv.y && a.col == b.col;
+        }
+        if (!same)
+        {
+            fprintf(stderr, "shapes_%s: cached and regular output differ!\n", names[primitive]);
+            GBenchFailures++;
+        }
+
+        for (int cached = 0; cached < 2; cached++)
+        {
+            ImDrawList* draw_list = draw_lists[cached];
+            shared_data.InitialFlags = cached ? (shared_data.InitialFlags | ImDrawListFlags_ShapeCache) : (shared_data.InitialFlags & ~ImDrawListFlags_ShapeCache);
+            const double t0 = BenchGetTime();
+            for (int batch = 0; batch < BATCHES; batch++)
+            {
+                draw_list->_ResetForNewFrame();
+                draw_list->PushClipRect(ImVec2(-8192.0f, -8192.0f), ImVec2(8192.0f, 8192.0f));
+                draw_list->PushTextureID(atlas.TexID);
+                for (int n = 0; n < OPS_PER_BATCH; n++)
+                    DrawListShapesPrimitive(draw_list, primitive, n);
+            }
+            char name[64];
+            ImFormatString(name, IM_ARRAYSIZE(name), "shapes_%s_%s", names[primitive], cached ? "cached" : "regular");
+            BenchAddMicroResult(results, name, BenchGetTime() - t0, OPS_PER_BATCH * BATCHES);
+        }
+    }
+    shared_data.InitialFlags &= ~ImDrawListFlags_ShapeCache;
+}
+
+// Short labels with ImDrawListFlags_TextLayoutCache, compared to regular text rendering. Output must be the same.
+static const char* GBenchTextLabels[] = { "OK", "Cancel", "Output Device", "Application sessions list", "Frame time: 16.67 ms", "Multi-line\nlabel\n", "A longer label, word-wrapped at 100 pixels", "\xC3\x9C" "n" "\xC3\xAF" "c" "\xC3\xB6" "d" "\xC3\xA9" };
+
+static void DrawListTextLabel(ImDrawList* draw_list, ImFont* font, int n)
+{
+    const int label_n = n % IM_ARRAYSIZE(GBenchTextLabels);
+    const ImVec2 pos((float)label_n * 130.0f + 0.5f, (float)(n / IM_ARRAYSIZE(GBenchTextLabels) % 64) * 15.0f);
+    const float wrap_width = (label_n == 6) ? 100.0f : 0.0f;
+    const ImVec4 fine_clip_rect(pos.x + 4.0f, pos.y + 3.0f, pos.x + 60.0f, pos.y + 10.0f);
+    draw_list->AddText(font, font->FontSize, pos, IM_COL32_WHITE, GBenchTextLabels[label_n], NULL, wrap_width, (n % 5 == 0) ? &fine_clip_rect : NULL);
+}
+
+static void Micro_TextLayoutCache(ImVector<BenchMicroResult>& results)
+{
+    const int OPS_PER_BATCH = 512;
+    const int BATCHES = 40;
+
+    ImFontAtlas atlas;
+    ImFont* font = atlas.AddFontDefault();
+    atlas.Build();
+    ImDrawListSharedData shared_data;
+    BenchInitDrawListSharedData(&shared_data, &atlas);
+
+    // Compare output of both versions, then time them
+    ImDrawList draw_list_regular(&shared_data);
+    ImDrawList draw_list_cached(&shared_data);
+    ImDrawList* draw_lists[2] = { &draw_list_regular, &draw_list_cached };
+    for (int cached = 0; cached < 2; cached++)
+        for (int pass = 0; pass < 3; pass++) // Text is cached on the second pass, and reused on the third one
+        {
+            ImDrawList* draw_list = draw_lists[cached];
+            shared_data.InitialFlags = cached ? (shared_data.InitialFlags | ImDrawListFlags_TextLayoutCache) : (shared_data.InitialFlags & ~ImDrawListFlags_TextLayoutCache);
+            shared_data.TextLayoutCache.GarbageCollect();
+            draw_list->_ResetForNewFrame();
+            draw_list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1024.0f, 768.0f));
+            draw_list->PushTextureID(atlas.TexID);
+            for (int n = 0; n < OPS_PER_BATCH; n++)
+                DrawListTextLabel(draw_list, font, n);
+        }
+    bool same = (draw_list_regular.VtxBuffer.Size == draw_list_cached.VtxBuffer.Size && draw_list_regular.IdxBuffer.Size == draw_list_cached.IdxBuffer.Size);
+    same = same && memcmp(draw_list_regular.VtxBuffer.Data, draw_list_cached.VtxBuffer.Data, (size_t)draw_list_regular.VtxBuffer.size_in_bytes()) == 0;
+    same = same && memcmp(draw_list_regular.IdxBuffer.Data, draw_list_cached.IdxBuffer.Data, (size_t)draw_list_regular.IdxBuffer.size_in_bytes()) == 0;
+    for (int n = 0; n < IM_ARRAYSIZE(GBenchTextLabels); n++)
+    {
+        ImDrawTextLayout* layout = NULL;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            shared_data.TextLayoutCache.GarbageCollect();
+            layout = shared_data.TextLayoutCache.GetLayout(font, font->FontSize, -1.0f, GBenchTextLabels[n], GBenchTextLabels[n] + strlen(GBenchTextLabels[n]));
+        }
+        const ImVec2 size_regular = font->CalcTextSizeA(font->FontSize, FLT_MAX, -1.0f, GBenchTextLabels[n]);
+        if (ImDrawTextLayoutCache::IsCacheable((int)strlen(GBenchTextLabels[n]), -1.0f))
+            same = same && layout != NULL && layout->GetTextSize().x == size_regular.x && layout->GetTextSize().y == size_regular.y;
+    }
+    if (!same)
+    {
+        fprintf(stderr, "text_layout: cached and regular output differ!\n");
+        GBenchFailures++;
+    }
+
+    for (int cached = 0; cached < 2; cached++)
+    {
+        ImDrawList* draw_list = draw_lists[cached];
+        shared_data.InitialFlags = cached ? (shared_data.InitialFlags | ImDrawListFlags_TextLayoutCache) : (shared_data.InitialFlags & ~ImDrawListFlags_TextLayoutCache);
+        double t0 = BenchGetTime();
+        for (int batch = 0; batch < BATCHES; batch++)
+        {
+            shared_data.TextLayoutCache.GarbageCollect();
+            draw_list->_ResetForNewFrame();
+            draw_list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1024.0f, 768.0f));
+            draw_list->PushTextureID(atlas.TexID);
+            for (int n = 0; n < OPS_PER_BATCH; n++)
+                DrawListTextLabel(draw_list, font, n);
+        }
+        BenchAddMicroResult(results, cached ? "text_layout_render_cached" : "text_layout_render_regular", BenchGetTime() - t0, OPS_PER_BATCH * BATCHES);
+
+        // Same as ImGui::CalcTextSize()
+        float sum = 0.0f;
+        t0 = BenchGetTime();
+        for (int batch = 0; batch < BATCHES; batch++)
+        {
+            shared_data.TextLayoutCache.GarbageCollect();
+            for (int n = 0; n < OPS_PER_BATCH; n++)
+            {
+                const char* label = GBenchTextLabels[n % IM_ARRAYSIZE(GBenchTextLabels)];
+                const char* label_end = label + strlen(label);
+                ImDrawTextLayout* layout = cached ? shared_data.TextLayoutCache.GetLayout(font, font->FontSize, -1.0f, label, label_end) : NULL;
+                sum += layout ? layout->GetTextSize().x : font->CalcTextSizeA(font->FontSize, FLT_MAX, -1.0f, label, label_end).x;
+            }
+        }
+        BenchAddMicroResult(results, cached ? "text_layout_calc_size_cached" : "text_layout_calc_size_regular", BenchGetTime() - t0, OPS_PER_BATCH * BATCHES);
+        IM_UNUSED(sum);
+    }
+    shared_data.InitialFlags &= ~ImDrawListFlags_TextLayoutCache;
+    shared_data.TextLayoutCache.Clear();
+}
+
+// Simple polygons for AddConcavePolyFilled(), from a seed.
+// - Star: points around a center with random radii, which has about half reflex vertices.
+// - Waveform: filled area under a random signal (as in a plot or an audio waveform), long and thin.
+static void BenchBuildConcavePoly(ImVector<ImVec2>& points, int shape, int points_count, unsigned int seed)
+{
+    points.resize(points_count);
+    if (shape == 0)
+    {
+        for (int n = 0; n < points_count; n++)
+        {
+            const float a = (n + BenchRandomFloat(&seed, 0.0f, 0.9f)) * 2.0f * IM_PI / points_count;
+            const float r = BenchRandomFloat(&seed, 100.0f, 400.0f);
+            points[n] = ImVec2(500.0f + ImCos(a) * r, 500.0f + ImSin(a) * r);
+        }
+    }
+    else
+    {
+        const float step = 1000.0f / (points_count - 2);
+        for (int n = 0; n < points_count - 2; n++)
+            points[n] = ImVec2(n * step, BenchRandomFloat(&seed, 0.0f, 200.0f));
+        points[points_count - 2] = ImVec2((points_count - 3) * step, 300.0f);
+        points[points_count - 1] = ImVec2(0.0f, 300.0f);
+    }
+}
+
+static bool BenchIsNearSegment(const ImVec2& a, const ImVec2& b, const ImVec2& p)
+{
+    const ImVec2 closest = ImLineClosestPoint(a, b, p);
+    return ImLengthSqr(ImVec2(closest.x - p.x, closest.y - p.y)) < 0.01f * 0.01f;
+}
+
+// Check that triangles output by non anti-aliased AddConcavePolyFilled() cover the polygon exactly once, on a grid of samples.
+// Samples too close to an edge of the polygon or of a triangle are ignored.
+static bool BenchCheckConcavePolyCoverage(const ImDrawList* draw_list, const ImVector<ImVec2>& points)
+{
+    const int SAMPLES = 48;
+    ImVec2 p_min = points[0], p_max = points[0];
+    for (const ImVec2& p : points)
+    {
+        p_min = ImMin(p_min, p);
+        p_max = ImMax(p_max, p);
+    }
+    for (int sy = 0; sy < SAMPLES; sy++)
+        for (int sx = 0; sx < SAMPLES; sx++)
+        {
+            const ImVec2 s(ImLerp(p_min.x, p_max.x, (sx + 0.5f) / SAMPLES), ImLerp(p_min.y, p_max.y, (sy + 0.5f) / SAMPLES));
+            bool inside = false;
+            bool near_edge = false;
+            for (int i0 = points.Size - 1, i1 = 0; i1 < points.Size; i0 = i1++)
+            {
+                const ImVec2& a = points[i0];
+                const ImVec2& b = points[i1];
+                if (BenchIsNearSegment(a, b, s))
+                    near_edge = true;
+                if ((a.y > s.y) != (b.y > s.y) && s.x < a.x + (b.x - a.x) * (s.y - a.y) / (b.y - a.y))
+                    inside = !inside;
+            }
+            int coverage = 0;
+            for (int n = 0; n < draw_list->IdxBuffer.Size && !near_edge; n += 3)
+            {
+                const ImVec2& a = draw_list->VtxBuffer[draw_list->IdxBuffer[n + 0]].pos;
+                const ImVec2& b = draw_list->VtxBuffer[draw_list->IdxBuffer[n + 1]].pos;
+                const ImVec2& c = draw_list->VtxBuffer[draw_list->IdxBuffer[n + 2]].pos;
+                if (BenchIsNearSegment(a, b, s) || BenchIsNearSegment(b, c, s) || BenchIsNearSegment(c, a, s))
+                    near_edge = true;
+                const float e0 = (b.x - a.x) * (s.y - a.y) - (b.y - a.y) * (s.x - a.x);
+                const float e1 = (c.x - b.x) * (s.y - b.y) - (c.y - b.y) * (s.x - b.x);
+                const float e2 = (a.x - c.x) * (s.y - c.y) - (a.y - c.y) * (s.x - c.x);
+                if ((e0 > 0.0f && e1 > 0.0f && e2 > 0.0f) || (e0 < 0.0f && e1 < 0.0f && e2 < 0.0f))
+                    coverage++;
+            }
+            if (!near_edge && coverage != (inside ? 1 : 0))
+                return false;
+        }
+    return true;
+}
+
+static void Micro_ConcavePolyFill(ImVector<BenchMicroResult>& results)
+{
+    static const char* shape_names[] = { "star", "waveform" };
+    static const int sizes[] = { 10, 100, 1000, 10000, 100000 };
+
+    ImFontAtlas atlas;
+    atlas.AddFontDefault();
+    atlas.Build();
+    ImDrawListSharedData shared_data;
+    BenchInitDrawListSharedData(&shared_data, &atlas);
+    ImDrawList draw_list(&shared_data);
+    ImVector<ImVec2> points;
+
+    // Fuzz: coverage of random polygons, on both sides of IM_DRAWLIST_CONCAVE_GRID_MIN_POINTS
+    unsigned int seed = 1;
+    for (int n = 0; n < 200; n++)
+    {
+        const int shape = n & 1;
+        const int points_count = 3 + (int)(BenchRandom(&seed) % ((n % 10 == 0) ? 2000 : 200));
+        BenchBuildConcavePoly(points, shape, points_count, BenchRandom(&seed));
+        draw_list._ResetForNewFrame();
+        draw_list.Flags &= ~ImDrawListFlags_AntiAliasedFill;
+        draw_list.PushClipRect(ImVec2(-8192.0f, -8192.0f), ImVec2(8192.0f, 8192.0f));
+        draw_list.PushTextureID(atlas.TexID);
+        draw_list.AddConcavePolyFilled(points.Data, points.Size, IM_COL32_WHITE);
+        if (draw_list.IdxBuffer.Size != (points_count - 2) * 3 || !BenchCheckConcavePolyCoverage(&draw_list, points))
+        {
+            fprintf(stderr, "concave_fill: wrong coverage for %s polygon with %d points!\n", shape_names[shape], points_count);
+            GBenchFailures++;
+            break;
+        }
+    }
+
+    // Timings, in nanoseconds per polygon point
+    for (int shape = 0; shape < IM_ARRAYSIZE(shape_names); shape++)
+        for (int size : sizes)
+        {
+            BenchBuildConcavePoly(points, shape, size, 42);
+            const int repeat_count = ImMax(1, 200000 / size);
+            const double t0 = BenchGetTime();
+            for (int n = 0; n < repeat_count; n++)
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.PushClipRect(ImVec2(-8192.0f, -8192.0f), ImVec2(8192.0f, 8192.0f));
+                draw_list.PushTextureID(atlas.TexID);
+                draw_list.AddConcavePolyFilled(points.Data, points.Size, IM_COL32_WHITE);
+            }
+            char name[64];
+            ImFormatString(name, IM_ARRAYSIZE(name), "concave_fill_%s_%d", shape_names[shape], size);
+            BenchAddMicroResult(results, name, BenchGetTime() - t0, (double)repeat_count * size);
+        }
+}
+
+// UTF-8 decoding with ImTextDecodeUtf8() and ASCII runs with ImTextSkipPrintableAscii(), compared to reference loops over ImTextCharFromUtf8().
+// Inputs are random sequences of valid and malformed UTF-8 (truncated, overlong, surrogates, stray continuation bytes, zero-terminators inside text).
+static int BenchRandomUtf8(unsigned int* state, char* buf, int buf_size)
+{
+    static const char* fragments[] =
+    {
+        "Hello", " ", "world", "\n", "\r\n", "\t", "~", "\x7F", "\xC3\xA9", "\xD0\x96", "\xE2\x82\xAC", "\xE6\x97\xA5", "\xEF\xBF\xBD", "\xF0\x9F\x98\x80", // Valid
+        "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\x80", "\xBF\xBF", "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", // Truncated, stray continuation bytes, overlong
+        "\xED\xA0\x80", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8", "\xFF", "\xFE\xFE", "\xC3" "A", "\xE2" "A" "\x82", // Surrogates, out of range, invalid continuation bytes
+    };
+    int len = 0;
+    while (true)
+    {
+        if (BenchRandom(state) % 16 == 0)
+        {
+            if (len + 1 > buf_size)
+                break;
+            buf[len++] = (BenchRandom(state) % 8 == 0) ? 0 : (char)(BenchRandom(state) & 0xFF); // Any byte including zero
+            continue;
+        }
+        const char* fragment = fragments[BenchRandom(state) % IM_ARRAYSIZE(fragments)];
+        const int fragment_len = (int)strlen(fragment);
+        if (len + fragment_len > buf_size)
+            break;
+        memcpy(buf + len, fragment, (size_t)fragment_len);
+        len += fragment_len;
+    }
+    return len;
+}
+
+// Same as ImFont::CalcTextSizeA() without word-wrapping, decoding every character with ImTextCharFromUtf8()
+static ImVec2 BenchCalcTextSizeReference(ImFont* font, float max_width, const char* text_begin, const char* text_end, const char** remaining)
+{
+    ImVec2 text_size(0.0f, 0.0f);
+    float line_width = 0.0f;
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        const char* prev_s = s;
+        unsigned int c;
+        s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c == '\n')
+        {
+            text_size.x = ImMax(text_size.x, line_width);
+            text_size.y += font->FontSize;
+            line_width = 0.0f;
+            continue;
+        }
+        if (c == '\r')
+            continue;
+        const float char_width = ((int)c < font->IndexAdvanceX.Size ? font->IndexAdvanceX.Data[c] : font->FallbackAdvanceX);
+        if (line_width + char_width >= max_width)
+        {
+            s = prev_s;
+            break;
+        }
+        line_width += char_width;
+    }
+    if (text_size.x < line_width)
+        text_size.x = line_width;
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += font->FontSize;
+    *remaining = s;
+    return text_size;
+}
+
+static void Micro_Utf8(ImVector<BenchMicroResult>& results)
+{
+    ImFontAtlas atlas;
+    ImFont* font = atlas.AddFontDefault();
+    atlas.Build();
+
+    // Compare to reference loops on random inputs, at every offset
+    const int FUZZ_INPUTS = 20000;
+    char buf[256 + 4];
+    ImWchar wbuf[256 + 1];
+    ImWchar wbuf_ref[256 + 1];
+    unsigned int state = 1;
+    int errors = 0;
+    for (int input_n = 0; input_n < FUZZ_INPUTS; input_n++)
+    {
+        const int len = BenchRandomUtf8(&state, buf, 256);
+        memset(buf + len, 0, 4);
+        const char* buf_end = buf + len;
+        for (const char* s = buf; s < buf_end; s++)
+        {
+            for (int bounded = 0; bounded < 2; bounded++)
+            {
+                unsigned int c = 0, c_ref = 0;
+                const int n = ImTextDecodeUtf8(&c, s, bounded ? buf_end : NULL);
+                const int n_ref = ImTextCharFromUtf8(&c_ref, s, bounded ? buf_end : NULL);
+                if (n != n_ref || c != c_ref)
+                    errors++;
+            }
+            const char* ascii_end_ref = s;
+            while (ascii_end_ref < buf_end && (unsigned char)*ascii_end_ref >= 0x20 && (unsigned char)*ascii_end_ref < 0x80)
+                ascii_end_ref++;
+            if (ImTextSkipPrintableAscii(s, buf_end) != ascii_end_ref)
+                errors++;
+        }
+
+        // Whole-string conversions, with a short output buffer on some inputs
+        const int wbuf_size = (input_n % 4 == 0) ? (int)(BenchRandom(&state) % 40) + 1 : IM_ARRAYSIZE(wbuf);
+        const char* remaining = NULL;
+        const char* remaining_ref = buf;
+        int count_ref = 0;
+        while (count_ref < wbuf_size - 1 && remaining_ref < buf_end && *remaining_ref)
+        {
+            unsigned int c;
+            remaining_ref += ImTextCharFromUtf8(&c, remaining_ref, buf_end);
+            wbuf_ref[count_ref++] = (ImWchar)c;
+        }
+        const int count = ImTextStrFromUtf8(wbuf, wbuf_size, buf, buf_end, &remaining);
+        if (count != count_ref || remaining != remaining_ref || wbuf[count] != 0 || memcmp(wbuf, wbuf_ref, (size_t)count * sizeof(ImWchar)) != 0)
+            errors++;
+        int char_count_ref = 0;
+        for (const char* s = buf; s < buf_end && *s; char_count_ref++)
+        {
+            unsigned int c;
+            s += ImTextCharFromUtf8(&c, s, buf_end);
+        }
+        if (ImTextCountCharsFromUtf8(buf, buf_end) != char_count_ref)
+            errors++;
+
+        // Text size, including a max width which stops in the middle of the text
+        const float max_width = (input_n % 2) ? FLT_MAX : (float)(BenchRandom(&state) % 400);
+        const char* remaining_size_ref = NULL;
+        const ImVec2 size = font->CalcTextSizeA(font->FontSize, max_width, -1.0f, buf, buf_end, &remaining);
+        const ImVec2 size_ref = BenchCalcTextSizeReference(font, max_width, buf, buf_end, &remaining_size_ref);
+        if (size.x != size_ref.x || size.y != size_ref.y || remaining != remaining_size_ref)
+            errors++;
+    }
+    if (errors > 0)
+    {
+        fprintf(stderr, "utf8: %d mismatches with reference decoding!\n", errors);
+        GBenchFailures++;
+    }
+
+    // Throughput on ASCII and mixed text, in nanoseconds per byte
+    ImGuiTextBuffer text_ascii, text_mixed;
+    for (int n = 0; n < 512; n++)
+    {
+        const char* line_ascii = "The quick brown fox jumps over the lazy dog. 0123456789\n";
+        const char* line_mixed = "Gr\xC3\xBC\xC3\x9F" "e, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, \xE3\x81\x93\xE3\x82\x93\xE3\x81\xAB\xE3\x81\xA1\xE3\x81\xAF, plain ASCII words in between.\n";
+        text_ascii.append(line_ascii);
+        text_mixed.append(line_mixed);
+    }
+    ImVector<ImWchar> wtext;
+    wtext.resize(text_ascii.size() + 1);
+    const int ITERATIONS = 200;
+    for (int mixed = 0; mixed < 2; mixed++)
+    {
+        const ImGuiTextBuffer& text = mixed ? text_mixed : text_ascii;
+        const char* text_begin = text.begin();
+        const char* text_end = text.end();
+        float sum = 0.0f;
+        double t0 = BenchGetTime();
+        for (int n = 0; n < ITERATIONS; n++)
+            sum += font->CalcTextSizeA(font->FontSize, FLT_MAX, -1.0f, text_begin, text_end).x;
+        BenchAddMicroResult(results, mixed ? "utf8_calc_size_mixed" : "utf8_calc_size_ascii", BenchGetTime() - t0, (double)ITERATIONS * text.size());
+        t0 = BenchGetTime();
+        for (int n = 0; n < ITERATIONS; n++)
+            sum += font->CalcTextSizeA(font->FontSize, FLT_MAX, 300.0f, text_begin, text_end).y;
+        BenchAddMicroResult(results, mixed ? "utf8_calc_size_wrapped_mixed" : "utf8_calc_size_wrapped_ascii", BenchGetTime() - t0, (double)ITERATIONS * text.size());
+        t0 = BenchGetTime();
+        for (int n = 0; n < ITERATIONS; n++)
+            sum += (float)ImTextStrFromUtf8(wtext.Data, wtext.Size, text_begin, text_end);
+        BenchAddMicroResult(results, mixed ? "utf8_str_from_utf8_mixed" : "utf8_str_from_utf8_ascii", BenchGetTime() - t0, (double)ITERATIONS * text.size());
+        if (sum == 0.0f)
+            printf("\n"); // Keep the result alive
+    }
+}
+
+// Text recorded with ImDrawListFlags_DeferText then expanded, compared to regular text rendering. Once unused quads (zero-area, transparent)
+// are removed, vertices must be the same. Inputs are lines of random valid and malformed UTF-8, partly clipped, some of them split in several runs.
+static void Micro_DeferText(ImVector<BenchMicroResult>& results)
+{
+    ImFontAtlas atlas;
+    ImFont* font = atlas.AddFontDefault();
+    atlas.Build();
+    ImDrawListSharedData shared_data;
+    BenchInitDrawListSharedData(&shared_data, &atlas);
+    ImDrawList draw_list_regular(&shared_data);
+    ImDrawList draw_list_deferred(&shared_data);
+    ImDrawList* draw_lists[2] = { &draw_list_regular, &draw_list_deferred };
+    const ImVec4 clip_rect(0.0f, 0.0f, 400.0f, 300.0f);
+
+    const int FUZZ_INPUTS = 4000;
+    char buf[4096];
+    unsigned int state = 1;
+    int errors = 0;
+    ImVector<ImDrawVert> used_vtx;
+    for (int input_n = 0; input_n < FUZZ_INPUTS; input_n++)
+    {
+        const int buf_size = (input_n % 8 == 0) ? IM_ARRAYSIZE(buf) : 256;
+        int len = 0;
+        while (len + 81 <= buf_size)
+        {
+            len += BenchRandomUtf8(&state, buf + len, (int)(BenchRandom(&state) % 80));
+            buf[len++] = '\n';
+        }
+        const ImVec2 pos(BenchRandomFloat(&state, -50.0f, 300.0f), BenchRandomFloat(&state, -20.0f, 100.0f));
+        for (int deferred = 0; deferred < 2; deferred++)
+        {
+            shared_data.InitialFlags = deferred ? (shared_data.InitialFlags | ImDrawListFlags_DeferText) : (shared_data.InitialFlags & ~ImDrawListFlags_DeferText);
+            ImDrawList* draw_list = draw_lists[deferred];
+            draw_list->_ResetForNewFrame();
+            draw_list->PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+            draw_list->PushTextureID(atlas.TexID);
+            draw_list->AddText(font, font->FontSize, pos, IM_COL32_WHITE, buf, buf + len, 0.0f, (input_n % 2) ? &clip_rect : NULL);
+        }
+        draw_list_deferred._FlushTextRuns();
+
+        used_vtx.resize(0);
+        const ImVector<ImDrawVert>& vtx = draw_list_deferred.VtxBuffer;
+        for (int n = 0; n + 4 <= vtx.Size; n += 4)
+            if (vtx[n].col != IM_COL32_BLACK_TRANS)
+                for (int i = 0; i < 4; i++)
+                    used_vtx.push_back(vtx[n + i]);
+        if (used_vtx.Size != draw_list_regular.VtxBuffer.Size || memcmp(used_vtx.Data, draw_list_regular.VtxBuffer.Data, (size_t)used_vtx.size_in_bytes()) != 0)
+            errors++;
+    }
+    shared_data.InitialFlags &= ~ImDrawListFlags_DeferText;
+    if (errors > 0)
+    {
+        fprintf(stderr, "defer_text: %d inputs differ from regular text rendering!\n", errors);
+        GBenchFailures++;
+    }
+
+    // Mixed text: regular rendering, recording, then expanding on the main thread, in nanoseconds per byte
+    ImGuiTextBuffer text;
+    for (int n = 0; n < 64; n++)
+        text.append("Gr\xC3\xBC\xC3\x9F" "e, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82, \xE3\x81\x93\xE3\x82\x93\xE3\x81\xAB\xE3\x81\xA1\xE3\x81\xAF, plain ASCII words in between.\n");
+    const int ITERATIONS = 200;
+    double seconds[3] = {};
+    for (int n = 0; n < ITERATIONS; n++)
+        for (int deferred = 0; deferred < 2; deferred++)
+        {
+            shared_data.InitialFlags = deferred ? (shared_data.InitialFlags | ImDrawListFlags_DeferText) : (shared_data.InitialFlags & ~ImDrawListFlags_DeferText);
+            ImDrawList* draw_list = draw_lists[deferred];
+            draw_list->_ResetForNewFrame();
+            draw_list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1920.0f, 1080.0f));
+            draw_list->PushTextureID(atlas.TexID);
+            double t0 = BenchGetTime();
+            draw_list->AddText(font, font->FontSize, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, text.begin(), text.end());
+            double t1 = BenchGetTime();
+            seconds[deferred] += t1 - t0;
+            if (deferred)
+            {
+                draw_list->_FlushTextRuns();
+                seconds[2] += BenchGetTime() - t1;
+            }
+        }
+    shared_data.InitialFlags &= ~ImDrawListFlags_DeferText;
+    BenchAddMicroResult(results, "defer_text_regular", seconds[0], (double)ITERATIONS * text.size());
+    BenchAddMicroResult(results, "defer_text_record", seconds[1], (double)ITERATIONS * text.size());
+    BenchAddMicroResult(results, "defer_text_expand", seconds[2], (double)ITERATIONS * text.size());
+}
+
+struct BenchMicro
+{
+    const char* Name;
+    void        (*Run)(ImVector<BenchMicroResult>& results);
+};
+
+static const BenchMicro GBenchMicros[] =
+{
+    { "hash",        Micro_HashStr },
+    { "storage",     Micro_Storage },
+    { "selection",   Micro_Selection },
+    { "drawlist",    Micro_DrawListKernels },
+    { "shapes",      Micro_DrawListShapeCache },
+    { "text_layout", Micro_TextLayoutCache },
+    { "concave",     Micro_ConcavePolyFill },
+    { "utf8",        Micro_Utf8 },
+    { "defer_text",  Micro_DeferText },
+};
+
+//-----------------------------------------------------------------------------
+// [SECTION] Runner
+//-----------------------------------------------------------------------------
+
+struct BenchWorkloadResult
+{
+    const char*     Name;
+    int             Frames;
+    BenchSeries     NewFrameMs;
+    BenchSeries     BuildMs;        // Workload submission, between NewFrame() and EndFrame()
+    BenchSeries     EndFrameMs;
+    BenchSeries     RenderMs;
+    BenchSeries     TotalMs;
+    BenchSeries     Allocs;         // Per frame
+    BenchSeries     AllocBytes;
+    BenchSeries     Vertices;
+    BenchSeries     Indices;
+    BenchSeries     RectInstances;  // With --rect-instances
+    BenchSeries     UploadBytes;    // Vertices, indices and rectangle instances, in the formats the renderer would upload
+    BenchSeries     VtxCompact;     // With --compact-vtx: 1.0f for frames using ImDrawVertCompact
+    BenchSeries     DrawLists;
+    BenchSeries     DrawCmds;
+    BenchSeries     DamageRects;    // With --damage
+    BenchSeries     DamageArea;     // Fraction of the display
+    int             VerifyFrames;   // With --verify-damage
+    int             VerifyMismatchFrames;
+    ImS64           VerifyMismatchPixels;
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    BenchSeries     TagAllocs[ImGuiAllocTag_COUNT];     // Per frame
+    ImS64           TagLiveBytes[ImGuiAllocTag_COUNT];  // At the end of the run
+    ImS64           TagPeakBytes[ImGuiAllocTag_COUNT];
+#endif
+};
+
+struct BenchOptions
+{
+    int             Frames = 300;
+    int             Warmup = 30;
+    bool            Profile = false;
+    const char*     TracePrefix = NULL;
+    bool            Damage = false;
+    bool            VerifyDamage = false;
+    bool            RectInstances = false;
+    bool            CompactVtx = false;
+    int             DeferTextThreads = 0;   // 0: disabled
+    bool            ShapeCache = false;
+    bool            TextLayoutCache = false;
+};
+
+// Fork-join worker pool for platform_io.Platform_ParallelForFn (--defer-text THREADS)
+// The calling thread takes part in the work, and waits for every worker to be done with a batch before returning, so no worker can see the next one early.
+struct BenchThreadPool
+{
+    std::thread             Workers[63];
+    int                     WorkersCount = 0;
+    std::mutex              Mutex;
+    std::condition_variable WakeCond;
+    std::condition_variable DoneCond;
+    int                     Generation = 0;     // Incremented for each batch
+    int                     WorkersDone = 0;
+    bool                    Quit = false;
+    void                    (*JobFunc)(void* job_data, int job_index) = NULL;
+    void*                   JobData = NULL;
+    int                     JobsCount = 0;
+    std::atomic<int>        JobNext;
+
+    void Start(int threads_count)
+    {
+        WorkersCount = ImClamp(threads_count - 1, 0, IM_ARRAYSIZE(Workers));
+        for (int n = 0; n < WorkersCount; n++)
+            Workers[n] = std::thread([this]() { WorkerLoop(); });
+    }
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Quit = true;
+        }
+        WakeCond.notify_all();
+        for (int n = 0; n < WorkersCount; n++)
+            Workers[n].join();
+        WorkersCount = 0;
+    }
+    void RunJobs()
+    {
+        for (int job_n = JobNext.fetch_add(1); job_n < JobsCount; job_n = JobNext.fetch_add(1))
+            JobFunc(JobData, job_n);
+    }
+    void WorkerLoop()
+    {
+        int generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                WakeCond.wait(lock, [&]() { return Quit || Generation != generation; });
+                if (Quit)
+                    return;
+                generation = Generation;
+            }
+            RunJobs();
+            std::lock_guard<std::mutex> lock(Mutex);
+            if (++WorkersDone == WorkersCount)
+                DoneCond.notify_one();
+        }
+    }
+    void ParallelFor(int jobs_count, void (*job_func)(void* job_data, int job_index), void* job_data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            JobFunc = job_func;
+            JobData = job_data;
+            JobsCount = jobs_count;
+            JobNext = 0;
+            WorkersDone = 0;
+            Generation++;
+        }
+        WakeCond.notify_all();
+        RunJobs();
+        std::unique_lock<std::mutex> lock(Mutex);
+        DoneCond.wait(lock, [&]() { return WorkersDone == WorkersCount; });
+    }
+};
+
+static void BenchParallelFor(ImGuiContext* ctx, int jobs_count, void (*job_func)(void* job_data, int job_index), void* job_data)
+{
+    BenchThreadPool* pool = (BenchThreadPool*)ctx->PlatformIO.Platform_ParallelForUserData;
+    pool->ParallelFor(jobs_count, job_func, job_data);
+}
+
+static double BenchCalcUploadBytes(const ImDrawData* draw_data)
+{
+    double bytes = 0.0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        bytes += draw_data->VtxCompact ? draw_list->VtxBufferCompact.size_in_bytes() : draw_list->VtxBuffer.size_in_bytes();
+        bytes += (draw_list->IdxBuffer32.Size > 0) ? draw_list->IdxBuffer32.size_in_bytes() : draw_list->IdxBuffer.size_in_bytes();
+        bytes += draw_list->RectInstBuffer.size_in_bytes();
+    }
+    return bytes;
+}
+
+// Decode ImDrawVertCompact/32-bit indices and compare to the regular buffers, return number of mismatching elements
+static int BenchCheckAlternateBuffers(const ImDrawData* draw_data)
+{
+    int errors = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        if (draw_data->VtxCompact)
+        {
+            if (draw_list->VtxBufferCompact.Size != draw_list->VtxBuffer.Size)
+                return errors + 1;
+            const float pos_tolerance = 0.5f / IM_DRAWVERT_COMPACT_POS_SCALE + 0.001f;
+            const float uv_tolerance = 0.5f / 65535.0f + 1e-6f;
+            for (int n = 0; n < draw_list->VtxBuffer.Size; n++)
+            {
+                const ImDrawVert& v = draw_list->VtxBuffer[n];
+                const ImDrawVertCompact& c = draw_list->VtxBufferCompact[n];
+                const float dx = draw_data->DisplayPos.x + c.pos[0] / IM_DRAWVERT_COMPACT_POS_SCALE - v.pos.x;
+                const float dy = draw_data->DisplayPos.y + c.pos[1] / IM_DRAWVERT_COMPACT_POS_SCALE - v.pos.y;
+                const float du = c.uv[0] / 65535.0f - v.uv.x;
+                const float dv = c.uv[1] / 65535.0f - v.uv.y;
+                if (ImFabs(dx) > pos_tolerance || ImFabs(dy) > pos_tolerance || ImFabs(du) > uv_tolerance || ImFabs(dv) > uv_tolerance || c.col != v.col)
+                    errors++;
+            }
+        }
+        if (draw_list->IdxBuffer32.Size > 0)
+            for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+                for (unsigned int n = cmd.IdxOffset; n < cmd.IdxOffset + cmd.ElemCount; n++)
+                    if (draw_list->IdxBuffer32[n] != cmd.VtxOffset + draw_list->IdxBuffer[n])
+                        errors++;
+    }
+    return errors;
+}
+
+static void BenchRunWorkload(const BenchWorkload& workload, ImFontAtlas* atlas, const BenchOptions& options, BenchWorkloadResult* result)
+{
+    const int frames = options.Frames;
+    const int warmup = options.Warmup;
+    ImGuiContext* ctx = ImGui::CreateContext(atlas);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.LogFilename = NULL;
+    io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable | ImGuiConfigFlags_NavEnableKeyboard;
+    if (options.Damage)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasDamageRects;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset; // Like most renderers. Only used by lists with more than 64K vertices.
+    if (options.RectInstances)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasRectInstances;
+    if (options.CompactVtx)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxCompact | ImGuiBackendFlags_RendererHasIdx32;
+    BenchThreadPool* thread_pool = NULL;
+    if (options.DeferTextThreads > 0)
+        io.ConfigDrawListsDeferText = true;
+    io.ConfigDrawListsShapeCache = options.ShapeCache;
+    io.ConfigDrawListsTextLayoutCache = options.TextLayoutCache;
+    if (options.DeferTextThreads > 1)
+    {
+        thread_pool = IM_NEW(BenchThreadPool)();
+        thread_pool->Start(options.DeferTextThreads);
+        ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+        platform_io.Platform_ParallelForFn = BenchParallelFor;
+        platform_io.Platform_ParallelForUserData = thread_pool;
+    }
+    BenchDamageVerifier* verifier = NULL;
+    if (options.VerifyDamage)
+    {
+        verifier = IM_NEW(BenchDamageVerifier)();
+        verifier->Init(atlas, (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x), (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y));
+    }
+
+    result->Name = workload.Name;
+    result->Frames = frames;
+    for (int frame = 0; frame < warmup + frames; frame++)
+    {
+#ifdef IMGUI_ENABLE_PROFILER
+        ctx->Profiler.Enabled = (options.Profile && frame >= warmup);
+        ctx->Profiler.WindowZones = (options.TracePrefix != NULL);
+#endif
+        BenchFeedInput(io, frame);
+        const BenchAllocStats allocs_before = GBenchAllocStats;
+        const double t0 = BenchGetTime();
+        ImGui::NewFrame();
+        const double t1 = BenchGetTime();
+        workload.Frame(frame);
+        const double t2 = BenchGetTime();
+        ImGui::EndFrame();
+        const double t3 = BenchGetTime();
+        ImGui::Render();
+        const double t4 = BenchGetTime();
+        if (verifier != NULL)
+            verifier->Verify(ImGui::GetDrawData());
+        if (frame < warmup)
+            continue;
+
+        // Snapshot allocation counters before storing samples: our own ImVector<> also allocate through Dear ImGui.
+        const BenchAllocStats allocs_after = GBenchAllocStats;
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+        int tag_allocs[ImGuiAllocTag_COUNT];
+        for (int tag_n = 0; tag_n < ImGuiAllocTag_COUNT; tag_n++)
+            tag_allocs[tag_n] = ImGui::DebugGetAllocTagInfo((ImGuiAllocTag)tag_n)->FrameAllocCount;
+#endif
+
+        const ImDrawData* draw_data = ImGui::GetDrawData();
+        int draw_cmds = 0;
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+            draw_cmds += draw_list->CmdBuffer.Size;
+        result->NewFrameMs.Add((t1 - t0) * 1000.0);
+        result->BuildMs.Add((t2 - t1) * 1000.0);
+        result->EndFrameMs.Add((t3 - t2) * 1000.0);
+        result->RenderMs.Add((t4 - t3) * 1000.0);
+        result->TotalMs.Add((t4 - t0) * 1000.0);
+        result->Allocs.Add((double)(allocs_after.Count - allocs_before.Count));
+        result->AllocBytes.Add((double)(allocs_after.Bytes - allocs_before.Bytes));
+        result->Vertices.Add(draw_data->TotalVtxCount);
+        result->Indices.Add(draw_data->TotalIdxCount);
+        result->RectInstances.Add(draw_data->TotalRectInstCount);
+        result->UploadBytes.Add(BenchCalcUploadBytes(draw_data));
+        if (options.CompactVtx)
+        {
+            result->VtxCompact.Add(draw_data->VtxCompact ? 1.0 : 0.0);
+            if (int errors = BenchCheckAlternateBuffers(draw_data))
+            {
+                fprintf(stderr, "%s: frame %d: %d vertices or indices differ after conversion to alternate formats!\n", workload.Name, frame, errors);
+                GBenchFailures++;
+            }
+        }
+        result->DrawLists.Add(draw_data->CmdListsCount);
+        result->DrawCmds.Add(draw_cmds);
+        if (options.Damage)
+        {
+            double damage_area = 0.0;
+            for (const ImVec4& r : draw_data->DamageRects)
+                damage_area += (r.z - r.x) * (r.w - r.y);
+            result->DamageRects.Add(draw_data->DamageRects.Size);
+            result->DamageArea.Add(draw_data->DamageRectsValid ? damage_area / (draw_data->DisplaySize.x * draw_data->DisplaySize.y) : 1.0);
+        }
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+        for (int tag_n = 0; tag_n < ImGuiAllocTag_COUNT; tag_n++)
+            result->TagAllocs[tag_n].Add(tag_allocs[tag_n]);
+#endif
+    }
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    for (int tag_n = 0; tag_n < ImGuiAllocTag_COUNT; tag_n++)
+    {
+        result->TagLiveBytes[tag_n] = ImGui::DebugGetAllocTagInfo((ImGuiAllocTag)tag_n)->LiveBytes;
+        result->TagPeakBytes[tag_n] = ImGui::DebugGetAllocTagInfo((ImGuiAllocTag)tag_n)->PeakBytes;
+    }
+#endif
+    if (verifier != NULL)
+    {
+        result->VerifyFrames = verifier->Frames;
+        result->VerifyMismatchFrames = verifier->MismatchFrames;
+        result->VerifyMismatchPixels = verifier->MismatchPixels;
+        IM_DELETE(verifier);
+    }
+    if (thread_pool != NULL)
+    {
+        thread_pool->Stop();
+        IM_DELETE(thread_pool);
+    }
+#ifdef IMGUI_ENABLE_PROFILER
+    if (options.TracePrefix != NULL)
+    {
+        char filename[256];
+        ImFormatString(filename, IM_ARRAYSIZE(filename), "%s%s.json", options.TracePrefix, workload.Name);
+        if (!ImGui::ProfilerSaveChromeTrace(filename))
+            fprintf(stderr, "Could not write '%s'.\n", filename);
+    }
+#endif
+    ImGui::DestroyContext(ctx);
+}
+
+static bool BenchIsSelected(const ImVector<const char*>& filters, const char* name)
+{
+    if (filters.Size == 0)
+        return true;
+    for (const char* filter : filters)
+        if (strcmp(filter, name) == 0)
+            return true;
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    const char* out_filename = NULL;
+    ImVector<const char*> filters;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--frames") == 0 && n + 1 < argc)
+            options.Frames = ImMax(atoi(argv[++n]), 1);
+        else if (strcmp(argv[n], "--warmup") == 0 && n + 1 < argc)
+            options.Warmup = ImMax(atoi(argv[++n]), 0);
+        else if (strcmp(argv[n], "--workload") == 0 && n + 1 < argc)
+            filters.push_back(argv[++n]);
+        else if (strcmp(argv[n], "--out") == 0 && n + 1 < argc)
+            out_filename = argv[++n];
+        else if (strcmp(argv[n], "--profile") == 0)
+            options.Profile = true;
+        else if (strcmp(argv[n], "--trace") == 0 && n + 1 < argc)
+        {
+            options.Profile = true;
+            options.TracePrefix = argv[++n];
+        }
+        else if (strcmp(argv[n], "--damage") == 0)
+            options.Damage = true;
+        else if (strcmp(argv[n], "--verify-damage") == 0)
+            options.Damage = options.VerifyDamage = true;
+        else if (strcmp(argv[n], "--rect-instances") == 0)
+            options.RectInstances = true;
+        else if (strcmp(argv[n], "--compact-vtx") == 0)
+            options.CompactVtx = true;
+        else if (strcmp(argv[n], "--defer-text") == 0 && n + 1 < argc)
+            options.DeferTextThreads = ImMax(atoi(argv[++n]), 1);
+        else if (strcmp(argv[n], "--shape-cache") == 0)
+            options.ShapeCache = true;
+        else if (strcmp(argv[n], "--text-layout-cache") == 0)
+            options.TextLayoutCache = true;
+        else if (strcmp(argv[n], "--list") == 0)
+        {
+            for (const BenchWorkload& workload : GBenchWorkloads)
+                printf("%s\n", workload.Name);
+            for (const BenchMicro& micro : GBenchMicros)
+                printf("%s\n", micro.Name);
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--workload NAME]... [--out FILE] [--profile] [--trace PREFIX] [--damage] [--verify-damage] [--rect-instances] [--compact-vtx] [--defer-text THREADS] [--shape-cache] [--text-layout-cache] [--list]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(BenchMallocWrapper, BenchFreeWrapper, NULL);
+
+    // Font atlas is built once and shared by all contexts, so it isn't part of any measurement
+    ImFontAtlas* atlas = IM_NEW(ImFontAtlas)();
+    atlas->AddFontDefault();
+    atlas->Build();
+
+    ImVector<BenchWorkloadResult*> workload_results;
+    for (const BenchWorkload& workload : GBenchWorkloads)
+        if (BenchIsSelected(filters, workload.Name))
+        {
+            BenchWorkloadResult* result = IM_NEW(BenchWorkloadResult)();
+            BenchRunWorkload(workload, atlas, options, result);
+            workload_results.push_back(result);
+            fprintf(stderr, "%-24s total %8.3f ms/frame (p95 %8.3f), %6.2f allocs/frame, %8.0f vertices\n", workload.Name, result->TotalMs.Mean(), result->TotalMs.Percentile(0.95f), result->Allocs.Mean(), result->Vertices.Mean());
+            fprintf(stderr, "%-24s upload %8.1f KB/frame%s\n", "", result->UploadBytes.Mean() / 1024.0, options.CompactVtx ? (result->VtxCompact.Mean() == 1.0 ? " (compact vertices)" : " (compact vertices: some frames didn't fit)") : "");
+            if (options.RectInstances)
+                fprintf(stderr, "%-24s %8.0f rect instances/frame, %8.0f indices\n", "", result->RectInstances.Mean(), result->Indices.Mean());
+            if (options.Damage)
+                fprintf(stderr, "%-24s damage %7.2f%% of display (p95 %7.2f%%), %5.2f rects/frame\n", "", result->DamageArea.Mean() * 100.0, result->DamageArea.Percentile(0.95f) * 100.0, result->DamageRects.Mean());
+            if (options.VerifyDamage)
+                fprintf(stderr, "%-24s verify %d/%d frames mismatched, %lld pixels\n", "", result->VerifyMismatchFrames, result->VerifyFrames, (long long)result->VerifyMismatchPixels);
+        }
+
+    ImVector<BenchMicroResult> micro_results;
+    for (const BenchMicro& micro : GBenchMicros)
+        if (BenchIsSelected(filters, micro.Name))
+            micro.Run(micro_results);
+    for (const BenchMicroResult& result : micro_results)
+        fprintf(stderr, "%-36s %12.2f ns/op\n", result.Name, result.NsPerOp);
+
+    FILE* f = out_filename ? fopen(out_filename, "wb") : stdout;
+    if (f == NULL)
+    {
+        fprintf(stderr, "Could not open '%s' for writing.\n", out_filename);
+        return 1;
+    }
+    fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"frames\": %d,\n  \"warmup\": %d,\n  \"profile\": %s,\n  \"damage\": %s,\n  \"rect_instances\": %s,\n  \"compact_vtx\": %s,\n  \"defer_text_threads\": %d,\n  \"shape_cache\": %s,\n  \"text_layout_cache\": %s,\n  \"workloads\": [\n", IMGUI_VERSION, options.Frames, options.Warmup, options.Profile ? "true" : "false", options.Damage ? "true" : "false", options.RectInstances ? "true" : "false", options.CompactVtx ? "true" : "false", options.DeferTextThreads, options.ShapeCache ? "true" : "false", options.TextLayoutCache ? "true" : "false");
+    for (int n = 0; n < workload_results.Size; n++)
+    {
+        const BenchWorkloadResult* result = workload_results[n];
+        fprintf(f, "    {\n      \"name\": \"%s\",\n", result->Name);
+        BenchWriteSeries(f, "new_frame_ms", result->NewFrameMs);
+        BenchWriteSeries(f, "build_ms", result->BuildMs);
+        BenchWriteSeries(f, "end_frame_ms", result->EndFrameMs);
+        BenchWriteSeries(f, "render_ms", result->RenderMs);
+        BenchWriteSeries(f, "total_ms", result->TotalMs);
+        BenchWriteSeries(f, "allocs", result->Allocs);
+        BenchWriteSeries(f, "alloc_bytes", result->AllocBytes);
+        BenchWriteSeries(f, "vertices", result->Vertices);
+        BenchWriteSeries(f, "indices", result->Indices);
+        if (options.RectInstances)
+            BenchWriteSeries(f, "rect_instances", result->RectInstances);
+        BenchWriteSeries(f, "upload_bytes", result->UploadBytes);
+        if (options.CompactVtx)
+            BenchWriteSeries(f, "vtx_compact", result->VtxCompact);
+        if (options.Damage)
+        {
+            BenchWriteSeries(f, "damage_rects", result->DamageRects);
+            BenchWriteSeries(f, "damage_area", result->DamageArea);
+        }
+        if (options.VerifyDamage)
+            fprintf(f, "      \"damage_verify\": { \"frames\": %d, \"mismatch_frames\": %d, \"mismatch_pixels\": %lld },\n", result->VerifyFrames, result->VerifyMismatchFrames, (long long)result->VerifyMismatchPixels);
+        BenchWriteSeries(f, "draw_lists", result->DrawLists);
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+        BenchWriteSeries(f, "draw_cmds", result->DrawCmds);
+        fprintf(f, "      \"alloc_tags\": {\n");
+        for (int tag_n = 0; tag_n < ImGuiAllocTag_COUNT; tag_n++)
+            fprintf(f, "        \"%s\": { \"allocs_per_frame\": %.3f, \"live_bytes\": %lld, \"peak_bytes\": %lld }%s\n", ImGui::DebugGetAllocTagName((ImGuiAllocTag)tag_n),
+                result->TagAllocs[tag_n].Mean(), (long long)result->TagLiveBytes[tag_n], (long long)result->TagPeakBytes[tag_n], tag_n + 1 < ImGuiAllocTag_COUNT ? "," : "");
+        fprintf(f, "      }\n");
+#else
+        BenchWriteSeries(f, "draw_cmds", result->DrawCmds, true);
+#endif
+        fprintf(f, "    }%s\n", n + 1 < workload_results.Size ? "," : "");
+    }
+    fprintf(f, "  ],\n  \"micro\": [\n");
+    for (int n = 0; n < micro_results.Size; n++)
+        fprintf(f, "    { \"name\": \"%s\", \"ns_per_op\": %.3f }%s\n", micro_results[n].Name, micro_results[n].NsPerOp, n + 1 < micro_results.Size ? "," : "");
+    fprintf(f, "  ]\n}\n");
+    if (f != stdout)
+        fclose(f);
+
+    for (BenchWorkloadResult* result : workload_results)
+        IM_DELETE(result);
+    IM_DELETE(atlas);
+    return (GBenchFailures > 0) ? 1 : 0;
+}
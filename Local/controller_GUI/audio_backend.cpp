@@ -0,0 +1,84 @@
+#include "audio_backend.hpp"
+#include "audio_meter.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+//--audio_backend Implimentation-----------------------------------------------
+float audio_backend::get_volume(size_t index) const {
+    if (index >= device_list.size()) {
+        return 0.0f;
+    }
+    return channels[index].volume.load(std::memory_order_relaxed);
+}
+
+bool audio_backend::get_mute(size_t index) const {
+    if (index >= device_list.size()) {
+        return false;
+    }
+    return channels[index].muted.load(std::memory_order_relaxed);
+}
+
+void audio_backend::apply_batch(const std::vector<audio_write>& writes) {
+    for (const audio_write& w : writes) {
+        if (w.is_session) {
+            continue;
+        }
+        set_volume(w.device_index, w.volume);
+        set_mute(w.device_index, w.muted);
+    }
+}
+
+std::unique_ptr<meter_source> audio_backend::create_meter_source() {
+    return nullptr;
+}
+
+void audio_backend::set_change_callback(change_callback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex);
+    on_change = std::move(callback);
+}
+
+void audio_backend::init_devices(std::vector<audio_device_info> devices) {
+    device_list = std::move(devices);
+    channels.reset(new channel_state[device_list.size()]);
+}
+
+void audio_backend::store(size_t index, float volume, bool muted) {
+    if (index >= device_list.size()) {
+        return;
+    }
+    channels[index].volume.store(volume, std::memory_order_relaxed);
+    channels[index].muted.store(muted, std::memory_order_relaxed);
+}
+
+void audio_backend::publish(size_t index, float volume, bool muted) {
+    if (index >= device_list.size()) {
+        return;
+    }
+    store(index, volume, muted);
+
+    std::lock_guard<std::mutex> lock(callback_mutex);
+    if (on_change) {
+        on_change(audio_change_event{ index, volume, muted });
+    }
+}
+
+//--Backend Selection-----------------------------------------------------------
+std::unique_ptr<audio_backend> create_audio_backend() {
+    const char* forced = std::getenv("CONTROLLER_AUDIO_BACKEND");
+    if (forced != nullptr && std::strcmp(forced, "sim") == 0) {
+        return create_simulated_audio_backend();
+    }
+
+#ifdef _WIN32
+    std::unique_ptr<audio_backend> backend = create_wasapi_audio_backend();
+#else
+    std::unique_ptr<audio_backend> backend = create_pulse_audio_backend();
+#endif
+    if (backend) {
+        return backend;
+    }
+
+    std::cerr << "No sound server available, using the simulated mixer." << std::endl;
+    return create_simulated_audio_backend();
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Platform independent view of the render endpoints the controller drives.
+//
+// Every backend enumerates its endpoints once and keeps the native handles
+// (IAudioEndpointVolume on Windows, sink indices on PulseAudio/PipeWire) for
+// the lifetime of the backend. Volume and mute state are cached here and kept
+// up to date by the backend's own change notifications, so get_volume() and
+// get_mute() never talk to the sound server and are cheap enough to call
+// every frame.
+
+class meter_source;
+
+struct audio_device_info {
+    std::string id;      // Stable backend id (endpoint id string, sink name, ...)
+    std::string name;    // Human readable name shown in the UI
+};
+
+// Per application stream (WASAPI audio session, PulseAudio sink input).
+// Sessions come and go with applications, so they are enumerated on demand
+// rather than cached like endpoints.
+struct audio_session_state {
+    std::string id;      // Stable across runs of the same application
+    std::string name;
+    size_t device_index; // Endpoint the session plays on
+    float volume;
+    bool muted;
+};
+
+// One entry of a batched write. Endpoints are addressed by index, sessions
+// by id since their backend handle may not be cached.
+struct audio_write {
+    bool is_session;
+    size_t device_index;
+    std::string session_id;
+    float volume;
+    bool muted;
+};
+
+struct audio_change_event {
+    size_t index;        // Index into enumerate_devices()
+    float volume;        // 0.0f .. 1.0f
+    bool muted;
+};
+
+class audio_backend {
+public:
+    using change_callback = std::function<void(const audio_change_event&)>;
+
+    virtual ~audio_backend() = default;
+
+    virtual const char* name() const = 0;
+
+    // Endpoints discovered when the backend was created.
+    const std::vector<audio_device_info>& devices() const { return device_list; }
+    size_t device_count() const { return device_list.size(); }
+
+    // Cached state, updated asynchronously by the backend.
+    float get_volume(size_t index) const;
+    bool get_mute(size_t index) const;
+
+    // Writes go straight to the cached native handle. The cache is updated
+    // optimistically and corrected by the change notification that follows.
+    virtual bool set_volume(size_t index, float volume) = 0;
+    virtual bool set_mute(size_t index, bool muted) = 0;
+
+    // Bracket threads of the caller that write through set_volume()/set_mute(),
+    // for per-thread setup such as COM.
+    virtual void begin_thread() {}
+    virtual void end_thread() {}
+
+    virtual std::vector<audio_session_state> capture_sessions() { return std::vector<audio_session_state>(); }
+
+    // Applies all writes and returns once the backend accepted all of them.
+    // Backends overlap the individual requests; the default implementation
+    // simply issues them one after the other.
+    virtual void apply_batch(const std::vector<audio_write>& writes);
+
+    // Signal level source for every endpoint, see audio_meter.hpp. Returns
+    // nullptr when the backend cannot meter.
+    virtual std::unique_ptr<meter_source> create_meter_source();
+
+    // Called from the backend's notification thread, never from the caller of
+    // set_volume()/set_mute(). Keep the handler short.
+    void set_change_callback(change_callback callback);
+
+protected:
+    struct channel_state {
+        std::atomic<float> volume{0.0f};
+        std::atomic<bool> muted{false};
+    };
+
+    // Must be called once by the derived constructor after enumeration.
+    void init_devices(std::vector<audio_device_info> devices);
+
+    // Updates the cache and forwards the change to the callback.
+    void publish(size_t index, float volume, bool muted);
+    void store(size_t index, float volume, bool muted);
+
+private:
+    std::vector<audio_device_info> device_list;
+    std::unique_ptr<channel_state[]> channels;
+    std::mutex callback_mutex;
+    change_callback on_change;
+};
+
+// Picks the native backend for the platform (WASAPI on Windows, PulseAudio /
+// PipeWire on Linux). Falls back to the simulated mixer when no sound server
+// is reachable or when CONTROLLER_AUDIO_BACKEND=sim is set in the environment.
+std::unique_ptr<audio_backend> create_audio_backend();
+
+std::unique_ptr<audio_backend> create_wasapi_audio_backend();
+std::unique_ptr<audio_backend> create_pulse_audio_backend();
+
+// In-process mixer with the same semantics as the real backends: writes are
+// applied on a separate "server" thread after a small delay and reported back
+// through the change callback, exactly like a sound server would.
+struct simulated_audio_config {
+    std::vector<std::string> device_names{ "Simulated Speakers", "Simulated Headphones", "Simulated HDMI Output" };
+    std::vector<std::string> session_names{ "System Sounds", "Browser", "Music Player", "Voice Chat", "Game" };
+    float initial_volume = 0.5f;
+    int latency_ms = 2;
+};
+std::unique_ptr<audio_backend> create_simulated_audio_backend(const simulated_audio_config& config = simulated_audio_config());
+
+// Only implemented by the simulated mixer: emulates another application
+// changing an endpoint behind our back. Returns false for real backends.
+bool simulate_external_change(audio_backend& backend, size_t index, float volume, bool muted);
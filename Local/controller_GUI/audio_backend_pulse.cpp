@@ -0,0 +1,461 @@
+#include "audio_backend.hpp"
+
+#ifdef CONTROLLER_HAVE_PULSE
+#include "audio_meter.hpp"
+#include <pulse/pulseaudio.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+//--PulseAudio / PipeWire Backend-------------------------------------------------
+// Talks to PulseAudio, or to PipeWire through pipewire-pulse, with a threaded
+// mainloop. Sinks are enumerated once; afterwards the backend only reacts to
+// subscription events, so nothing is polled from the UI thread.
+class pulse_audio_backend : public audio_backend {
+public:
+    ~pulse_audio_backend() override;
+
+    bool init();
+    const char* name() const override { return "PulseAudio"; }
+    bool set_volume(size_t index, float volume) override;
+    bool set_mute(size_t index, bool muted) override;
+    std::vector<audio_session_state> capture_sessions() override;
+    void apply_batch(const std::vector<audio_write>& writes) override;
+    std::unique_ptr<meter_source> create_meter_source() override;
+
+    pa_threaded_mainloop* get_mainloop() const { return mainloop; }
+    pa_context* get_context() const { return context; }
+
+private:
+    struct sink_input {
+        uint32_t pa_index;
+        pa_cvolume volume;
+        audio_session_state state;
+    };
+
+    struct sink {
+        uint32_t pa_index;
+        pa_cvolume volume;          // Last known per-channel volume, keeps the balance on writes
+    };
+
+    static void on_context_state(pa_context* ctx, void* userdata);
+    static void on_sink_list(pa_context* ctx, const pa_sink_info* info, int eol, void* userdata);
+    static void on_sink_changed(pa_context* ctx, const pa_sink_info* info, int eol, void* userdata);
+    static void on_subscribe(pa_context* ctx, pa_subscription_event_type_t type, uint32_t idx, void* userdata);
+    static void on_sink_input_list(pa_context* ctx, const pa_sink_input_info* info, int eol, void* userdata);
+    static void on_operation_done(pa_context* ctx, int success, void* userdata);
+
+    void wait_for(pa_operation* op);
+    std::vector<sink_input> list_sink_inputs();
+    pa_operation* write_sink(size_t index, float volume, bool muted, pa_operation** mute_op);
+
+    int find_sink(uint32_t pa_index) const;
+    static float to_scalar(const pa_cvolume& volume);
+
+    pa_threaded_mainloop* mainloop = nullptr;
+    pa_context* context = nullptr;
+    std::vector<sink> sinks;                        // Guarded by the mainloop lock
+    std::vector<audio_device_info> pending_devices; // Only used during enumeration
+    std::vector<std::pair<float, bool>> pending_state;
+    std::vector<sink_input> pending_inputs;         // Only used while listing sink inputs
+};
+
+float pulse_audio_backend::to_scalar(const pa_cvolume& volume) {
+    // Same linear mapping as pavucontrol's percentage slider
+    return std::min((float)pa_cvolume_max(&volume) / (float)PA_VOLUME_NORM, 1.0f);
+}
+
+int pulse_audio_backend::find_sink(uint32_t pa_index) const {
+    for (size_t i = 0; i < sinks.size(); i++) {
+        if (sinks[i].pa_index == pa_index) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+void pulse_audio_backend::on_context_state(pa_context* ctx, void* userdata) {
+    pulse_audio_backend* self = static_cast<pulse_audio_backend*>(userdata);
+    switch (pa_context_get_state(ctx)) {
+    case PA_CONTEXT_READY:
+    case PA_CONTEXT_FAILED:
+    case PA_CONTEXT_TERMINATED:
+        pa_threaded_mainloop_signal(self->mainloop, 0);
+        break;
+    default:
+        break;
+    }
+}
+
+void pulse_audio_backend::on_sink_list(pa_context* ctx, const pa_sink_info* info, int eol, void* userdata) {
+    (void)ctx;
+    pulse_audio_backend* self = static_cast<pulse_audio_backend*>(userdata);
+    if (eol != 0 || info == nullptr) {
+        pa_threaded_mainloop_signal(self->mainloop, 0);
+        return;
+    }
+    self->sinks.push_back(sink{ info->index, info->volume });
+    self->pending_devices.push_back(audio_device_info{ info->name, info->description != nullptr ? info->description : info->name });
+    self->pending_state.push_back(std::make_pair(to_scalar(info->volume), info->mute != 0));
+}
+
+void pulse_audio_backend::on_sink_changed(pa_context* ctx, const pa_sink_info* info, int eol, void* userdata) {
+    (void)ctx;
+    pulse_audio_backend* self = static_cast<pulse_audio_backend*>(userdata);
+    if (eol != 0 || info == nullptr) {
+        return;
+    }
+    int index = self->find_sink(info->index);
+    if (index < 0) {
+        return;
+    }
+    self->sinks[index].volume = info->volume;
+    self->publish((size_t)index, to_scalar(info->volume), info->mute != 0);
+}
+
+void pulse_audio_backend::on_subscribe(pa_context* ctx, pa_subscription_event_type_t type, uint32_t idx, void* userdata) {
+    if ((type & PA_SUBSCRIPTION_EVENT_FACILITY_MASK) != PA_SUBSCRIPTION_EVENT_SINK) {
+        return;
+    }
+    if ((type & PA_SUBSCRIPTION_EVENT_TYPE_MASK) != PA_SUBSCRIPTION_EVENT_CHANGE) {
+        return;
+    }
+    pa_operation* op = pa_context_get_sink_info_by_index(ctx, idx, &pulse_audio_backend::on_sink_changed, userdata);
+    if (op != nullptr) {
+        pa_operation_unref(op);
+    }
+}
+
+void pulse_audio_backend::on_sink_input_list(pa_context* ctx, const pa_sink_input_info* info, int eol, void* userdata) {
+    (void)ctx;
+    pulse_audio_backend* self = static_cast<pulse_audio_backend*>(userdata);
+    if (eol != 0 || info == nullptr) {
+        pa_threaded_mainloop_signal(self->mainloop, 0);
+        return;
+    }
+    int device_index = self->find_sink(info->sink);
+    if (device_index < 0) {
+        return;
+    }
+    // The binary name survives restarts of the application, the index does not
+    const char* binary = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_PROCESS_BINARY);
+    const char* app_name = pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_NAME);
+    sink_input input;
+    input.pa_index = info->index;
+    input.volume = info->volume;
+    input.state.id = binary != nullptr ? binary : (app_name != nullptr ? app_name : info->name);
+    input.state.name = app_name != nullptr ? app_name : info->name;
+    input.state.device_index = (size_t)device_index;
+    input.state.volume = to_scalar(info->volume);
+    input.state.muted = info->mute != 0;
+    self->pending_inputs.push_back(input);
+}
+
+void pulse_audio_backend::on_operation_done(pa_context* ctx, int success, void* userdata) {
+    (void)ctx;
+    (void)success;
+    pulse_audio_backend* self = static_cast<pulse_audio_backend*>(userdata);
+    pa_threaded_mainloop_signal(self->mainloop, 0);
+}
+
+// Must be called with the mainloop locked
+void pulse_audio_backend::wait_for(pa_operation* op) {
+    if (op == nullptr) {
+        return;
+    }
+    while (pa_operation_get_state(op) == PA_OPERATION_RUNNING) {
+        pa_threaded_mainloop_wait(mainloop);
+    }
+    pa_operation_unref(op);
+}
+
+// Must be called with the mainloop locked
+std::vector<pulse_audio_backend::sink_input> pulse_audio_backend::list_sink_inputs() {
+    pending_inputs.clear();
+    wait_for(pa_context_get_sink_input_info_list(context, &pulse_audio_backend::on_sink_input_list, this));
+    std::vector<sink_input> inputs;
+    inputs.swap(pending_inputs);
+    return inputs;
+}
+
+std::vector<audio_session_state> pulse_audio_backend::capture_sessions() {
+    pa_threaded_mainloop_lock(mainloop);
+    std::vector<sink_input> inputs = list_sink_inputs();
+    pa_threaded_mainloop_unlock(mainloop);
+
+    std::vector<audio_session_state> sessions;
+    for (const sink_input& input : inputs) {
+        sessions.push_back(input.state);
+    }
+    return sessions;
+}
+
+void pulse_audio_backend::apply_batch(const std::vector<audio_write>& writes) {
+    std::vector<pa_operation*> ops;
+
+    pa_threaded_mainloop_lock(mainloop);
+    std::vector<sink_input> inputs;
+    for (const audio_write& w : writes) {
+        if (w.is_session) {
+            inputs = list_sink_inputs();
+            break;
+        }
+    }
+
+    // Issue everything first and only then wait, so the server processes the
+    // whole batch in one go instead of one round trip per write
+    for (const audio_write& w : writes) {
+        if (!w.is_session) {
+            pa_operation* mute_op = nullptr;
+            ops.push_back(write_sink(w.device_index, w.volume, w.muted, &mute_op));
+            ops.push_back(mute_op);
+            continue;
+        }
+        for (sink_input& input : inputs) {
+            if (input.state.id != w.session_id) {
+                continue;
+            }
+            pa_cvolume cv = input.volume;
+            pa_cvolume_scale(&cv, (pa_volume_t)(std::min(std::max(w.volume, 0.0f), 1.0f) * PA_VOLUME_NORM));
+            ops.push_back(pa_context_set_sink_input_volume(context, input.pa_index, &cv, &pulse_audio_backend::on_operation_done, this));
+            ops.push_back(pa_context_set_sink_input_mute(context, input.pa_index, w.muted ? 1 : 0, &pulse_audio_backend::on_operation_done, this));
+        }
+    }
+    for (pa_operation* op : ops) {
+        wait_for(op);
+    }
+    pa_threaded_mainloop_unlock(mainloop);
+}
+
+// Must be called with the mainloop locked
+pa_operation* pulse_audio_backend::write_sink(size_t index, float volume, bool muted, pa_operation** mute_op) {
+    if (index >= sinks.size()) {
+        return nullptr;
+    }
+    volume = std::min(std::max(volume, 0.0f), 1.0f);
+    store(index, volume, muted);
+
+    sink& s = sinks[index];
+    pa_cvolume cv = s.volume;
+    pa_cvolume_scale(&cv, (pa_volume_t)(volume * PA_VOLUME_NORM));
+    s.volume = cv;
+    *mute_op = pa_context_set_sink_mute_by_index(context, s.pa_index, muted ? 1 : 0, &pulse_audio_backend::on_operation_done, this);
+    return pa_context_set_sink_volume_by_index(context, s.pa_index, &cv, &pulse_audio_backend::on_operation_done, this);
+}
+
+bool pulse_audio_backend::init() {
+    mainloop = pa_threaded_mainloop_new();
+    if (mainloop == nullptr) {
+        return false;
+    }
+    context = pa_context_new(pa_threaded_mainloop_get_api(mainloop), "Smart Knob Controller");
+    if (context == nullptr) {
+        return false;
+    }
+    pa_context_set_state_callback(context, &pulse_audio_backend::on_context_state, this);
+
+    pa_threaded_mainloop_lock(mainloop);
+    if (pa_threaded_mainloop_start(mainloop) < 0 || pa_context_connect(context, nullptr, PA_CONTEXT_NOAUTOSPAWN, nullptr) < 0) {
+        pa_threaded_mainloop_unlock(mainloop);
+        return false;
+    }
+
+    // Wait for the connection to settle
+    pa_context_state_t state;
+    while ((state = pa_context_get_state(context)) != PA_CONTEXT_READY) {
+        if (!PA_CONTEXT_IS_GOOD(state)) {
+            pa_threaded_mainloop_unlock(mainloop);
+            return false;
+        }
+        pa_threaded_mainloop_wait(mainloop);
+    }
+
+    // One enumeration, the sink indices are cached from here on
+    pa_operation* op = pa_context_get_sink_info_list(context, &pulse_audio_backend::on_sink_list, this);
+    if (op != nullptr) {
+        while (pa_operation_get_state(op) == PA_OPERATION_RUNNING) {
+            pa_threaded_mainloop_wait(mainloop);
+        }
+        pa_operation_unref(op);
+    }
+
+    init_devices(std::move(pending_devices));
+    for (size_t i = 0; i < pending_state.size(); i++) {
+        store(i, pending_state[i].first, pending_state[i].second);
+    }
+    pending_state.clear();
+
+    pa_context_set_subscribe_callback(context, &pulse_audio_backend::on_subscribe, this);
+    op = pa_context_subscribe(context, PA_SUBSCRIPTION_MASK_SINK, nullptr, nullptr);
+    if (op != nullptr) {
+        pa_operation_unref(op);
+    }
+    pa_threaded_mainloop_unlock(mainloop);
+    return true;
+}
+
+pulse_audio_backend::~pulse_audio_backend() {
+    if (mainloop != nullptr) {
+        pa_threaded_mainloop_stop(mainloop);
+    }
+    if (context != nullptr) {
+        pa_context_disconnect(context);
+        pa_context_unref(context);
+    }
+    if (mainloop != nullptr) {
+        pa_threaded_mainloop_free(mainloop);
+    }
+}
+
+bool pulse_audio_backend::set_volume(size_t index, float volume) {
+    if (index >= device_count()) {
+        return false;
+    }
+    volume = std::min(std::max(volume, 0.0f), 1.0f);
+    store(index, volume, get_mute(index));
+
+    pa_threaded_mainloop_lock(mainloop);
+    sink& s = sinks[index];
+    pa_cvolume cv = s.volume;
+    pa_cvolume_scale(&cv, (pa_volume_t)(volume * PA_VOLUME_NORM));
+    // Fire and forget, the subscription reports the applied value
+    pa_operation* op = pa_context_set_sink_volume_by_index(context, s.pa_index, &cv, nullptr, nullptr);
+    if (op != nullptr) {
+        s.volume = cv;
+        pa_operation_unref(op);
+    }
+    pa_threaded_mainloop_unlock(mainloop);
+    return op != nullptr;
+}
+
+bool pulse_audio_backend::set_mute(size_t index, bool muted) {
+    if (index >= device_count()) {
+        return false;
+    }
+    store(index, get_volume(index), muted);
+
+    pa_threaded_mainloop_lock(mainloop);
+    pa_operation* op = pa_context_set_sink_mute_by_index(context, sinks[index].pa_index, muted ? 1 : 0, nullptr, nullptr);
+    if (op != nullptr) {
+        pa_operation_unref(op);
+    }
+    pa_threaded_mainloop_unlock(mainloop);
+    return op != nullptr;
+}
+
+//--Sink Meters-------------------------------------------------------------------
+// Records each sink's monitor source with PA_STREAM_PEAK_DETECT, which makes
+// the server deliver one peak value per fragment instead of the audio itself.
+// The server only reports peaks, so the RMS value is the RMS of the peak
+// envelope over ~300 ms.
+class pulse_meter_source : public meter_source {
+public:
+    explicit pulse_meter_source(pulse_audio_backend& backend) : audio(backend), slots(new slot[backend.device_count()]) {
+        pa_sample_spec spec;
+        spec.format = PA_SAMPLE_FLOAT32NE;
+        spec.rate = 100;
+        spec.channels = 1;
+
+        pa_buffer_attr attr;
+        attr.maxlength = (uint32_t)-1;
+        attr.tlength = (uint32_t)-1;
+        attr.prebuf = (uint32_t)-1;
+        attr.minreq = (uint32_t)-1;
+        attr.fragsize = sizeof(float);
+
+        pa_threaded_mainloop_lock(audio.get_mainloop());
+        for (size_t i = 0; i < audio.device_count(); i++) {
+            const std::string monitor = audio.devices()[i].id + ".monitor";
+            pa_stream* stream = pa_stream_new(audio.get_context(), "Peak detect", &spec, nullptr);
+            if (stream == nullptr) {
+                continue;
+            }
+            pa_stream_set_read_callback(stream, &pulse_meter_source::on_read, &slots[i]);
+            if (pa_stream_connect_record(stream, monitor.c_str(), &attr, (pa_stream_flags_t)(PA_STREAM_DONT_MOVE | PA_STREAM_PEAK_DETECT | PA_STREAM_ADJUST_LATENCY)) < 0) {
+                pa_stream_unref(stream);
+                continue;
+            }
+            slots[i].stream = stream;
+        }
+        pa_threaded_mainloop_unlock(audio.get_mainloop());
+    }
+
+    ~pulse_meter_source() override {
+        pa_threaded_mainloop_lock(audio.get_mainloop());
+        for (size_t i = 0; i < audio.device_count(); i++) {
+            if (slots[i].stream != nullptr) {
+                pa_stream_set_read_callback(slots[i].stream, nullptr, nullptr);
+                pa_stream_disconnect(slots[i].stream);
+                pa_stream_unref(slots[i].stream);
+            }
+        }
+        pa_threaded_mainloop_unlock(audio.get_mainloop());
+    }
+
+    void sample(std::vector<meter_level>& levels, float dt) override {
+        const float smoothing = std::min(dt / 0.3f, 1.0f);
+        for (size_t i = 0; i < levels.size() && i < audio.device_count(); i++) {
+            slot& s = slots[i];
+            const float peak = std::min(s.peak.exchange(0.0f), 1.0f);
+            s.mean_square += (peak * peak - s.mean_square) * smoothing;
+            levels[i].peak = peak;
+            levels[i].rms = std::sqrt(s.mean_square);
+        }
+    }
+
+private:
+    struct slot {
+        pa_stream* stream = nullptr;
+        std::atomic<float> peak{0.0f};  // Max since the last sample(), written by the mainloop thread
+        float mean_square = 0.0f;       // Sampling thread only
+    };
+
+    static void on_read(pa_stream* stream, size_t length, void* userdata) {
+        (void)length;
+        slot* s = static_cast<slot*>(userdata);
+        const void* data = nullptr;
+        size_t bytes = 0;
+        while (pa_stream_readable_size(stream) > 0) {
+            if (pa_stream_peek(stream, &data, &bytes) < 0) {
+                return;
+            }
+            if (data != nullptr) {
+                const float* values = static_cast<const float*>(data);
+                for (size_t i = 0; i < bytes / sizeof(float); i++) {
+                    float current = s->peak.load(std::memory_order_relaxed);
+                    const float value = std::fabs(values[i]);
+                    while (value > current && !s->peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                    }
+                }
+            }
+            // Holes (data == nullptr) must be dropped too
+            if (bytes > 0) {
+                pa_stream_drop(stream);
+            }
+        }
+    }
+
+    pulse_audio_backend& audio;
+    std::unique_ptr<slot[]> slots;
+};
+
+std::unique_ptr<meter_source> pulse_audio_backend::create_meter_source() {
+    return std::unique_ptr<meter_source>(new pulse_meter_source(*this));
+}
+
+//--Factory----------------------------------------------------------------------
+std::unique_ptr<audio_backend> create_pulse_audio_backend() {
+    std::unique_ptr<pulse_audio_backend> backend(new pulse_audio_backend());
+    if (!backend->init()) {
+        return nullptr;
+    }
+    return std::move(backend);
+}
+
+#else
+
+std::unique_ptr<audio_backend> create_pulse_audio_backend() {
+    return nullptr;
+}
+
+#endif // CONTROLLER_HAVE_PULSE
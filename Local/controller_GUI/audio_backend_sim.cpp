@@ -0,0 +1,194 @@
+#include "audio_backend.hpp"
+#include "audio_meter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <thread>
+
+//--Simulated Mixer--------------------------------------------------------------
+// Mirrors what a sound server does with our requests: the write is queued,
+// applied by the server thread a little later and then broadcast as a change
+// event to every client, including the one that issued it.
+class simulated_audio_backend : public audio_backend {
+public:
+    explicit simulated_audio_backend(const simulated_audio_config& config);
+    ~simulated_audio_backend() override;
+
+    const char* name() const override { return "Simulated"; }
+    bool set_volume(size_t index, float volume) override;
+    bool set_mute(size_t index, bool muted) override;
+    std::vector<audio_session_state> capture_sessions() override;
+    void apply_batch(const std::vector<audio_write>& writes) override;
+    std::unique_ptr<meter_source> create_meter_source() override { return create_simulated_meter_source(*this); }
+
+    void external_change(size_t index, float volume, bool muted);
+
+private:
+    // A request is applied as a whole after a single round trip, which is
+    // what makes batching pay off on the real servers too
+    struct request {
+        std::vector<audio_write> writes;
+        bool keep_volume;   // Single mute write, leave the volume alone
+        bool keep_mute;     // Single volume write, leave the mute alone
+        std::shared_ptr<std::promise<void>> done;
+    };
+
+    struct server_channel {
+        float volume;
+        bool muted;
+    };
+
+    void enqueue(request req);
+    void run();
+
+    std::chrono::milliseconds latency;
+    std::vector<server_channel> server_state;   // Owned by the server thread
+    std::vector<audio_session_state> sessions;  // Guarded by session_mutex
+    std::mutex session_mutex;
+    std::deque<request> queue;
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    bool stopping = false;
+    std::thread server_thread;
+};
+
+simulated_audio_backend::simulated_audio_backend(const simulated_audio_config& config) : latency(config.latency_ms) {
+    std::vector<audio_device_info> devices;
+    for (size_t i = 0; i < config.device_names.size(); i++) {
+        devices.push_back(audio_device_info{ "sim:" + std::to_string(i), config.device_names[i] });
+        server_state.push_back(server_channel{ config.initial_volume, false });
+    }
+    for (size_t i = 0; i < config.session_names.size() && !devices.empty(); i++) {
+        const std::string& session_name = config.session_names[i];
+        sessions.push_back(audio_session_state{ "sim-session:" + session_name, session_name, i % devices.size(), 1.0f, false });
+    }
+    init_devices(std::move(devices));
+    for (size_t i = 0; i < server_state.size(); i++) {
+        store(i, server_state[i].volume, server_state[i].muted);
+    }
+    server_thread = std::thread([this]() { run(); });
+}
+
+simulated_audio_backend::~simulated_audio_backend() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_cv.notify_one();
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
+}
+
+bool simulated_audio_backend::set_volume(size_t index, float volume) {
+    if (index >= device_count()) {
+        return false;
+    }
+    volume = std::min(std::max(volume, 0.0f), 1.0f);
+    store(index, volume, get_mute(index));
+    enqueue(request{ { audio_write{ false, index, std::string(), volume, false } }, false, true, nullptr });
+    return true;
+}
+
+bool simulated_audio_backend::set_mute(size_t index, bool muted) {
+    if (index >= device_count()) {
+        return false;
+    }
+    store(index, get_volume(index), muted);
+    enqueue(request{ { audio_write{ false, index, std::string(), 0.0f, muted } }, true, false, nullptr });
+    return true;
+}
+
+std::vector<audio_session_state> simulated_audio_backend::capture_sessions() {
+    std::lock_guard<std::mutex> lock(session_mutex);
+    return sessions;
+}
+
+void simulated_audio_backend::apply_batch(const std::vector<audio_write>& writes) {
+    for (const audio_write& w : writes) {
+        if (!w.is_session) {
+            store(w.device_index, w.volume, w.muted);
+        }
+    }
+    std::shared_ptr<std::promise<void>> done = std::make_shared<std::promise<void>>();
+    std::future<void> applied = done->get_future();
+    enqueue(request{ writes, false, false, done });
+    applied.wait();
+}
+
+void simulated_audio_backend::external_change(size_t index, float volume, bool muted) {
+    if (index >= device_count()) {
+        return;
+    }
+    enqueue(request{ { audio_write{ false, index, std::string(), std::min(std::max(volume, 0.0f), 1.0f), muted } }, false, false, nullptr });
+}
+
+void simulated_audio_backend::enqueue(request req) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        queue.push_back(std::move(req));
+    }
+    queue_cv.notify_one();
+}
+
+void simulated_audio_backend::run() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    while (true) {
+        queue_cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (stopping) {
+            return;
+        }
+        request req = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+
+        // Emulate the round trip to the server
+        if (latency.count() > 0) {
+            std::this_thread::sleep_for(latency);
+        }
+        for (const audio_write& w : req.writes) {
+            if (w.is_session) {
+                std::lock_guard<std::mutex> session_lock(session_mutex);
+                for (audio_session_state& session : sessions) {
+                    if (session.id == w.session_id) {
+                        session.volume = w.volume;
+                        session.muted = w.muted;
+                    }
+                }
+                continue;
+            }
+            if (w.device_index >= server_state.size()) {
+                continue;
+            }
+            server_channel& channel = server_state[w.device_index];
+            if (!req.keep_volume) {
+                channel.volume = w.volume;
+            }
+            if (!req.keep_mute) {
+                channel.muted = w.muted;
+            }
+            publish(w.device_index, channel.volume, channel.muted);
+        }
+        if (req.done) {
+            req.done->set_value();
+        }
+
+        lock.lock();
+    }
+}
+
+//--Factory----------------------------------------------------------------------
+std::unique_ptr<audio_backend> create_simulated_audio_backend(const simulated_audio_config& config) {
+    return std::unique_ptr<audio_backend>(new simulated_audio_backend(config));
+}
+
+bool simulate_external_change(audio_backend& backend, size_t index, float volume, bool muted) {
+    simulated_audio_backend* sim = dynamic_cast<simulated_audio_backend*>(&backend);
+    if (sim == nullptr) {
+        return false;
+    }
+    sim->external_change(index, volume, muted);
+    return true;
+}
@@ -0,0 +1,410 @@
+#ifdef _WIN32
+#include "audio_backend.hpp"
+#include "audio_meter.hpp"
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <mmdeviceapi.h>
+#include <endpointvolume.h>
+#include <audiopolicy.h>
+#include <functiondiscoverykeys_devpkey.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <iostream>
+
+//--Helper Functions-----------------------------------------------------------
+static std::string wstring_to_string(const std::wstring& wstr) {
+    int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int)wstr.size(), NULL, 0, NULL, NULL);
+    std::string strTo(size_needed, 0);
+    WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
+    return strTo;
+}
+
+//--Endpoint Notifications-------------------------------------------------------
+// One callback object per endpoint so OnNotify() knows its index without a
+// lookup. WASAPI calls it on its own worker thread.
+class endpoint_volume_callback : public IAudioEndpointVolumeCallback {
+public:
+    endpoint_volume_callback(std::function<void(float, bool)> on_notify) : ref_count(1), handler(std::move(on_notify)) {}
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return InterlockedIncrement(&ref_count); }
+    ULONG STDMETHODCALLTYPE Release() override {
+        ULONG count = InterlockedDecrement(&ref_count);
+        if (count == 0) {
+            delete this;
+        }
+        return count;
+    }
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if (riid == IID_IUnknown || riid == __uuidof(IAudioEndpointVolumeCallback)) {
+            AddRef();
+            *ppv = static_cast<IAudioEndpointVolumeCallback*>(this);
+            return S_OK;
+        }
+        *ppv = NULL;
+        return E_NOINTERFACE;
+    }
+    HRESULT STDMETHODCALLTYPE OnNotify(PAUDIO_VOLUME_NOTIFICATION_DATA p_notify) override {
+        if (p_notify != NULL) {
+            handler(p_notify->fMasterVolume, p_notify->bMuted != FALSE);
+        }
+        return S_OK;
+    }
+
+private:
+    LONG ref_count;
+    std::function<void(float, bool)> handler;
+};
+
+//--WASAPI Backend---------------------------------------------------------------
+class wasapi_audio_backend : public audio_backend {
+public:
+    ~wasapi_audio_backend() override;
+
+    bool init();
+    const char* name() const override { return "WASAPI"; }
+    bool set_volume(size_t index, float volume) override;
+    bool set_mute(size_t index, bool muted) override;
+    void begin_thread() override;
+    void end_thread() override;
+    std::vector<audio_session_state> capture_sessions() override;
+    void apply_batch(const std::vector<audio_write>& writes) override;
+    std::unique_ptr<meter_source> create_meter_source() override;
+
+private:
+    static void for_each_session(IMMDevice* device, const std::function<void(IAudioSessionControl2*, ISimpleAudioVolume*)>& fn);
+    void apply_device_writes(size_t index, const std::vector<const audio_write*>& writes);
+
+    struct endpoint {
+        IMMDevice* device = nullptr;
+        IAudioEndpointVolume* volume = nullptr;
+        endpoint_volume_callback* callback = nullptr;
+    };
+
+    bool com_initialized = false;
+    std::vector<endpoint> endpoints;
+};
+
+bool wasapi_audio_backend::init() {
+    HRESULT hr = CoInitialize(nullptr);
+    com_initialized = SUCCEEDED(hr);
+
+    IMMDeviceEnumerator* p_enumerator = nullptr;
+    hr = CoCreateInstance(
+        __uuidof(MMDeviceEnumerator), NULL, CLSCTX_INPROC_SERVER,
+        __uuidof(IMMDeviceEnumerator), (void**)&p_enumerator);
+    if (FAILED(hr)) {
+        return false;
+    }
+
+    std::vector<audio_device_info> device_infos;
+    IMMDeviceCollection* p_collection = nullptr;
+    hr = p_enumerator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &p_collection);
+    if (SUCCEEDED(hr)) {
+        UINT count = 0;
+        p_collection->GetCount(&count);
+
+        for (UINT i = 0; i < count; i++) {
+            IMMDevice* p_device = nullptr;
+            if (FAILED(p_collection->Item(i, &p_device))) {
+                continue;
+            }
+
+            audio_device_info info;
+            LPWSTR id = nullptr;
+            if (SUCCEEDED(p_device->GetId(&id))) {
+                info.id = wstring_to_string(id);
+                CoTaskMemFree(id);
+            }
+
+            IPropertyStore* p_store = nullptr;
+            if (SUCCEEDED(p_device->OpenPropertyStore(STGM_READ, &p_store))) {
+                PROPVARIANT var_name;
+                PropVariantInit(&var_name);
+                if (SUCCEEDED(p_store->GetValue(PKEY_Device_FriendlyName, &var_name))) {
+                    info.name = wstring_to_string(var_name.pwszVal);
+                    PropVariantClear(&var_name);
+                }
+                p_store->Release();
+            }
+
+            // Keep the volume interface for the lifetime of the backend instead
+            // of re-enumerating the endpoints on every read/write
+            IAudioEndpointVolume* p_volume = nullptr;
+            if (FAILED(p_device->Activate(__uuidof(IAudioEndpointVolume), CLSCTX_ALL, NULL, (void**)&p_volume))) {
+                p_device->Release();
+                continue;
+            }
+
+            endpoint ep;
+            ep.device = p_device;
+            ep.volume = p_volume;
+            endpoints.push_back(ep);
+            device_infos.push_back(info);
+        }
+        p_collection->Release();
+    }
+    p_enumerator->Release();
+
+    init_devices(std::move(device_infos));
+
+    for (size_t i = 0; i < endpoints.size(); i++) {
+        endpoint& ep = endpoints[i];
+        float level = 0.0f;
+        BOOL muted = FALSE;
+        ep.volume->GetMasterVolumeLevelScalar(&level);
+        ep.volume->GetMute(&muted);
+        store(i, level, muted != FALSE);
+
+        ep.callback = new endpoint_volume_callback([this, i](float volume, bool is_muted) { publish(i, volume, is_muted); });
+        if (FAILED(ep.volume->RegisterControlChangeNotify(ep.callback))) {
+            std::cerr << "Failed to register volume notifications for " << devices()[i].name << std::endl;
+            ep.callback->Release();
+            ep.callback = nullptr;
+        }
+    }
+    return true;
+}
+
+wasapi_audio_backend::~wasapi_audio_backend() {
+    for (endpoint& ep : endpoints) {
+        if (ep.callback != nullptr) {
+            ep.volume->UnregisterControlChangeNotify(ep.callback);
+            ep.callback->Release();
+        }
+        ep.volume->Release();
+        ep.device->Release();
+    }
+    endpoints.clear();
+
+    if (com_initialized) {
+        CoUninitialize();
+    }
+}
+
+bool wasapi_audio_backend::set_volume(size_t index, float volume) {
+    if (index >= endpoints.size()) {
+        return false;
+    }
+    store(index, volume, get_mute(index));
+    return SUCCEEDED(endpoints[index].volume->SetMasterVolumeLevelScalar(volume, NULL));
+}
+
+// Caller threads join the MTA, the endpoint volume interfaces are agile
+static thread_local bool thread_com_initialized = false;
+
+void wasapi_audio_backend::begin_thread() {
+    thread_com_initialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+}
+
+void wasapi_audio_backend::end_thread() {
+    if (thread_com_initialized) {
+        CoUninitialize();
+        thread_com_initialized = false;
+    }
+}
+
+bool wasapi_audio_backend::set_mute(size_t index, bool muted) {
+    if (index >= endpoints.size()) {
+        return false;
+    }
+    store(index, get_volume(index), muted);
+    return SUCCEEDED(endpoints[index].volume->SetMute(muted ? TRUE : FALSE, NULL));
+}
+
+void wasapi_audio_backend::for_each_session(IMMDevice* device, const std::function<void(IAudioSessionControl2*, ISimpleAudioVolume*)>& fn) {
+    IAudioSessionManager2* p_manager = nullptr;
+    if (FAILED(device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, NULL, (void**)&p_manager))) {
+        return;
+    }
+    IAudioSessionEnumerator* p_sessions = nullptr;
+    if (SUCCEEDED(p_manager->GetSessionEnumerator(&p_sessions))) {
+        int count = 0;
+        p_sessions->GetCount(&count);
+        for (int i = 0; i < count; i++) {
+            IAudioSessionControl* p_control = nullptr;
+            if (FAILED(p_sessions->GetSession(i, &p_control))) {
+                continue;
+            }
+            IAudioSessionControl2* p_control2 = nullptr;
+            ISimpleAudioVolume* p_volume = nullptr;
+            if (SUCCEEDED(p_control->QueryInterface(__uuidof(IAudioSessionControl2), (void**)&p_control2)) &&
+                SUCCEEDED(p_control->QueryInterface(__uuidof(ISimpleAudioVolume), (void**)&p_volume))) {
+                fn(p_control2, p_volume);
+            }
+            if (p_volume != nullptr) {
+                p_volume->Release();
+            }
+            if (p_control2 != nullptr) {
+                p_control2->Release();
+            }
+            p_control->Release();
+        }
+        p_sessions->Release();
+    }
+    p_manager->Release();
+}
+
+std::vector<audio_session_state> wasapi_audio_backend::capture_sessions() {
+    std::vector<audio_session_state> sessions;
+    for (size_t i = 0; i < endpoints.size(); i++) {
+        for_each_session(endpoints[i].device, [&](IAudioSessionControl2* p_control, ISimpleAudioVolume* p_volume) {
+            audio_session_state session;
+            // The session identifier is stable for an application on an endpoint,
+            // unlike the instance identifier
+            LPWSTR id = nullptr;
+            if (FAILED(p_control->GetSessionIdentifier(&id))) {
+                return;
+            }
+            session.id = wstring_to_string(id);
+            CoTaskMemFree(id);
+            LPWSTR display_name = nullptr;
+            if (SUCCEEDED(p_control->GetDisplayName(&display_name))) {
+                session.name = wstring_to_string(display_name);
+                CoTaskMemFree(display_name);
+            }
+            if (session.name.empty()) {
+                session.name = session.id;
+            }
+            session.device_index = i;
+            BOOL muted = FALSE;
+            p_volume->GetMasterVolume(&session.volume);
+            p_volume->GetMute(&muted);
+            session.muted = muted != FALSE;
+            sessions.push_back(session);
+        });
+    }
+    return sessions;
+}
+
+void wasapi_audio_backend::apply_device_writes(size_t index, const std::vector<const audio_write*>& writes) {
+    // Worker threads join the MTA; the endpoint volume interfaces are agile
+    HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    bool has_sessions = false;
+    for (const audio_write* w : writes) {
+        if (w->is_session) {
+            has_sessions = true;
+            continue;
+        }
+        set_volume(index, w->volume);
+        set_mute(index, w->muted);
+    }
+    if (has_sessions) {
+        for_each_session(endpoints[index].device, [&](IAudioSessionControl2* p_control, ISimpleAudioVolume* p_volume) {
+            LPWSTR id = nullptr;
+            if (FAILED(p_control->GetSessionIdentifier(&id))) {
+                return;
+            }
+            std::string session_id = wstring_to_string(id);
+            CoTaskMemFree(id);
+            for (const audio_write* w : writes) {
+                if (w->is_session && w->session_id == session_id) {
+                    p_volume->SetMasterVolume(w->volume, NULL);
+                    p_volume->SetMute(w->muted ? TRUE : FALSE, NULL);
+                }
+            }
+        });
+    }
+    if (SUCCEEDED(hr)) {
+        CoUninitialize();
+    }
+}
+
+void wasapi_audio_backend::apply_batch(const std::vector<audio_write>& writes) {
+    // Each endpoint is driven from its own thread, WASAPI calls on different
+    // endpoints do not serialize against each other
+    std::vector<std::vector<const audio_write*>> per_device(endpoints.size());
+    for (const audio_write& w : writes) {
+        if (w.device_index < endpoints.size()) {
+            per_device[w.device_index].push_back(&w);
+        }
+    }
+    std::vector<std::future<void>> pending;
+    for (size_t i = 0; i < per_device.size(); i++) {
+        if (!per_device[i].empty()) {
+            pending.push_back(std::async(std::launch::async, [this, i, &per_device]() { apply_device_writes(i, per_device[i]); }));
+        }
+    }
+    for (std::future<void>& f : pending) {
+        f.wait();
+    }
+}
+
+//--Endpoint Meters--------------------------------------------------------------
+// IAudioMeterInformation only reports the peak of the last device period, so
+// the RMS value is the RMS of the sampled peak envelope over ~300 ms.
+class wasapi_meter_source : public meter_source {
+public:
+    explicit wasapi_meter_source(const std::vector<IMMDevice*>& devices) {
+        for (IMMDevice* p_device : devices) {
+            IAudioMeterInformation* p_meter = nullptr;
+            if (FAILED(p_device->Activate(__uuidof(IAudioMeterInformation), CLSCTX_ALL, NULL, (void**)&p_meter))) {
+                p_meter = nullptr;
+            }
+            meters.push_back(p_meter);
+            mean_squares.push_back(0.0f);
+        }
+    }
+
+    ~wasapi_meter_source() override {
+        for (IAudioMeterInformation* p_meter : meters) {
+            if (p_meter != nullptr) {
+                p_meter->Release();
+            }
+        }
+    }
+
+    void begin_thread() override { com_initialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED)); }
+    void end_thread() override {
+        if (com_initialized) {
+            CoUninitialize();
+        }
+    }
+
+    void sample(std::vector<meter_level>& levels, float dt) override {
+        const float smoothing = std::min(dt / 0.3f, 1.0f);
+        for (size_t i = 0; i < levels.size() && i < meters.size(); i++) {
+            float peak = 0.0f;
+            if (meters[i] != nullptr) {
+                meters[i]->GetPeakValue(&peak);
+            }
+            mean_squares[i] += (peak * peak - mean_squares[i]) * smoothing;
+            levels[i].peak = peak;
+            levels[i].rms = std::sqrt(mean_squares[i]);
+        }
+    }
+
+private:
+    std::vector<IAudioMeterInformation*> meters;
+    std::vector<float> mean_squares;
+    bool com_initialized = false;
+};
+
+std::unique_ptr<meter_source> wasapi_audio_backend::create_meter_source() {
+    std::vector<IMMDevice*> devices;
+    for (const endpoint& ep : endpoints) {
+        devices.push_back(ep.device);
+    }
+    return std::unique_ptr<meter_source>(new wasapi_meter_source(devices));
+}
+
+//--Factory----------------------------------------------------------------------
+std::unique_ptr<audio_backend> create_wasapi_audio_backend() {
+    std::unique_ptr<wasapi_audio_backend> backend(new wasapi_audio_backend());
+    if (!backend->init()) {
+        return nullptr;
+    }
+    return std::move(backend);
+}
+
+#else
+
+#include "audio_backend.hpp"
+
+std::unique_ptr<audio_backend> create_wasapi_audio_backend() {
+    return nullptr;
+}
+
+#endif // _WIN32
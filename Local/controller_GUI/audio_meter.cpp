@@ -0,0 +1,121 @@
+#include "audio_meter.hpp"
+#include "audio_backend.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//--Simulated Meter Source-------------------------------------------------------
+class simulated_meter_source : public meter_source {
+public:
+    explicit simulated_meter_source(const audio_backend& backend) : audio(backend), time(0.0), noise_state(0x12345678u) {}
+
+    void sample(std::vector<meter_level>& levels, float dt) override {
+        const double sample_rate = 48000.0;
+        const int sample_count = std::max(1, std::min((int)(sample_rate * dt), 4800));
+        const double two_pi = 6.28318530717958647692;
+
+        for (size_t device = 0; device < levels.size(); device++) {
+            const float gain = audio.get_mute(device) ? 0.0f : audio.get_volume(device);
+            float peak = 0.0f;
+            double sum_squares = 0.0;
+            for (int i = 0; i < sample_count; i++) {
+                const double t = time + i / sample_rate;
+                // Slow envelope with a different phase per endpoint, two tones and some noise
+                const double envelope = 0.55 + 0.35 * std::sin(two_pi * (0.25 + 0.05 * device) * t + device);
+                const double tone = 0.6 * std::sin(two_pi * 220.0 * t) + 0.3 * std::sin(two_pi * 331.0 * t);
+                const float value = (float)(envelope * tone) * gain + next_noise() * 0.05f * gain;
+                peak = std::max(peak, std::fabs(value));
+                sum_squares += (double)value * value;
+            }
+            levels[device].peak = std::min(peak, 1.0f);
+            levels[device].rms = (float)std::sqrt(sum_squares / sample_count);
+        }
+        time += sample_count / sample_rate;
+    }
+
+private:
+    float next_noise() {
+        // xorshift32, mapped to -1 .. 1
+        noise_state ^= noise_state << 13;
+        noise_state ^= noise_state >> 17;
+        noise_state ^= noise_state << 5;
+        return (float)(noise_state & 0xFFFF) / 32767.5f - 1.0f;
+    }
+
+    const audio_backend& audio;
+    double time;
+    unsigned int noise_state;
+};
+
+std::unique_ptr<meter_source> create_simulated_meter_source(const audio_backend& backend) {
+    return std::unique_ptr<meter_source>(new simulated_meter_source(backend));
+}
+
+//--meter_pipeline Implimentation-------------------------------------------------
+meter_pipeline::meter_pipeline(std::unique_ptr<meter_source> meter, size_t channel_count, float sample_hz)
+    : source(std::move(meter)), channels(channel_count), rate(sample_hz), ring(new meter_level[ring_frames * std::max(channel_count, (size_t)1)]), written(0), consumed(0), running(true) {
+    sampler = std::thread([this]() { run(); });
+}
+
+meter_pipeline::~meter_pipeline() {
+    running = false;
+    if (sampler.joinable()) {
+        sampler.join();
+    }
+}
+
+void meter_pipeline::run() {
+    const std::chrono::duration<double> interval(1.0 / rate);
+    std::vector<meter_level> levels(channels);
+    std::chrono::steady_clock::time_point next_sample = std::chrono::steady_clock::now();
+    source->begin_thread();
+    while (running.load()) {
+        source->sample(levels, (float)interval.count());
+
+        // Single producer: fill the slot, then publish it. When the render
+        // thread lags a full ring behind, drop the frame rather than
+        // overwriting a slot it may be reading.
+        const unsigned long long frame = written.load(std::memory_order_relaxed);
+        if (frame - consumed.load(std::memory_order_acquire) < ring_frames) {
+            std::copy(levels.begin(), levels.end(), &ring[(frame % ring_frames) * channels]);
+            written.store(frame + 1, std::memory_order_release);
+        }
+
+        next_sample += std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+        std::this_thread::sleep_until(next_sample);
+    }
+    source->end_thread();
+}
+
+void meter_pipeline::read(std::vector<meter_display>& display, float dt) {
+    const float fall_rate = 1.5f;       // Full scale per second
+    const float hold_seconds = 1.0f;
+    display.resize(channels);
+
+    // The sampler never writes to slots between consumed and head, see run()
+    const unsigned long long tail = consumed.load(std::memory_order_relaxed);
+    const unsigned long long head = written.load(std::memory_order_acquire);
+    const unsigned long long frame_count = head - tail;
+
+    for (size_t c = 0; c < channels; c++) {
+        float peak = 0.0f;
+        float sum_squares = 0.0f;
+        for (unsigned long long f = tail; f < head; f++) {
+            const meter_level& level = ring[(f % ring_frames) * channels + c];
+            peak = std::max(peak, level.peak);
+            sum_squares += level.rms * level.rms;
+        }
+        const float rms = frame_count > 0 ? std::sqrt(sum_squares / frame_count) : 0.0f;
+
+        meter_display& d = display[c];
+        d.peak = std::max(peak, d.peak - fall_rate * dt);
+        d.rms = std::max(rms, d.rms - fall_rate * dt);
+        if (peak >= d.hold) {
+            d.hold = peak;
+            d.hold_time = hold_seconds;
+        } else if ((d.hold_time -= dt) <= 0.0f) {
+            d.hold = std::max(d.hold - fall_rate * dt, d.peak);
+        }
+    }
+    consumed.store(head, std::memory_order_release);
+}
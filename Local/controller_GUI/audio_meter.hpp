@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Signal level metering per endpoint (the IAudioMeterInformation model).
+//
+// A meter_source is sampled by meter_pipeline on its own thread at a fixed
+// rate. Each sample is one frame holding the level of every endpoint, pushed
+// into a single-producer/single-consumer ring (dropped when the ring is full,
+// if the render thread stalls). The render thread only reads
+// the frames published since its previous read and never calls into the
+// audio stack, so a frame costs the same whatever the number of endpoints
+// the backend has to query.
+
+class audio_backend;
+
+struct meter_level {
+    float peak = 0.0f;      // 0.0f .. 1.0f, linear amplitude
+    float rms = 0.0f;
+};
+
+class meter_source {
+public:
+    virtual ~meter_source() = default;
+
+    // Bracket the sampling thread, for per-thread setup such as COM.
+    virtual void begin_thread() {}
+    virtual void end_thread() {}
+
+    // Called from the sampling thread only. levels has one entry per endpoint.
+    // dt is the time since the previous call in seconds.
+    virtual void sample(std::vector<meter_level>& levels, float dt) = 0;
+};
+
+// Synthesised program material (a few tones with a moving envelope) scaled by
+// each endpoint's volume and mute state, so meters react to the sliders.
+std::unique_ptr<meter_source> create_simulated_meter_source(const audio_backend& backend);
+
+// Levels as the UI draws them: decimated from the frames received since the
+// previous read, with peak hold and a falling bar.
+struct meter_display {
+    float peak = 0.0f;
+    float rms = 0.0f;
+    float hold = 0.0f;
+    float hold_time = 0.0f;
+};
+
+class meter_pipeline {
+public:
+    meter_pipeline(std::unique_ptr<meter_source> source, size_t channel_count, float sample_hz = 100.0f);
+    ~meter_pipeline();
+
+    // Render thread. Folds new frames into display and applies the ballistics.
+    void read(std::vector<meter_display>& display, float dt);
+
+private:
+    static const size_t ring_frames = 64;
+
+    void run();
+
+    std::unique_ptr<meter_source> source;
+    size_t channels;
+    float rate;
+    std::unique_ptr<meter_level[]> ring;        // ring_frames * channels
+    std::atomic<unsigned long long> written;    // Frames published by the sampler
+    std::atomic<unsigned long long> consumed;   // Frames folded by read(), the sampler stays within ring_frames of it
+    std::atomic<bool> running;
+    std::thread sampler;
+};
@@ -1,22 +1,58 @@
 #include "controller_ui.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 
 //--Helper Functions-----------------------------------------------------------
-std::string wstring_to_string(const std::wstring& wstr) {
-    int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int)wstr.size(), NULL, 0, NULL, NULL);
-    std::string strTo(size_needed, 0);
-    WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
-    return strTo;
+static double now_seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Vertical or horizontal level meter drawn at the cursor: RMS as the body,
+// peak as a lighter overlay and a one pixel peak hold line
+static void draw_level_meter(const meter_display& level, const ImVec2& size, bool vertical) {
+    ImVec2 min = ImGui::GetCursorScreenPos();
+    ImVec2 max(min.x + size.x, min.y + size.y);
+    ImGui::Dummy(size);
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddRectFilled(min, max, ImGui::GetColorU32(ImGuiCol_FrameBg), 2.0f);
+
+    ImU32 color = level.peak < 0.7f ? IM_COL32(60, 200, 90, 255) : level.peak < 0.9f ? IM_COL32(230, 200, 50, 255) : IM_COL32(230, 60, 50, 255);
+    ImU32 peak_color = (color & 0x00FFFFFF) | 0x70000000;
+    if (vertical) {
+        float height = max.y - min.y;
+        draw_list->AddRectFilled(ImVec2(min.x, max.y - height * level.peak), max, peak_color);
+        draw_list->AddRectFilled(ImVec2(min.x, max.y - height * level.rms), max, color);
+        float hold_y = max.y - height * level.hold;
+        draw_list->AddLine(ImVec2(min.x, hold_y), ImVec2(max.x, hold_y), IM_COL32_WHITE);
+    } else {
+        float width = max.x - min.x;
+        draw_list->AddRectFilled(min, ImVec2(min.x + width * level.peak, max.y), peak_color);
+        draw_list->AddRectFilled(min, ImVec2(min.x + width * level.rms, max.y), color);
+        float hold_x = min.x + width * level.hold;
+        draw_list->AddLine(ImVec2(hold_x, min.y), ImVec2(hold_x, max.y), IM_COL32_WHITE);
+    }
 }
 
 //--controller_ui Implimentation------------------------------------------------
-controller_ui::controller_ui() : selected_device(0), progress(0.0f), selected_com_port(0), is_started(false) {
-    load_com_ports();
+controller_ui::controller_ui() : smoothing_running(false), scene_name(), selected_device(0), com_port_user_selected(false), progress(0.0f), is_started(false) {
+    refresh_com_ports();
     load_audio_devices();
+    start_smoothing();
     start_io_context();
 }
 
 controller_ui::~controller_ui()
 {
+    // The backend's notification thread outlives the smoother it calls into,
+    // detach it first. Then stop every thread still using the backend.
+    if (audio) {
+        audio->set_change_callback(nullptr);
+    }
+    meters.reset();
+    scenes.reset();
+    stop_smoothing();
     io_context.stop();
     if (io_thread.joinable()) {
         io_thread.join();
@@ -24,217 +60,96 @@ controller_ui::~controller_ui()
 }
 
 //--controller_ui Methods-------------------------------------------------------
-void controller_ui::load_com_ports() {
-    // Clear any existing ports
-    active_com_ports.clear();
-
-    // Open the registry key where COM port information is stored
-    HKEY h_key;
-    if (RegOpenKeyEx(HKEY_LOCAL_MACHINE, TEXT("HARDWARE\\DEVICEMAP\\SERIALCOMM"), 0, KEY_READ, &h_key) == ERROR_SUCCESS) {
-        DWORD index = 0;
-        TCHAR port_name[256];
-        TCHAR com_port[256];
-        DWORD port_name_size = sizeof(port_name);
-        DWORD com_port_size = sizeof(com_port);
-
-        // Enumerate all COM ports
-        while (RegEnumValue(h_key, index, port_name, &port_name_size, NULL, NULL, (LPBYTE)com_port, &com_port_size) == ERROR_SUCCESS) {
-            #ifdef UNICODE
-                std::wstring ws(com_port); // Use `wstring` directly in Unicode builds
-                active_com_ports.push_back(wstring_to_string(ws));
-            #else
-                std::string s(com_port);    // Use `string` directly in ANSI builds
-                active_com_ports.push_back(s);
-            #endif
-
-            index++;
-            port_name_size = sizeof(port_name);
-            com_port_size = sizeof(com_port);
-        }
+void controller_ui::refresh_com_ports() {
+    // One atomic load per frame, the snapshot is only fetched when the
+    // discovery thread published a new one
+    if (active_com_ports && active_com_ports->generation == com_port_discovery.generation()) {
+        return;
+    }
+    active_com_ports = com_port_discovery.snapshot();
 
-        // Close the registry key after enumeration
-        RegCloseKey(h_key);
+    // Follow the knob when it is plugged in, unless the user picked a port
+    // that is still present or a port is currently open
+    if (is_started || (com_port_user_selected && active_com_ports->find(selected_com_port) >= 0)) {
+        return;
+    }
+    int knob_index = active_com_ports->find_knob();
+    if (knob_index >= 0) {
+        selected_com_port = active_com_ports->ports[knob_index].path;
+        com_port_user_selected = false;
+    } else if (active_com_ports->find(selected_com_port) < 0) {
+        selected_com_port = active_com_ports->ports.empty() ? std::string() : active_com_ports->ports[0].path;
     }
 }
 
 void controller_ui::load_audio_devices() {
-    // Initialize COM library
-    CoInitialize(nullptr);
-
-    // Use MMDevice API to enumerate audio endpoints
-    IMMDeviceEnumerator* p_enumeator = nullptr;
-    HRESULT hr = CoCreateInstance(
-        __uuidof(MMDeviceEnumerator), NULL, CLSCTX_INPROC_SERVER,
-        __uuidof(IMMDeviceEnumerator), (void**)&p_enumeator);
-
-    if (SUCCEEDED(hr)) {
-        IMMDeviceCollection* p_collection = nullptr;
-        hr = p_enumeator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &p_collection);
-
-        if (SUCCEEDED(hr)) {
-            UINT count;
-            p_collection->GetCount(&count);
-
-            for (UINT i = 0; i < count; i++) {
-                IMMDevice* p_device = nullptr;
-                hr = p_collection->Item(i, &p_device);
-                if (SUCCEEDED(hr)) {
-                    IPropertyStore* p_store;
-                    hr = p_device->OpenPropertyStore(STGM_READ, &p_store);
-                    if (SUCCEEDED(hr)) {
-                        PROPVARIANT var_name;
-                        PropVariantInit(&var_name);
-                        hr = p_store->GetValue(PKEY_Device_FriendlyName, &var_name);
-                        if (SUCCEEDED(hr)) {
-                            // Convert LPWSTR to std::string safely using the helper function
-                            std::wstring ws(var_name.pwszVal);
-                            std::string deviceName = wstring_to_string(ws);
-                            // Store device name
-                            audio_devices.push_back(deviceName);
-                            PropVariantClear(&var_name);
-                        }
-                        p_store->Release();
-                    }
-                    p_device->Release();
-                }
-            }
-            p_collection->Release();
-        }
-        p_enumeator->Release();
-    }
+    // The backend enumerates the endpoints once and keeps their handles
+    audio = create_audio_backend();
+    std::cout << "Audio backend: " << audio->name() << std::endl;
 
-    // Uninitialize COM library
-    CoUninitialize();
-}
+    audio_devices.clear();
+    for (const audio_device_info& device : audio->devices()) {
+        audio_devices.push_back(device.name);
+    }
 
-float controller_ui::get_current_device_volume(size_t index) {
-    // Initialize COM library
-    CoInitialize(nullptr);
-
-    IMMDeviceEnumerator* p_enumeator = nullptr;
-    HRESULT hr = CoCreateInstance(
-        __uuidof(MMDeviceEnumerator), NULL, CLSCTX_INPROC_SERVER,
-        __uuidof(IMMDeviceEnumerator), (void**)&p_enumeator);
-
-    float volume = 0.0f;  // Default volume level if no match is found
-    bool device_found = false;
-
-    if (SUCCEEDED(hr)) {
-        IMMDeviceCollection* p_collection = nullptr;
-        hr = p_enumeator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &p_collection);
-
-        if (SUCCEEDED(hr)) {
-            UINT count;
-            p_collection->GetCount(&count);
-
-            for (UINT i = 0; i < count; i++) {
-                IMMDevice* p_device = nullptr;
-                hr = p_collection->Item(i, &p_device);
-                if (SUCCEEDED(hr)) {
-                    IPropertyStore* p_store;
-                    hr = p_device->OpenPropertyStore(STGM_READ, &p_store);
-                    if (SUCCEEDED(hr)) {
-                        PROPVARIANT var_name;
-                        PropVariantInit(&var_name);
-                        hr = p_store->GetValue(PKEY_Device_FriendlyName, &var_name);
-
-                        // Check if this device matches the selected item
-                        if (SUCCEEDED(hr)) {
-                            std::wstring ws(var_name.pwszVal);
-                            std::string deviceName(ws.begin(), ws.end());
-                            if (deviceName == audio_devices[index]) {
-                                // Activate the IAudioEndpointVolume interface for the matched device
-                                IAudioEndpointVolume* pVolume = nullptr;
-                                hr = p_device->Activate(__uuidof(IAudioEndpointVolume), CLSCTX_ALL, NULL, (void**)&pVolume);
-                                if (SUCCEEDED(hr)) {
-                                    // Get the current volume level as a float between 0.0 and 1.0
-                                    hr = pVolume->GetMasterVolumeLevelScalar(&volume);
-                                    pVolume->Release();
-                                }
-                                device_found = true;  // Mark that we've found the device
-                            }
-                            PropVariantClear(&var_name);
-                        }
-                        p_store->Release();
-                    }
-                    p_device->Release();
-
-                    // Break the loop if the device was found and processed
-                    if (device_found) {
-                        break;
-                    }
-                }
-            }
-            p_collection->Release();
-        }
-        p_enumeator->Release();
+    // Slider and knob moves become ramps, the smoother decides when to
+    // actually write to the endpoint
+    smoother.reset(new volume_smoother(audio->device_count(), [this](size_t index, float volume) {
+        audio->set_volume(index, volume);
+    }));
+    for (size_t i = 0; i < audio->device_count(); i++) {
+        smoother->sync(i, audio->get_volume(i));
     }
+    audio->set_change_callback([this](const audio_change_event& e) {
+        smoother->sync(e.index, e.volume);
+    });
+
+    // Recalls write the endpoints directly, a ramp still running would
+    // overwrite them on its next tick
+    scenes.reset(new scene_manager(*audio, "controller_scenes.txt"));
+    scenes->set_endpoint_write_callback([this](size_t index, float volume) {
+        smoother->cancel(index, volume);
+    });
 
-    // Uninitialize COM library
-    CoUninitialize();
+    // Signal levels are sampled off the render thread, see audio_meter.hpp
+    std::unique_ptr<meter_source> meter = audio->create_meter_source();
+    if (meter) {
+        meters.reset(new meter_pipeline(std::move(meter), audio->device_count()));
+    }
+}
 
-    // Returns a float value between 0.0 and 1.0
-    return volume; 
+float controller_ui::get_current_device_volume(size_t index) {
+    // Cached by the backend and refreshed by its change notifications,
+    // so this is cheap enough to call every frame
+    return smoother->display_value(index, audio->get_volume(index));
 }
 
 void controller_ui::set_current_device_volume(size_t index, float volume) {
-    // Initialize COM library
-    CoInitialize(nullptr);
-
-    IMMDeviceEnumerator* p_enumeator = nullptr;
-    HRESULT hr = CoCreateInstance(
-        __uuidof(MMDeviceEnumerator), NULL, CLSCTX_INPROC_SERVER,
-        __uuidof(IMMDeviceEnumerator), (void**)&p_enumeator);
-
-    if (SUCCEEDED(hr)) {
-        IMMDeviceCollection* p_collection = nullptr;
-        hr = p_enumeator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &p_collection);
-
-        if (SUCCEEDED(hr)) {
-            UINT count;
-            p_collection->GetCount(&count);
-
-            for (UINT i = 0; i < count; i++) {
-                IMMDevice* p_device = nullptr;
-                hr = p_collection->Item(i, &p_device);
-                if (SUCCEEDED(hr)) {
-                    IPropertyStore* p_store;
-                    hr = p_device->OpenPropertyStore(STGM_READ, &p_store);
-                    if (SUCCEEDED(hr)) {
-                        PROPVARIANT var_name;
-                        PropVariantInit(&var_name);
-                        hr = p_store->GetValue(PKEY_Device_FriendlyName, &var_name);
-
-                        // Check if this device matches the selected item
-                        if (SUCCEEDED(hr)) {
-                            std::wstring ws(var_name.pwszVal);
-                            std::string deviceName(ws.begin(), ws.end());
-                            if (deviceName == audio_devices[index]) {
-                                // Activate the IAudioEndpointVolume interface for the matched device
-                                IAudioEndpointVolume* pVolume = nullptr;
-                                hr = p_device->Activate(__uuidof(IAudioEndpointVolume), CLSCTX_ALL, NULL, (void**)&pVolume);
-                                if (SUCCEEDED(hr)) {
-                                    // Set the volume level as a float between 0.0 and 1.0
-                                    hr = pVolume->SetMasterVolumeLevelScalar(volume, NULL);
-                                    pVolume->Release();
-                                }
-                            }
-                            PropVariantClear(&var_name);
-                        }
-                        p_store->Release();
-                    }
-                    p_device->Release();
-                }
-            }
-            p_collection->Release();
-        }
-        p_enumeator->Release();
-    }
+    smoother->set_target(index, volume, now_seconds());
+}
 
-    // Uninitialize COM library
-    CoUninitialize();
+void controller_ui::start_smoothing() {
+    smoothing_running = true;
+    smoothing_thread = std::thread([this]() {
+        // Ticks write to the endpoints from this thread
+        audio->begin_thread();
+        const std::chrono::duration<double> tick_interval(1.0 / smoother->config().tick_hz);
+        std::chrono::steady_clock::time_point next_tick = std::chrono::steady_clock::now();
+        while (smoothing_running.load()) {
+            smoother->tick(now_seconds());
+            next_tick += std::chrono::duration_cast<std::chrono::steady_clock::duration>(tick_interval);
+            std::this_thread::sleep_until(next_tick);
+        }
+        audio->end_thread();
+    });
 }
 
+void controller_ui::stop_smoothing() {
+    smoothing_running = false;
+    if (smoothing_thread.joinable()) {
+        smoothing_thread.join();
+    }
+}
  
 
 
@@ -265,18 +180,22 @@ void controller_ui::set_current_device_volume(size_t index, float volume) {
 // }
 
 void controller_ui::toggle_start_stop() {
+    if (!is_started && selected_com_port.empty()) {
+        std::cerr << "No serial port available." << std::endl;
+        return;
+    }
     is_started = !is_started;  // Toggle the state
 
     if (is_started) {
-        if (!serial_port.is_open() && open_serial_port(active_com_ports[selected_com_port].c_str())) {
-            std::cout << "Started: Serial port " << active_com_ports[selected_com_port].c_str() << " opened successfully." << std::endl;
+        if (!serial_port.is_open() && open_serial_port(selected_com_port.c_str())) {
+            std::cout << "Started: Serial port " << selected_com_port.c_str() << " opened successfully." << std::endl;
         } else {
-            std::cerr << "Failed to open serial port " << active_com_ports[selected_com_port].c_str() << std::endl;
+            std::cerr << "Failed to open serial port " << selected_com_port.c_str() << std::endl;
             is_started = false;  // Reset to stopped if open fails
         }
     } else {
         close_serial_port();
-        std::cout << "Stopped: Serial port " << active_com_ports[selected_com_port].c_str() << " closed." << std::endl;
+        std::cout << "Stopped: Serial port " << selected_com_port.c_str() << " closed." << std::endl;
     }
 }
 
@@ -289,7 +208,8 @@ bool controller_ui::open_serial_port(const std::string& port) {
         serial_port.set_option(boost::asio::serial_port_base::stop_bits(boost::asio::serial_port_base::stop_bits::one));
         serial_port.set_option(boost::asio::serial_port_base::flow_control(boost::asio::serial_port_base::flow_control::none));
 
-        // Start asynchronous read operation
+        // Start asynchronous read operation, dropping anything left from a previous session
+        read_buffer.consume(read_buffer.size());
         start_read();
 
         return true;
@@ -302,7 +222,6 @@ bool controller_ui::open_serial_port(const std::string& port) {
 void controller_ui::start_read() {
     // Start an asynchronous read, with `handle_read` as the completion handler
     std::cout << "Starting async read..." << std::endl;
-    read_buffer.consume(read_buffer.size());
     boost::asio::async_read_until(
         serial_port, read_buffer, '\n',  // Read until a newline character or adjust to your needs
         boost::bind(&controller_ui::handle_read, this,
@@ -320,12 +239,13 @@ void controller_ui::start_read() {
 void controller_ui::handle_read(const boost::system::error_code& error, std::size_t bytes_transferred) {
     std::cout << "Received: " << std::endl;
     if (!error) {
-        read_buffer.commit(bytes_transferred);
+        // async_read_until already committed the data to the input sequence
         std::istream is(&read_buffer);
         std::string data;
         std::getline(is, data);
 
         std::cout << "Received: " << data << std::endl;
+        handle_knob_message(data);
 
         // Start another async read operation
         start_read();
@@ -334,6 +254,37 @@ void controller_ui::handle_read(const boost::system::error_code& error, std::siz
     }
 }
 
+// Knob messages are "key:value" lines:
+//   vol:<0.0 .. 1.0>    Knob position for the selected device
+//   scene:<index>       Recall a scene (e.g. press and turn gesture)
+//   scene:next          Recall the scene after the current one (e.g. double press)
+void controller_ui::handle_knob_message(const std::string& message) {
+    size_t separator = message.find(':');
+    if (separator == std::string::npos) {
+        return;
+    }
+    const std::string key = message.substr(0, separator);
+    const char* value = message.c_str() + separator + 1;
+
+    if (key == "vol") {
+        char* end = nullptr;
+        float volume = std::strtof(value, &end);
+        if (end != value) {
+            set_current_device_volume(selected_device.load(), volume);
+        }
+    } else if (key == "scene") {
+        if (std::strcmp(value, "next") == 0) {
+            scenes->recall_next();
+        } else {
+            char* end = nullptr;
+            long index = std::strtol(value, &end, 10);
+            if (end != value && index >= 0) {
+                scenes->recall((size_t)index);
+            }
+        }
+    }
+}
+
 void controller_ui::close_serial_port() {
     if (serial_port.is_open()) {
         boost::system::error_code ec;
@@ -359,6 +310,11 @@ void controller_ui::start_io_context() {
 
 //--controller_ui Rendering-----------------------------------------------------
 void controller_ui::render() {
+    refresh_com_ports();
+    if (meters) {
+        meters->read(meter_levels, ImGui::GetIO().DeltaTime);
+    }
+
     ImGuiStyle& style = ImGui::GetStyle();
     style.FrameRounding = 6.0f;  // Adjust for rounded corners (increase for more rounding)
     style.GrabRounding = 4.0f;   // Rounding for grab handles (like sliders)
@@ -378,11 +334,13 @@ void controller_ui::render() {
     ImGui::Text("Active COM Port:");
     ImGui::SetCursorPosX(center_offset); 
     ImGui::SetNextItemWidth(custom_width-150);  // Set dropdown width
-    if (ImGui::BeginCombo("##COMPortCombo", active_com_ports[selected_com_port].c_str())) {  // Unique identifier for combo box
-        for (int i = 0; i < active_com_ports.size(); ++i) {
-            bool is_selected = (selected_com_port == i);
-            if (ImGui::Selectable(active_com_ports[i].c_str(), is_selected)) {
-                selected_com_port = i;
+    if (ImGui::BeginCombo("##COMPortCombo", selected_com_port.c_str())) {  // Unique identifier for combo box
+        for (const serial_port_entry& port : active_com_ports->ports) {
+            bool is_selected = (selected_com_port == port.path);
+            std::string label = port.description.empty() ? port.path : port.path + " - " + port.description;
+            if (ImGui::Selectable(label.c_str(), is_selected)) {
+                selected_com_port = port.path;
+                com_port_user_selected = true;
             }
             if (is_selected) {
                 ImGui::SetItemDefaultFocus();
@@ -411,13 +369,15 @@ void controller_ui::render() {
     ImGui::Text("Selected Device:");
     ImGui::SetCursorPosX(center_offset); 
     ImGui::SetNextItemWidth(custom_width);  // Set dropdown width
-    std::string combo_label = std::to_string(selected_device) + ": " + audio_devices[selected_device];
+    int device = selected_device.load();
+    std::string combo_label = audio_devices.empty() ? "" : std::to_string(device) + ": " + audio_devices[device];
     if (ImGui::BeginCombo("##DeviceCombo", combo_label.c_str())) {  // Unique identifier for combo box
         for (int i = 0; i < audio_devices.size(); ++i) {
             std::string label = std::to_string(i) + ": " + audio_devices[i];
-            bool is_selected = (selected_device == i);
+            bool is_selected = (device == i);
             if (ImGui::Selectable(label.c_str(), is_selected)) {
                 selected_device = i;
+                device = i;
             }
             if (is_selected) {
                 ImGui::SetItemDefaultFocus();
@@ -427,13 +387,17 @@ void controller_ui::render() {
     }
 
     // Get the current volume level of the selected device
-    progress = get_current_device_volume(selected_device);  // Update progress based on current volume
+    progress = get_current_device_volume(device);  // Update progress based on current volume
 
     // Display the volume level on the progress bar
     ImGui::SetCursorPosX(center_offset); 
     ImGui::Text("Volume Level:");
     ImGui::SetCursorPosX(center_offset); 
     ImGui::ProgressBar(progress, ImVec2(custom_width, 20.0f));  // Use custom width and taller height for progress bar
+    if (device < (int)meter_levels.size()) {
+        ImGui::SetCursorPosX(center_offset); 
+        draw_level_meter(meter_levels[device], ImVec2(custom_width, 6.0f), false);
+    }
 
     // Volume control slider
     ImGui::SetCursorPosX(center_offset); 
@@ -441,7 +405,7 @@ void controller_ui::render() {
     ImGui::SetCursorPosX(center_offset); 
     ImGui::SetNextItemWidth(custom_width);  // Set slider width
     if (ImGui::SliderFloat("##VolumeSlider", &progress, 0.0f, 1.0f)) {
-        set_current_device_volume(selected_device, progress);
+        set_current_device_volume(device, progress);
     }
 
 
@@ -464,13 +428,18 @@ void controller_ui::render() {
     }
     
     for (size_t i = 0; i < num_channels; ++i) {
+        ImGui::PushID((int)i);
         ImGui::BeginGroup();  // Group each channel’s controls together
 
         // Vertical slider to adjust volume
-        if(ImGui::VSliderFloat(("##ChannelSlider" + std::to_string(i)).c_str(), ImVec2(35, 220), &channel_volumes[i], 0.0f, 1.0f, ""))
+        if(ImGui::VSliderFloat("##ChannelSlider", ImVec2(35, 220), &channel_volumes[i], 0.0f, 1.0f, ""))
         {
             set_current_device_volume(i, channel_volumes[i]);
         }
+        if (i < meter_levels.size()) {
+            ImGui::SameLine(0.0f, 4.0f);
+            draw_level_meter(meter_levels[i], ImVec2(6.0f, 220.0f), true);
+        }
 
         // Display the index below the slider in bold
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 5);  // Add some spacing
@@ -485,6 +454,7 @@ void controller_ui::render() {
         ImGui::PopFont();
 
         ImGui::EndGroup();
+        ImGui::PopID();
 
         if (i < num_channels - 1)
         {
@@ -493,8 +463,53 @@ void controller_ui::render() {
     }
 
     ImGui::EndChild();
+
+    render_scenes(custom_width, center_offset);
+
     ImGui::End();
 
 }
 
+void controller_ui::render_scenes(float custom_width, float center_offset) {
+    ImGui::Separator();
+    ImGui::SetCursorPosX(center_offset); 
+    ImGui::Text("Scenes:");
+
+    // Capture the current endpoint and session volumes under a name
+    ImGui::SetCursorPosX(center_offset); 
+    ImGui::SetNextItemWidth(custom_width - 150);
+    ImGui::InputTextWithHint("##SceneName", "Scene name", scene_name, IM_ARRAYSIZE(scene_name));
+    ImGui::SameLine();
+    if (ImGui::Button("Save Scene", ImVec2(140.0f, 0.0f)) && scene_name[0] != 0) {
+        scenes->capture(scene_name);
+        scene_name[0] = 0;
+    }
 
+    // One button per scene, recalled asynchronously
+    std::vector<std::string> names = scenes->scene_names();
+    ImGui::SetCursorPosX(center_offset); 
+    ImGui::BeginDisabled(scenes->is_busy());
+    for (size_t i = 0; i < names.size(); i++) {
+        ImGui::PushID((int)i);
+        if (ImGui::Button(names[i].c_str())) {
+            scenes->recall(i);
+        }
+        if (ImGui::BeginPopupContextItem()) {
+            if (ImGui::MenuItem("Delete")) {
+                scenes->remove(i);
+            }
+            ImGui::EndPopup();
+        }
+        ImGui::PopID();
+        if (i + 1 < names.size()) {
+            ImGui::SameLine();
+        }
+    }
+    ImGui::EndDisabled();
+
+    scene_recall_report report = scenes->last_recall();
+    if (report.valid) {
+        ImGui::SetCursorPosX(center_offset); 
+        ImGui::TextDisabled("Recalled '%s': %d writes in %.2f ms", report.name.c_str(), (int)report.writes, report.milliseconds);
+    }
+}
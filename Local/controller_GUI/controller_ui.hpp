@@ -1,15 +1,16 @@
 #pragma once
-#include <WinSock2.h>
-#include <Windows.h>
 #include <boost/asio.hpp>
 #include <boost/bind/bind.hpp>
 #include "imgui.h"
+#include "audio_backend.hpp"
+#include "serial_discovery.hpp"
+#include "volume_smoother.hpp"
+#include "scene_manager.hpp"
+#include "audio_meter.hpp"
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
-#include <mmdeviceapi.h>
-#include <endpointvolume.h>
-#include <comdef.h>
-#include <functiondiscoverykeys_devpkey.h>
 #include <iostream>
 #include <thread>
 
@@ -23,23 +24,33 @@ public:
 
 
 private:
+    std::unique_ptr<audio_backend> audio;
+    std::unique_ptr<volume_smoother> smoother;
+    std::thread smoothing_thread;
+    std::atomic<bool> smoothing_running;
+    std::unique_ptr<scene_manager> scenes;
+    std::unique_ptr<meter_pipeline> meters;
+    std::vector<meter_display> meter_levels;
+    char scene_name[64];
     std::vector<std::string> audio_devices; 
-    int selected_device;       
-    std::vector<std::string> active_com_ports; 
-    int selected_com_port;
+    std::atomic<int> selected_device;   // Also read by handle_knob_message() on the io thread
+    serial_discovery com_port_discovery;
+    std::shared_ptr<const serial_port_snapshot> active_com_ports;
+    std::string selected_com_port;
+    bool com_port_user_selected;
     float progress;       
 
     bool is_started;   
-    boost::asio::io_service io_service;
-    boost::asio::serial_port serial_port{io_service};   
-    boost::asio::streambuf read_buffer;
     boost::asio::io_context io_context;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> io_work{boost::asio::make_work_guard(io_context)};
+    boost::asio::serial_port serial_port{io_context};   
+    boost::asio::streambuf read_buffer;
     std::thread io_thread;
 
 
     float get_current_device_volume(size_t index);
     void load_audio_devices();
-    void load_com_ports();
+    void refresh_com_ports();
     void set_current_device_volume(size_t index, float volume);
     void toggle_start_stop();
 
@@ -49,6 +60,10 @@ private:
     void start_read();
     void handle_read(const boost::system::error_code& error, std::size_t bytes_transferred);
     void start_io_context();
+    void start_smoothing();
+    void stop_smoothing();
+    void handle_knob_message(const std::string& message);
+    void render_scenes(float custom_width, float center_offset);
 
 
     void temp();
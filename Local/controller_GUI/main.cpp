@@ -18,6 +18,7 @@
 #include "imgui_impl_vulkan.h"
 #include <stdio.h>          // printf, fprintf
 #include <stdlib.h>         // abort
+#include <string.h>         // strcmp
 #define GLFW_INCLUDE_NONE
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
@@ -391,9 +392,33 @@ static void FramePresent(ImGui_ImplVulkanH_Window* wd)
     wd->SemaphoreIndex = (wd->SemaphoreIndex + 1) % wd->SemaphoreCount; // Now we can use the next set of semaphores
 }
 
+// Print the volume smoother's write rate and step size on a synthetic fast knob spin, see volume_smoother.hpp
+static int print_smoother_report()
+{
+    volume_smoother_config direct;
+    direct.ramp_time = 0.0f;
+    direct.tick_hz = 1000.0f;
+    direct.max_write_hz = 0.0f;
+    direct.min_step = 0.0f;
+    volume_smoother_config smoothed;
+    const volume_smoother_config* configs[2] = { &direct, &smoothed };
+    const char* names[2] = { "direct", "smoothed" };
+    for (int n = 0; n < 2; n++)
+    {
+        volume_smoother_trace_report report = volume_smoother_replay_fast_spin(*configs[n]);
+        printf("%-9s %4llu writes (%3.0f/s), %4llu skipped, max step %.3f, final error %.4f\n", names[n],
+            report.stats.writes, report.stats.writes / report.seconds, report.stats.skipped, report.stats.max_step, report.final_error);
+    }
+    return 0;
+}
+
 // Main code
-int main(int, char**)
+int main(int argc, char** argv)
 {
+    for (int n = 1; n < argc; n++)
+        if (strcmp(argv[n], "--smoother-report") == 0)
+            return print_smoother_report();
+
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit())
         return 1;
@@ -478,8 +503,16 @@ int main(int, char**)
     // - Read 'docs/FONTS.md' for more instructions and details.
     // - Remember that in C/C++ if you want to include a backslash \ in a string literal you need to write a double backslash \\ !
     //io.Fonts->AddFontDefault();
+#ifdef _WIN32
     io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ARLRDBD.ttf", 16.0f);
     io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ARLRDBD.ttf", 25.0f);
+#else
+    // controller_ui expects a regular and a large font
+    io.Fonts->AddFontDefault();
+    ImFontConfig large_font_cfg;
+    large_font_cfg.SizePixels = 25.0f;
+    io.Fonts->AddFontDefault(&large_font_cfg);
+#endif
     // io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\swromnt.ttf", 16.0f);
     //io.Fonts->AddFontFromFileTTF("../../misc/fonts/DroidSans.ttf", 16.0f);
     //io.Fonts->AddFontFromFileTTF("../../misc/fonts/Roboto-Medium.ttf", 16.0f);
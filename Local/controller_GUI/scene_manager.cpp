@@ -0,0 +1,223 @@
+#include "scene_manager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+//--Helper Functions-----------------------------------------------------------
+static std::vector<std::string> split_tabs(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, '\t')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+static int find_device(const audio_backend& audio, const std::string& device_id) {
+    for (size_t i = 0; i < audio.device_count(); i++) {
+        if (audio.devices()[i].id == device_id) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+//--scene_manager Implimentation---------------------------------------------------
+scene_manager::scene_manager(audio_backend& backend, const std::string& storage_path) : audio(backend), path(storage_path) {
+    load();
+    worker = std::thread([this]() { run(); });
+}
+
+scene_manager::~scene_manager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void scene_manager::set_endpoint_write_callback(endpoint_write_fn callback) {
+    std::lock_guard<std::mutex> lock(mutex);
+    on_endpoint_write = std::move(callback);
+}
+
+void scene_manager::capture(const std::string& name) {
+    audio_scene scene;
+    scene.name = name;
+    std::replace(scene.name.begin(), scene.name.end(), '\t', ' ');
+    for (size_t i = 0; i < audio.device_count(); i++) {
+        scene.endpoints.push_back(scene_endpoint{ audio.devices()[i].id, audio.get_volume(i), audio.get_mute(i) });
+    }
+    for (const audio_session_state& session : audio.capture_sessions()) {
+        scene.sessions.push_back(scene_session{ audio.devices()[session.device_index].id, session.id, session.name, session.volume, session.muted });
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    bool replaced = false;
+    for (audio_scene& existing : scenes) {
+        if (existing.name == scene.name) {
+            existing = scene;
+            replaced = true;
+        }
+    }
+    if (!replaced) {
+        scenes.push_back(scene);
+    }
+    save();
+}
+
+void scene_manager::remove(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index >= scenes.size()) {
+        return;
+    }
+    scenes.erase(scenes.begin() + index);
+    pending = -1;
+    current = -1;
+    save();
+}
+
+bool scene_manager::recall(size_t index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (index >= scenes.size()) {
+            return false;
+        }
+        pending = (int)index;
+    }
+    wake.notify_one();
+    return true;
+}
+
+bool scene_manager::recall_next() {
+    size_t next;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (scenes.empty()) {
+            return false;
+        }
+        int last = pending >= 0 ? pending : current;
+        next = (size_t)(last + 1) % scenes.size();
+    }
+    return recall(next);
+}
+
+std::vector<std::string> scene_manager::scene_names() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> names;
+    for (const audio_scene& scene : scenes) {
+        names.push_back(scene.name);
+    }
+    return names;
+}
+
+scene_recall_report scene_manager::last_recall() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return report;
+}
+
+bool scene_manager::is_busy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return applying || pending >= 0;
+}
+
+void scene_manager::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || pending >= 0; });
+        if (stopping) {
+            return;
+        }
+        audio_scene scene = scenes[pending];
+        endpoint_write_fn endpoint_write = on_endpoint_write;
+        current = pending;
+        pending = -1;
+        applying = true;
+        lock.unlock();
+
+        // Resolve the stored ids against the current endpoints, devices that are
+        // gone are skipped
+        std::vector<audio_write> writes;
+        for (const scene_endpoint& endpoint : scene.endpoints) {
+            int index = find_device(audio, endpoint.device_id);
+            if (index >= 0) {
+                writes.push_back(audio_write{ false, (size_t)index, std::string(), endpoint.volume, endpoint.muted });
+            }
+        }
+        for (const scene_session& session : scene.sessions) {
+            int index = find_device(audio, session.device_id);
+            if (index >= 0) {
+                writes.push_back(audio_write{ true, (size_t)index, session.session_id, session.volume, session.muted });
+            }
+        }
+
+        if (endpoint_write) {
+            for (const audio_write& w : writes) {
+                if (!w.is_session) {
+                    endpoint_write(w.device_index, w.volume);
+                }
+            }
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        audio.apply_batch(writes);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Scene '" << scene.name << "' applied " << writes.size() << " writes in " << elapsed.count() << " ms" << std::endl;
+
+        lock.lock();
+        applying = false;
+        report.name = scene.name;
+        report.writes = writes.size();
+        report.milliseconds = elapsed.count();
+        report.valid = true;
+    }
+}
+
+// Format, one record per line, fields separated by tabs:
+//   scene     <name>
+//   endpoint  <volume> <muted> <device id>
+//   session   <volume> <muted> <device id> <session id> <name>
+void scene_manager::load() {
+    std::ifstream file(path);
+    if (!file) {
+        return;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields = split_tabs(line);
+        if (fields.size() == 2 && fields[0] == "scene") {
+            audio_scene scene;
+            scene.name = fields[1];
+            scenes.push_back(scene);
+        } else if (fields.size() == 4 && fields[0] == "endpoint" && !scenes.empty()) {
+            scenes.back().endpoints.push_back(scene_endpoint{ fields[3], std::strtof(fields[1].c_str(), nullptr), fields[2] == "1" });
+        } else if (fields.size() == 6 && fields[0] == "session" && !scenes.empty()) {
+            scenes.back().sessions.push_back(scene_session{ fields[3], fields[4], fields[5], std::strtof(fields[1].c_str(), nullptr), fields[2] == "1" });
+        }
+    }
+}
+
+// Must be called with the mutex held
+void scene_manager::save() const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to save scenes to " << path << std::endl;
+        return;
+    }
+    for (const audio_scene& scene : scenes) {
+        file << "scene\t" << scene.name << "\n";
+        for (const scene_endpoint& endpoint : scene.endpoints) {
+            file << "endpoint\t" << endpoint.volume << "\t" << (endpoint.muted ? 1 : 0) << "\t" << endpoint.device_id << "\n";
+        }
+        for (const scene_session& session : scene.sessions) {
+            file << "session\t" << session.volume << "\t" << (session.muted ? 1 : 0) << "\t" << session.device_id << "\t" << session.session_id << "\t" << session.name << "\n";
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "audio_backend.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Named snapshots of every endpoint and session volume/mute ("Meeting",
+// "Music", "Gaming", ...).
+//
+// Recalling a scene turns it into a single audio_backend::apply_batch() call
+// issued from a worker thread, so the UI never waits on the audio stack.
+// Only the most recent recall request is kept when several arrive while a
+// batch is still being applied (e.g. spinning through scenes on the knob).
+//
+// Scenes are stored as tab separated text in storage_path, which is relative
+// to the working directory unless absolute.
+
+struct scene_endpoint {
+    std::string device_id;
+    float volume;
+    bool muted;
+};
+
+struct scene_session {
+    std::string device_id;
+    std::string session_id;
+    std::string name;
+    float volume;
+    bool muted;
+};
+
+struct audio_scene {
+    std::string name;
+    std::vector<scene_endpoint> endpoints;
+    std::vector<scene_session> sessions;
+};
+
+struct scene_recall_report {
+    std::string name;
+    size_t writes = 0;
+    double milliseconds = 0.0;  // From the start of the batch until the backend accepted every write
+    bool valid = false;
+};
+
+class scene_manager {
+public:
+    using endpoint_write_fn = std::function<void(size_t device_index, float volume)>;
+
+    scene_manager(audio_backend& backend, const std::string& storage_path);
+    ~scene_manager();
+
+    // Called from the worker thread for every endpoint a recall is about to
+    // write, before the batch is applied (e.g. to cancel volume ramps).
+    void set_endpoint_write_callback(endpoint_write_fn callback);
+
+    // Replaces the scene with the same name, if any.
+    void capture(const std::string& name);
+    void remove(size_t index);
+    bool recall(size_t index);
+    bool recall_next();
+
+    std::vector<std::string> scene_names() const;
+    scene_recall_report last_recall() const;
+    bool is_busy() const;
+
+private:
+    void run();
+    void load();
+    void save() const;
+
+    audio_backend& audio;
+    std::string path;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<audio_scene> scenes;
+    int pending = -1;           // Scene index waiting for the worker
+    int current = -1;           // Last scene recalled
+    bool applying = false;
+    bool stopping = false;
+    scene_recall_report report;
+    endpoint_write_fn on_endpoint_write;
+    std::thread worker;
+};
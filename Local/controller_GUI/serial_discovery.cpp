@@ -0,0 +1,348 @@
+#include "serial_discovery.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fstream>
+#endif
+
+//--Known Knobs------------------------------------------------------------------
+const serial_usb_id known_knob_ids[] = {
+    { 0x303A, 0x1001, "ESP32-S3 USB CDC" },
+    { 0x0483, 0x5740, "STM32 Virtual COM Port" },
+};
+const size_t known_knob_ids_count = sizeof(known_knob_ids) / sizeof(known_knob_ids[0]);
+
+//--serial_port_entry / serial_port_snapshot---------------------------------------
+bool serial_port_entry::operator==(const serial_port_entry& other) const {
+    return path == other.path && description == other.description && vid == other.vid && pid == other.pid && has_usb_ids == other.has_usb_ids;
+}
+
+int serial_port_snapshot::find_knob() const {
+    for (size_t i = 0; i < ports.size(); i++) {
+        if (!ports[i].has_usb_ids) {
+            continue;
+        }
+        for (size_t k = 0; k < known_knob_ids_count; k++) {
+            if (ports[i].vid == known_knob_ids[k].vid && ports[i].pid == known_knob_ids[k].pid) {
+                return (int)i;
+            }
+        }
+    }
+    return -1;
+}
+
+int serial_port_snapshot::find(const std::string& path) const {
+    for (size_t i = 0; i < ports.size(); i++) {
+        if (ports[i].path == path) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+//--Enumeration--------------------------------------------------------------------
+#ifdef _WIN32
+
+static bool read_registry_string(HKEY h_key, const char* value_name, std::string& out) {
+    char buffer[256];
+    DWORD type = 0;
+    DWORD size = sizeof(buffer) - 1;
+    if (RegQueryValueExA(h_key, value_name, NULL, &type, (LPBYTE)buffer, &size) != ERROR_SUCCESS || type != REG_SZ) {
+        return false;
+    }
+    buffer[size] = 0;
+    out = buffer;
+    return true;
+}
+
+// Fills VID/PID and friendly name of ports created by USB devices. Windows only
+// records them under the device instance, keyed by the assigned port name.
+static void lookup_usb_ids(std::vector<serial_port_entry>& ports) {
+    HKEY h_usb;
+    if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, "SYSTEM\\CurrentControlSet\\Enum\\USB", 0, KEY_READ, &h_usb) != ERROR_SUCCESS) {
+        return;
+    }
+
+    char device_key[256];
+    for (DWORD device_index = 0; ; device_index++) {
+        DWORD device_key_size = sizeof(device_key);
+        if (RegEnumKeyExA(h_usb, device_index, device_key, &device_key_size, NULL, NULL, NULL, NULL) != ERROR_SUCCESS) {
+            break;
+        }
+        unsigned int vid = 0, pid = 0;
+        if (sscanf(device_key, "VID_%4x&PID_%4x", &vid, &pid) != 2) {
+            continue;
+        }
+
+        HKEY h_device;
+        if (RegOpenKeyExA(h_usb, device_key, 0, KEY_READ, &h_device) != ERROR_SUCCESS) {
+            continue;
+        }
+        char instance_key[256];
+        for (DWORD instance_index = 0; ; instance_index++) {
+            DWORD instance_key_size = sizeof(instance_key);
+            if (RegEnumKeyExA(h_device, instance_index, instance_key, &instance_key_size, NULL, NULL, NULL, NULL) != ERROR_SUCCESS) {
+                break;
+            }
+            HKEY h_instance;
+            if (RegOpenKeyExA(h_device, instance_key, 0, KEY_READ, &h_instance) != ERROR_SUCCESS) {
+                continue;
+            }
+            HKEY h_params;
+            std::string port_name;
+            if (RegOpenKeyExA(h_instance, "Device Parameters", 0, KEY_READ, &h_params) == ERROR_SUCCESS) {
+                read_registry_string(h_params, "PortName", port_name);
+                RegCloseKey(h_params);
+            }
+            for (serial_port_entry& port : ports) {
+                if (!port_name.empty() && port.path == port_name) {
+                    port.vid = (uint16_t)vid;
+                    port.pid = (uint16_t)pid;
+                    port.has_usb_ids = true;
+                    read_registry_string(h_instance, "FriendlyName", port.description);
+                }
+            }
+            RegCloseKey(h_instance);
+        }
+        RegCloseKey(h_device);
+    }
+    RegCloseKey(h_usb);
+}
+
+std::vector<serial_port_entry> serial_discovery::enumerate() {
+    std::vector<serial_port_entry> ports;
+
+    // Open the registry key where COM port information is stored
+    HKEY h_key;
+    if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, "HARDWARE\\DEVICEMAP\\SERIALCOMM", 0, KEY_READ, &h_key) == ERROR_SUCCESS) {
+        char port_name[256];
+        char com_port[256];
+        for (DWORD index = 0; ; index++) {
+            DWORD port_name_size = sizeof(port_name);
+            DWORD com_port_size = sizeof(com_port) - 1;
+            DWORD type = 0;
+            if (RegEnumValueA(h_key, index, port_name, &port_name_size, NULL, &type, (LPBYTE)com_port, &com_port_size) != ERROR_SUCCESS) {
+                break;
+            }
+            if (type != REG_SZ) {
+                continue;
+            }
+            com_port[com_port_size] = 0;
+            serial_port_entry entry;
+            entry.path = com_port;
+            ports.push_back(entry);
+        }
+        RegCloseKey(h_key);
+    }
+
+    lookup_usb_ids(ports);
+    std::sort(ports.begin(), ports.end(), [](const serial_port_entry& a, const serial_port_entry& b) { return a.path < b.path; });
+    return ports;
+}
+
+#else
+
+static bool read_sysfs_line(const std::string& path, std::string& out) {
+    std::ifstream file(path);
+    if (!file || !std::getline(file, out)) {
+        return false;
+    }
+    return true;
+}
+
+static bool read_sysfs_hex(const std::string& path, uint16_t& out) {
+    std::string text;
+    if (!read_sysfs_line(path, text)) {
+        return false;
+    }
+    out = (uint16_t)strtoul(text.c_str(), nullptr, 16);
+    return true;
+}
+
+static std::string resolve_path(const std::string& path) {
+    char resolved[PATH_MAX];
+    if (realpath(path.c_str(), resolved) == nullptr) {
+        return std::string();
+    }
+    return resolved;
+}
+
+std::vector<serial_port_entry> serial_discovery::enumerate() {
+    std::vector<serial_port_entry> ports;
+
+    DIR* dir = opendir("/sys/class/tty");
+    if (dir == nullptr) {
+        return ports;
+    }
+    while (dirent* ent = readdir(dir)) {
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+        // Virtual terminals and ptys have no backing device
+        const std::string class_dir = std::string("/sys/class/tty/") + ent->d_name;
+        const std::string device_dir = resolve_path(class_dir + "/device");
+        if (device_dir.empty()) {
+            continue;
+        }
+        // Legacy 8250 UARTs are always registered whether or not hardware is present
+        const std::string subsystem = resolve_path(device_dir + "/subsystem");
+        if (subsystem.size() >= 9 && subsystem.compare(subsystem.size() - 9, 9, "/platform") == 0) {
+            continue;
+        }
+
+        serial_port_entry entry;
+        entry.path = std::string("/dev/") + ent->d_name;
+
+        // Walk up to the USB device that owns the interface
+        for (std::string dir_path = device_dir; dir_path.size() > 12; dir_path = dir_path.substr(0, dir_path.rfind('/'))) {
+            if (read_sysfs_hex(dir_path + "/idVendor", entry.vid) && read_sysfs_hex(dir_path + "/idProduct", entry.pid)) {
+                entry.has_usb_ids = true;
+                std::string manufacturer, product;
+                read_sysfs_line(dir_path + "/manufacturer", manufacturer);
+                read_sysfs_line(dir_path + "/product", product);
+                entry.description = manufacturer.empty() ? product : manufacturer + " " + product;
+                break;
+            }
+        }
+        ports.push_back(entry);
+    }
+    closedir(dir);
+
+    std::sort(ports.begin(), ports.end(), [](const serial_port_entry& a, const serial_port_entry& b) { return a.path < b.path; });
+    return ports;
+}
+
+#endif
+
+//--serial_discovery Implimentation------------------------------------------------
+serial_discovery::serial_discovery() : current_generation(0), stopping(false) {
+    // First snapshot is built synchronously so the UI has ports right away
+    publish(enumerate());
+
+#ifdef _WIN32
+    stop_event = CreateEventA(NULL, TRUE, FALSE, NULL);
+#else
+    if (pipe(wake_pipe) != 0) {
+        wake_pipe[0] = wake_pipe[1] = -1;
+    }
+#endif
+    watcher = std::thread([this]() { run(); });
+}
+
+serial_discovery::~serial_discovery() {
+    stopping.store(true);
+#ifdef _WIN32
+    SetEvent((HANDLE)stop_event);
+#else
+    if (wake_pipe[1] >= 0) {
+        char c = 0;
+        (void)!write(wake_pipe[1], &c, 1);
+    }
+#endif
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+#ifdef _WIN32
+    CloseHandle((HANDLE)stop_event);
+#else
+    if (wake_pipe[0] >= 0) {
+        close(wake_pipe[0]);
+        close(wake_pipe[1]);
+    }
+#endif
+}
+
+std::shared_ptr<const serial_port_snapshot> serial_discovery::snapshot() const {
+    return std::atomic_load(&current);
+}
+
+void serial_discovery::publish(std::vector<serial_port_entry> ports) {
+    std::shared_ptr<const serial_port_snapshot> previous = std::atomic_load(&current);
+    if (previous && previous->ports == ports) {
+        return;
+    }
+    std::shared_ptr<serial_port_snapshot> next = std::make_shared<serial_port_snapshot>();
+    next->generation = current_generation.load(std::memory_order_relaxed) + 1;
+    next->ports = std::move(ports);
+    std::atomic_store(&current, std::shared_ptr<const serial_port_snapshot>(next));
+    current_generation.store(next->generation, std::memory_order_release);
+}
+
+#ifdef _WIN32
+
+void serial_discovery::run() {
+    HKEY h_key;
+    if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, "HARDWARE\\DEVICEMAP\\SERIALCOMM", 0, KEY_NOTIFY | KEY_READ, &h_key) != ERROR_SUCCESS) {
+        std::cerr << "Serial discovery: cannot watch SERIALCOMM, port list will not refresh." << std::endl;
+        return;
+    }
+    HANDLE change_event = CreateEventA(NULL, FALSE, FALSE, NULL);
+    HANDLE handles[2] = { change_event, (HANDLE)stop_event };
+    while (!stopping.load()) {
+        if (RegNotifyChangeKeyValue(h_key, FALSE, REG_NOTIFY_CHANGE_NAME | REG_NOTIFY_CHANGE_LAST_SET, change_event, TRUE) != ERROR_SUCCESS) {
+            break;
+        }
+        if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) != WAIT_OBJECT_0) {
+            break;
+        }
+        publish(enumerate());
+    }
+    CloseHandle(change_event);
+    RegCloseKey(h_key);
+}
+
+#else
+
+void serial_discovery::run() {
+    // Device nodes appear and disappear in /dev when udev processes a hotplug.
+    // Without inotify fall back to a slow periodic rescan. inotify waits
+    // without a timeout, so it also needs the wake pipe to be stopped.
+    int notify_fd = (wake_pipe[0] >= 0) ? inotify_init1(IN_NONBLOCK | IN_CLOEXEC) : -1;
+    if (notify_fd >= 0 && inotify_add_watch(notify_fd, "/dev", IN_CREATE | IN_DELETE) < 0) {
+        close(notify_fd);
+        notify_fd = -1;
+    }
+    const int rescan_interval_ms = 2000;
+    const int settle_time_ms = 250;
+
+    while (!stopping.load()) {
+        pollfd fds[2] = {
+            { wake_pipe[0], POLLIN, 0 },
+            { notify_fd, POLLIN, 0 },
+        };
+        int ready = poll(fds, notify_fd >= 0 ? 2 : 1, notify_fd >= 0 ? -1 : rescan_interval_ms);
+        if (stopping.load()) {
+            break;
+        }
+        if (ready > 0 && (fds[1].revents & POLLIN)) {
+            char buffer[4096];
+            while (read(notify_fd, buffer, sizeof(buffer)) > 0) {
+            }
+            // Give udev time to finish the sysfs attributes and permissions,
+            // coalescing bursts of events into a single rescan
+            poll(fds, 1, settle_time_ms);
+            if (stopping.load()) {
+                break;
+            }
+            while (read(notify_fd, buffer, sizeof(buffer)) > 0) {
+            }
+        }
+        publish(enumerate());
+    }
+    if (notify_fd >= 0) {
+        close(notify_fd);
+    }
+}
+
+#endif
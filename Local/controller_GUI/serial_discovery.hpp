@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Background serial port discovery.
+//
+// Ports are enumerated from /sys/class/tty on Linux (with the USB VID/PID of
+// the parent device) and from HARDWARE\DEVICEMAP\SERIALCOMM on Windows (with
+// the VID/PID looked up under Enum\USB). A watcher thread re-enumerates when
+// the OS reports a change (inotify on /dev, RegNotifyChangeKeyValue on
+// Windows) and publishes a new immutable snapshot.
+//
+// Readers poll generation() once per frame, which is a single atomic load,
+// and only fetch the snapshot when it changed. A snapshot is never modified
+// after it has been published, so it can be read without any locking.
+
+struct serial_port_entry {
+    std::string path;           // "/dev/ttyACM0", "COM3"
+    std::string description;    // USB product string / friendly name, may be empty
+    uint16_t vid = 0;
+    uint16_t pid = 0;
+    bool has_usb_ids = false;
+
+    bool operator==(const serial_port_entry& other) const;
+};
+
+struct serial_port_snapshot {
+    uint64_t generation = 0;
+    std::vector<serial_port_entry> ports;
+
+    // Index of the first port whose VID/PID belongs to a known knob, or -1.
+    int find_knob() const;
+    int find(const std::string& path) const;
+};
+
+struct serial_usb_id {
+    uint16_t vid;
+    uint16_t pid;
+    const char* name;
+};
+
+// USB ids the knob firmware may enumerate with.
+extern const serial_usb_id known_knob_ids[];
+extern const size_t known_knob_ids_count;
+
+class serial_discovery {
+public:
+    serial_discovery();
+    ~serial_discovery();
+
+    uint64_t generation() const { return current_generation.load(std::memory_order_acquire); }
+    std::shared_ptr<const serial_port_snapshot> snapshot() const;
+
+    // Blocking enumeration, used by the watcher thread.
+    static std::vector<serial_port_entry> enumerate();
+
+private:
+    void run();
+    void publish(std::vector<serial_port_entry> ports);
+
+    std::shared_ptr<const serial_port_snapshot> current;    // Only accessed through std::atomic_load/atomic_store
+    std::atomic<uint64_t> current_generation;
+    std::atomic<bool> stopping;
+    std::thread watcher;
+#ifdef _WIN32
+    void* stop_event = nullptr;
+#else
+    int wake_pipe[2] = { -1, -1 };
+#endif
+};
@@ -0,0 +1,166 @@
+#include "volume_smoother.hpp"
+#include <algorithm>
+#include <cmath>
+
+//--volume_smoother Implimentation------------------------------------------------
+volume_smoother::volume_smoother(size_t channel_count, write_fn write_function, const volume_smoother_config& config)
+    : cfg(config), write(std::move(write_function)), channels(channel_count) {
+}
+
+float volume_smoother::ramp_value(const channel& ch, double now) const {
+    if (cfg.ramp_time <= 0.0f) {
+        return ch.target;
+    }
+    double t = (now - ch.start_time) / cfg.ramp_time;
+    if (t >= 1.0) {
+        return ch.target;
+    }
+    if (t <= 0.0) {
+        return ch.start;
+    }
+    return ch.start + (ch.target - ch.start) * (float)t;
+}
+
+void volume_smoother::set_target(size_t index, float target, double now) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index >= channels.size()) {
+        return;
+    }
+    channel& ch = channels[index];
+    target = std::min(std::max(target, 0.0f), 1.0f);
+    if (ch.active && ch.target == target) {
+        return;
+    }
+    if (!ch.active && ch.written == target) {
+        return;
+    }
+
+    // Restart from the current ramp position so direction changes stay continuous
+    ch.start = ch.active ? ramp_value(ch, now) : ch.written;
+    ch.target = target;
+    ch.start_time = now;
+    ch.active = true;
+}
+
+void volume_smoother::sync(size_t index, float volume) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index >= channels.size()) {
+        return;
+    }
+    channel& ch = channels[index];
+    if (ch.active) {
+        return;
+    }
+    ch.written = volume;
+    ch.target = volume;
+}
+
+void volume_smoother::cancel(size_t index, float volume) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index >= channels.size()) {
+        return;
+    }
+    channel& ch = channels[index];
+    ch.active = false;
+    ch.written = volume;
+    ch.target = volume;
+}
+
+float volume_smoother::display_value(size_t index, float endpoint_value) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index >= channels.size() || !channels[index].active) {
+        return endpoint_value;
+    }
+    return channels[index].target;
+}
+
+void volume_smoother::tick(double now) {
+    const double min_write_interval = cfg.max_write_hz > 0.0f ? 1.0 / cfg.max_write_hz : 0.0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_writes.clear();
+        for (size_t i = 0; i < channels.size(); i++) {
+            channel& ch = channels[i];
+            if (!ch.active) {
+                continue;
+            }
+
+            const bool done = (now - ch.start_time) >= cfg.ramp_time;
+            const float value = done ? ch.target : ramp_value(ch, now);
+            const bool rate_ok = ch.last_write_time < 0.0 || (now - ch.last_write_time) >= min_write_interval;
+
+            if (value == ch.written) {
+                ch.active = !done;
+                continue;
+            }
+            // The last write of a ramp ignores the step threshold so the endpoint lands on target
+            if (!rate_ok || (!done && std::fabs(value - ch.written) < cfg.min_step)) {
+                counters.skipped++;
+                continue;
+            }
+
+            counters.writes++;
+            counters.max_step = std::max(counters.max_step, std::fabs(value - ch.written));
+            ch.written = value;
+            ch.last_write_time = now;
+            ch.active = !done;
+            pending_writes.push_back(std::make_pair(i, value));
+        }
+    }
+
+    // Endpoint writes can block on the audio stack, keep them out of the lock
+    for (const std::pair<size_t, float>& w : pending_writes) {
+        write(w.first, w.second);
+    }
+}
+
+volume_smoother_stats volume_smoother::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+void volume_smoother::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters = volume_smoother_stats();
+}
+
+//--Fast Spin Trace--------------------------------------------------------------
+volume_smoother_trace_report volume_smoother_replay_fast_spin(const volume_smoother_config& config) {
+    const double report_interval = 1.0 / 250.0;
+    const double tick_interval = 1.0 / config.tick_hz;
+    const double sweep_period = 0.4;
+    const double sweep_time = 2.0;
+    const double settle_time = 0.5;
+    const float final_position = 0.37f;
+
+    float written = 0.0f;
+    volume_smoother smoother(1, [&written](size_t, float volume) { written = volume; }, config);
+
+    // Start from silence with the counters cleared
+    smoother.sync(0, 0.0f);
+    smoother.reset_stats();
+
+    volume_smoother_trace_report report;
+    report.seconds = sweep_time + settle_time;
+    double next_report = 0.0;
+    double next_tick = 0.0;
+    while (next_report <= report.seconds || next_tick <= report.seconds) {
+        if (next_report <= next_tick) {
+            const double now = next_report;
+            float position = final_position;
+            if (now < sweep_time) {
+                const double phase = std::fmod(now, sweep_period) / sweep_period;
+                position = (float)(phase < 0.5 ? phase * 2.0 : 2.0 - phase * 2.0);
+            }
+            smoother.set_target(0, position, now);
+            next_report += report_interval;
+        } else {
+            smoother.tick(next_tick);
+            next_tick += tick_interval;
+        }
+    }
+    report.stats = smoother.stats();
+    report.final_error = std::fabs(written - final_position);
+    return report;
+}
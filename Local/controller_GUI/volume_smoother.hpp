@@ -0,0 +1,90 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Turns volume targets from the slider or the knob into short time based
+// ramps, evaluated on a fixed tick.
+//
+// Each channel only writes to the endpoint when
+// - at least 1 / max_write_hz seconds passed since its previous write, and
+// - the ramp moved by at least min_step since the last written value.
+// The final value of a ramp is always written exactly, so fast spins collapse
+// into a handful of writes without leaving the endpoint off target.
+//
+// set_target()/sync() may be called from any thread. tick() calls the write
+// function with the internal lock released, from the thread that ticks.
+
+struct volume_smoother_config {
+    float ramp_time = 0.060f;       // Seconds to reach a new target
+    float tick_hz = 200.0f;         // Rate the owner should call tick() at
+    float max_write_hz = 60.0f;     // Per channel endpoint write cap
+    float min_step = 0.004f;        // Intermediate moves below this are not written (~ -48 dB, below audible steps)
+};
+
+struct volume_smoother_stats {
+    unsigned long long writes = 0;          // Endpoint writes issued
+    unsigned long long skipped = 0;         // Ticks where a move was below min_step or rate limited
+    float max_step = 0.0f;                  // Largest difference between two consecutive writes
+};
+
+class volume_smoother {
+public:
+    using write_fn = std::function<void(size_t channel, float volume)>;
+
+    volume_smoother(size_t channel_count, write_fn write, const volume_smoother_config& config = volume_smoother_config());
+
+    const volume_smoother_config& config() const { return cfg; }
+
+    // Starts a ramp from wherever the channel currently is.
+    void set_target(size_t channel, float target, double now);
+
+    // Endpoint changed outside of the smoother (other application, initial
+    // state). Ignored while a ramp is running on that channel.
+    void sync(size_t channel, float volume);
+
+    // Endpoint is about to be written outside of the smoother on purpose
+    // (scene recall): stops any ramp on that channel and takes volume as the
+    // written value, so the next tick doesn't overwrite it.
+    void cancel(size_t channel, float volume);
+
+    // Value the UI should display: the pending target while ramping.
+    float display_value(size_t channel, float endpoint_value) const;
+
+    void tick(double now);
+
+    volume_smoother_stats stats() const;
+    void reset_stats();
+
+private:
+    struct channel {
+        float start = 0.0f;
+        float target = 0.0f;
+        double start_time = 0.0;
+        float written = 0.0f;
+        double last_write_time = -1.0;
+        bool active = false;
+    };
+
+    float ramp_value(const channel& ch, double now) const;
+
+    volume_smoother_config cfg;
+    write_fn write;
+    mutable std::mutex mutex;
+    std::vector<channel> channels;
+    volume_smoother_stats counters;
+    std::vector<std::pair<size_t, float>> pending_writes;  // Reused by tick()
+};
+
+// Synthetic fast knob spin on one channel, replayed in simulated time: 250 Hz
+// knob reports sweeping 0..1 and back every 0.4 s for 2 s, then settling at
+// 0.37. Ticks run at config.tick_hz. Printed by "--smoother-report", once with
+// the default config and once with a pass-through config (no ramp, no rate
+// cap, no step threshold) which writes every knob report as it arrives.
+struct volume_smoother_trace_report {
+    volume_smoother_stats stats;
+    double seconds = 0.0;           // Duration of the trace
+    float final_error = 0.0f;       // Distance between the last written value and the final knob position
+};
+
+volume_smoother_trace_report volume_smoother_replay_fast_spin(const volume_smoother_config& config);
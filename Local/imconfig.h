@@ -35,6 +35,8 @@
 //#define IMGUI_DISABLE                                     // Disable everything: all headers and source files will be empty.
 //#define IMGUI_DISABLE_DEMO_WINDOWS                        // Disable demo windows: ShowDemoWindow()/ShowStyleEditor() will be empty.
 //#define IMGUI_DISABLE_DEBUG_TOOLS                         // Disable metrics/debugger and other debug tools: ShowMetricsWindow(), ShowDebugLogWindow() and ShowIDStackToolWindow() will be empty.
+//#define IMGUI_DISABLE_PROFILER                            // Disable profiler zones in NewFrame()/EndFrame()/Render()/Begin()/End() (recording is off by default; see Metrics/Debugger->Profiler). Implied by IMGUI_DISABLE_DEBUG_TOOLS.
+//#define IMGUI_ENABLE_ALLOC_TAGS                           // Track allocations per subsystem (draw lists, windows, tables, fonts...): live bytes, peak and per-frame churn, shown in Metrics/Debugger->Memory allocations. Adds a 16 bytes header to every allocation.
 
 //---- Don't implement some functions to reduce linkage requirements.
 //#define IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS   // [Win32] Don't implement default clipboard handler. Won't use and link with OpenClipboard/GetClipboardData/CloseClipboard etc. (user32.lib/.a, kernel32.lib/.a)
@@ -49,6 +51,7 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_USE_CRC32C_HASH                             // Use CRC32C instead of CRC32 for ImHashData()/ImHashStr(): hardware accelerated when compiled with SSE 4.2 or ARMv8 CRC, table based otherwise. All IDs change, including the ones stored in .ini files.
 
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
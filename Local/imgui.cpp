@@ -93,6 +93,7 @@ CODE
 // [SECTION] VIEWPORTS, PLATFORM WINDOWS
 // [SECTION] DOCKING
 // [SECTION] PLATFORM DEPENDENT HELPERS
+// [SECTION] PROFILER
 // [SECTION] METRICS/DEBUGGER WINDOW
 // [SECTION] DEBUG LOG WINDOW
 // [SECTION] OTHER DEBUG TOOLS (ITEM PICKER, ID STACK TOOL)
@@ -1080,6 +1081,17 @@ CODE
 // System includes
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#ifdef IMGUI_ENABLE_PROFILER
+#include <time.h>       // clock_gettime, clock (profiler)
+#if defined(IMGUI_ENABLE_SSE) && !defined(__EMSCRIPTEN__)
+#define IMGUI_PROFILER_USE_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>     // __rdtsc
+#else
+#include <x86intrin.h>  // __rdtsc
+#endif
+#endif
+#endif
 
 // [Windows] On non-Visual Studio compilers, we default to IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS unless explicitly enabled
 #if defined(_WIN32) && !defined(_MSC_VER) && !defined(IMGUI_ENABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
@@ -1472,6 +1484,9 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsCopyContentsWithCtrlC = false;
     ConfigScrollbarScrollByPage = true;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigDrawListsDeferText = false;
+    ConfigDrawListsShapeCache = false;
+    ConfigDrawListsTextLayoutCache = false;
     ConfigDebugIsDebuggerPresent = false;
     ConfigDebugHighlightIdConflicts = true;
     ConfigDebugBeginReturnValueOnce = false;
@@ -2230,50 +2245,113 @@ static const ImU32 GCrc32LookupTable[256] =
     0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
 };
 
-// Known size hash
-// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+#ifdef IMGUI_USE_CRC32C_HASH
+// CRC32C uses the Castagnoli polynomial (0x82F63B78 reflected), which is the one implemented by the SSE 4.2 and ARMv8 CRC32 instructions.
+// The table is only used when those instructions are not enabled at compile-time, and produces the same values.
+static const ImU32 GCrc32cLookupTable[256] =
+{
+    0x00000000,0xF26B8303,0xE13B70F7,0x1350F3F4,0xC79A971F,0x35F1141C,0x26A1E7E8,0xD4CA64EB,0x8AD958CF,0x78B2DBCC,0x6BE22838,0x9989AB3B,0x4D43CFD0,0xBF284CD3,0xAC78BF27,0x5E133C24,
+    0x105EC76F,0xE235446C,0xF165B798,0x030E349B,0xD7C45070,0x25AFD373,0x36FF2087,0xC494A384,0x9A879FA0,0x68EC1CA3,0x7BBCEF57,0x89D76C54,0x5D1D08BF,0xAF768BBC,0xBC267848,0x4E4DFB4B,
+    0x20BD8EDE,0xD2D60DDD,0xC186FE29,0x33ED7D2A,0xE72719C1,0x154C9AC2,0x061C6936,0xF477EA35,0xAA64D611,0x580F5512,0x4B5FA6E6,0xB93425E5,0x6DFE410E,0x9F95C20D,0x8CC531F9,0x7EAEB2FA,
+    0x30E349B1,0xC288CAB2,0xD1D83946,0x23B3BA45,0xF779DEAE,0x05125DAD,0x1642AE59,0xE4292D5A,0xBA3A117E,0x4851927D,0x5B016189,0xA96AE28A,0x7DA08661,0x8FCB0562,0x9C9BF696,0x6EF07595,
+    0x417B1DBC,0xB3109EBF,0xA0406D4B,0x522BEE48,0x86E18AA3,0x748A09A0,0x67DAFA54,0x95B17957,0xCBA24573,0x39C9C670,0x2A993584,0xD8F2B687,0x0C38D26C,0xFE53516F,0xED03A29B,0x1F682198,
+    0x5125DAD3,0xA34E59D0,0xB01EAA24,0x42752927,0x96BF4DCC,0x64D4CECF,0x77843D3B,0x85EFBE38,0xDBFC821C,0x2997011F,0x3AC7F2EB,0xC8AC71E8,0x1C661503,0xEE0D9600,0xFD5D65F4,0x0F36E6F7,
+    0x61C69362,0x93AD1061,0x80FDE395,0x72966096,0xA65C047D,0x5437877E,0x4767748A,0xB50CF789,0xEB1FCBAD,0x197448AE,0x0A24BB5A,0xF84F3859,0x2C855CB2,0xDEEEDFB1,0xCDBE2C45,0x3FD5AF46,
+    0x7198540D,0x83F3D70E,0x90A324FA,0x62C8A7F9,0xB602C312,0x44694011,0x5739B3E5,0xA55230E6,0xFB410CC2,0x092A8FC1,0x1A7A7C35,0xE811FF36,0x3CDB9BDD,0xCEB018DE,0xDDE0EB2A,0x2F8B6829,
+    0x82F63B78,0x709DB87B,0x63CD4B8F,0x91A6C88C,0x456CAC67,0xB7072F64,0xA457DC90,0x563C5F93,0x082F63B7,0xFA44E0B4,0xE9141340,0x1B7F9043,0xCFB5F4A8,0x3DDE77AB,0x2E8E845F,0xDCE5075C,
+    0x92A8FC17,0x60C37F14,0x73938CE0,0x81F80FE3,0x55326B08,0xA759E80B,0xB4091BFF,0x466298FC,0x1871A4D8,0xEA1A27DB,0xF94AD42F,0x0B21572C,0xDFEB33C7,0x2D80B0C4,0x3ED04330,0xCCBBC033,
+    0xA24BB5A6,0x502036A5,0x4370C551,0xB11B4652,0x65D122B9,0x97BAA1BA,0x84EA524E,0x7681D14D,0x2892ED69,0xDAF96E6A,0xC9A99D9E,0x3BC21E9D,0xEF087A76,0x1D63F975,0x0E330A81,0xFC588982,
+    0xB21572C9,0x407EF1CA,0x532E023E,0xA145813D,0x758FE5D6,0x87E466D5,0x94B49521,0x66DF1622,0x38CC2A06,0xCAA7A905,0xD9F75AF1,0x2B9CD9F2,0xFF56BD19,0x0D3D3E1A,0x1E6DCDEE,0xEC064EED,
+    0xC38D26C4,0x31E6A5C7,0x22B65633,0xD0DDD530,0x0417B1DB,0xF67C32D8,0xE52CC12C,0x1747422F,0x49547E0B,0xBB3FFD08,0xA86F0EFC,0x5A048DFF,0x8ECEE914,0x7CA56A17,0x6FF599E3,0x9D9E1AE0,
+    0xD3D3E1AB,0x21B862A8,0x32E8915C,0xC083125F,0x144976B4,0xE622F5B7,0xF5720643,0x07198540,0x590AB964,0xAB613A67,0xB831C993,0x4A5A4A90,0x9E902E7B,0x6CFBAD78,0x7FAB5E8C,0x8DC0DD8F,
+    0xE330A81A,0x115B2B19,0x020BD8ED,0xF0605BEE,0x24AA3F05,0xD6C1BC06,0xC5914FF2,0x37FACCF1,0x69E9F0D5,0x9B8273D6,0x88D28022,0x7AB90321,0xAE7367CA,0x5C18E4C9,0x4F48173D,0xBD23943E,
+    0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351,
+};
+#endif
+
+// Update a CRC with 'data_size' bytes. The CRC is passed and returned without the final inversion.
+static inline ImU32 ImHashCrcUpdate(ImU32 crc, const unsigned char* data, size_t data_size)
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
+#if defined(IMGUI_ENABLE_SSE4_2_CRC)
+#if defined(__x86_64__) || defined(_M_X64)
+    for (; data_size >= 8; data += 8, data_size -= 8) { ImU64 v; memcpy(&v, data, 8); crc = (ImU32)_mm_crc32_u64(crc, v); }
+#endif
+    for (; data_size >= 4; data += 4, data_size -= 4) { ImU32 v; memcpy(&v, data, 4); crc = _mm_crc32_u32(crc, v); }
+    while (data_size-- != 0)
+        crc = _mm_crc32_u8(crc, *data++);
+#elif defined(IMGUI_ENABLE_ARM_CRC)
+    for (; data_size >= 8; data += 8, data_size -= 8) { ImU64 v; memcpy(&v, data, 8); crc = __crc32cd(crc, v); }
+    for (; data_size >= 4; data += 4, data_size -= 4) { ImU32 v; memcpy(&v, data, 4); crc = __crc32cw(crc, v); }
+    while (data_size-- != 0)
+        crc = __crc32cb(crc, *data++);
+#else
+#ifdef IMGUI_USE_CRC32C_HASH
+    const ImU32* crc32_lut = GCrc32cLookupTable;
+#else
     const ImU32* crc32_lut = GCrc32LookupTable;
+#endif
     while (data_size-- != 0)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
-    return ~crc;
+#endif
+    return crc;
 }
 
-// Zero-terminated string hash, with support for ### to reset back to seed value
-// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
-// Because this syntax is rarely used we are optimizing for the common case.
-// - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+// FIXME-OPT: The default table based CRC32 pretty much randomly access 1KB. Define IMGUI_USE_CRC32C_HASH to use hardware CRC32C instructions when available.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    return ~ImHashCrcUpdate(~seed, (const unsigned char*)data_p, data_size);
+}
+
+// Known size hash, 8 bytes at a time: ImHashData() is as slow as measuring short text without SSE 4.2 CRC32 instructions.
+// Used for cache keys (checked against a copy of the data) and change detection, so this only needs to be well distributed.
+ImGuiID ImHashDataFast(const void* data_p, size_t data_size, ImU64 seed)
 {
-    seed = ~seed;
-    ImU32 crc = seed;
     const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    if (data_size != 0)
+    const ImU64 k = 0x9E3779B97F4A7C15ull;
+    ImU64 h = (seed ^ data_size) * k;
+    for (; data_size >= 8; data += 8, data_size -= 8)
     {
-        while (data_size-- != 0)
-        {
-            unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
+        ImU64 v;
+        memcpy(&v, data, 8);
+        h = (h ^ v) * k;
+        h ^= h >> 29;
     }
-    else
+    if (data_size > 0)
     {
-        while (unsigned char c = *data++)
-        {
-            if (c == '#' && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
+        ImU64 v = 0;
+        memcpy(&v, data, data_size);
+        h = (h ^ v) * k;
+        h ^= h >> 29;
     }
+    return (ImGuiID)(h ^ (h >> 32));
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+// Because this syntax is rarely used we are optimizing for the common case.
+// - Resetting to the seed on every ### is equivalent to hashing from the last ###, so we locate it first and hash the remainder in one go.
+// - memchr() skips over labels without any '#' in a few vectorized steps, we only look closer at each '#' it finds.
+ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
+{
+    const char* data = data_p;
+    const char* data_end = data_p + (data_size != 0 ? data_size : strlen(data_p));
+    for (const char* p = data; data_end - p >= 3 && (p = (const char*)memchr(p, '#', (size_t)(data_end - p - 2))) != NULL; p++)
+        if (p[1] == '#' && p[2] == '#')
+            data = p;
+    return ~ImHashCrcUpdate(~seed, (const unsigned char*)data, (size_t)(data_end - data));
+}
+
+// String literal hash, see IM_LITERAL_ID()
+// The seed part is linear: XOR the contribution of each seed nibble, pushed through the hashed part of the literal at compile-time.
+ImGuiID ImHashLiteral(const ImGuiLiteralID& lit_id, ImGuiID seed)
+{
+    const ImU32* t = lit_id.SeedShift;
+    const ImU32 s = ~seed;
+    ImU32 crc = lit_id.Crc;
+    crc ^= t[0 * 16 + ((s >>  0) & 15)] ^ t[1 * 16 + ((s >>  4) & 15)] ^ t[2 * 16 + ((s >>  8) & 15)] ^ t[3 * 16 + ((s >> 12) & 15)];
+    crc ^= t[4 * 16 + ((s >> 16) & 15)] ^ t[5 * 16 + ((s >> 20) & 15)] ^ t[6 * 16 + ((s >> 24) & 15)] ^ t[7 * 16 + ((s >> 28) & 15)];
     return ~crc;
 }
 
@@ -2418,14 +2496,83 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+// Count leading ASCII characters (0x01 to 0x7F) in the next 16 bytes, which decode to themselves. Stops at zero-terminator or at first byte of a multi-byte sequence.
+static inline int ImTextCountAscii16(const char* in_text)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)in_text);
+    const ImU32 mask = (ImU32)_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+    return mask ? (int)ImCountTrailingZeroes(mask) : 16;
+#else
+    const uint8x16_t v = vld1q_u8((const uint8_t*)(const void*)in_text);
+    if (vmaxvq_u8(v) < 0x80 && vminvq_u8(v) != 0)
+        return 16;
+    int n = 0;
+    while ((unsigned char)(in_text[n] - 1) < 0x7F)
+        n++;
+    return n;
+#endif
+}
+
+// Widen 16 ASCII characters at once (caller checked them with ImTextCountAscii16())
+static inline void ImTextWidenAscii16(ImWchar* out_buf, const char* in_text)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)in_text);
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+#ifdef IMGUI_USE_WCHAR32
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 0), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 12), _mm_unpackhi_epi16(hi, zero));
+#else
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 0), lo);
+    _mm_storeu_si128((__m128i*)(void*)(out_buf + 8), hi);
+#endif
+#else
+    const uint8x16_t v = vld1q_u8((const uint8_t*)(const void*)in_text);
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+#ifdef IMGUI_USE_WCHAR32
+    vst1q_u32((uint32_t*)(void*)(out_buf + 0), vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32((uint32_t*)(void*)(out_buf + 4), vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32((uint32_t*)(void*)(out_buf + 8), vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32((uint32_t*)(void*)(out_buf + 12), vmovl_u16(vget_high_u16(hi)));
+#else
+    vst1q_u16((uint16_t*)(void*)(out_buf + 0), lo);
+    vst1q_u16((uint16_t*)(void*)(out_buf + 8), hi);
+#endif
+#endif
+}
+#endif
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+        // Convert runs of ASCII characters 16 at a time. Without 'in_text_end' we can't tell whether it is safe to read 16 bytes.
+        if (in_text_end && in_text_end - in_text >= 16 && buf_end - buf_out > 16)
+        {
+            const int ascii_count = ImTextCountAscii16(in_text);
+            if (ascii_count == 16)
+                ImTextWidenAscii16(buf_out, in_text);
+            else
+                for (int n = 0; n < ascii_count; n++)
+                    buf_out[n] = (ImWchar)in_text[n];
+            buf_out += ascii_count;
+            in_text += ascii_count;
+            if (ascii_count > 0)
+                continue;
+        }
+#endif
         unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        in_text += ImTextDecodeUtf8(&c, in_text, in_text_end);
         *buf_out++ = (ImWchar)c;
     }
     *buf_out = 0;
@@ -2439,8 +2586,18 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
     int char_count = 0;
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+        if (in_text_end && in_text_end - in_text >= 16)
+        {
+            const int ascii_count = ImTextCountAscii16(in_text);
+            char_count += ascii_count;
+            in_text += ascii_count;
+            if (ascii_count > 0)
+                continue;
+        }
+#endif
         unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        in_text += ImTextDecodeUtf8(&c, in_text, in_text_end);
         char_count++;
     }
     return char_count;
@@ -2682,18 +2839,118 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
     return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
 }
 
+// Hash index slot for a key. IDs are usually well distributed hashes already, but storage is also used with small integer keys.
+static inline int StorageIndexSlot(ImGuiID key, int slots_mask)
+{
+    key ^= key >> 16;
+    key *= 0x85EBCA6Bu;
+    key ^= key >> 13;
+    return (int)(key & (ImU32)slots_mask);
+}
+
+static void StorageIndexAdd(ImGuiStorage* storage, ImGuiID key, int pos)
+{
+    if (key == 0)
+    {
+        storage->IndexZeroKey = pos + 1;
+        return;
+    }
+    const int slots_mask = storage->IndexKeys.Size - 1;
+    int slot = StorageIndexSlot(key, slots_mask);
+    while (storage->IndexKeys.Data[slot] != 0)
+        slot = (slot + 1) & slots_mask;
+    storage->IndexKeys.Data[slot] = key;
+    storage->IndexPos.Data[slot] = pos;
+}
+
+// Find pair, NULL if missing
+static ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStoragePair* data = const_cast<ImGuiStoragePair*>(storage->Data.Data);
+    if (!storage->UseHashIndex)
+    {
+        ImGuiStoragePair* it = ImLowerBound(data, data + storage->Data.Size, key);
+        return (it == data + storage->Data.Size || it->key != key) ? NULL : it;
+    }
+    if (key == 0)
+        return storage->IndexZeroKey ? &data[storage->IndexZeroKey - 1] : NULL;
+    if (storage->IndexKeys.Size == 0)
+        return NULL;
+    const ImGuiID* keys = storage->IndexKeys.Data;
+    const int slots_mask = storage->IndexKeys.Size - 1;
+    for (int slot = StorageIndexSlot(key, slots_mask); keys[slot] != 0; slot = (slot + 1) & slots_mask)
+        if (keys[slot] == key)
+            return &data[storage->IndexPos.Data[slot]];
+    return NULL;
+}
+
+// Find pair, insert 'new_pair' if missing
+static ImGuiStoragePair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& new_pair)
+{
+    const ImGuiID key = new_pair.key;
+    if (!storage->UseHashIndex)
+    {
+        ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, key);
+        if (it == storage->Data.Data + storage->Data.Size || it->key != key)
+            it = storage->Data.insert(it, new_pair);
+        return it;
+    }
+    if (ImGuiStoragePair* it = StorageFind(storage, key))
+        return it;
+
+    // Keep the load factor under 1/2 so probe sequences stay short
+    storage->Data.push_back(new_pair);
+    if (storage->Data.Size * 2 > storage->IndexKeys.Size)
+        storage->BuildHashIndex();
+    else
+        StorageIndexAdd(storage, key, storage->Data.Size - 1);
+    return &storage->Data.back();
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+    if (UseHashIndex)
+        BuildHashIndex();
+}
+
+void ImGuiStorage::SetHashIndex(bool enabled)
+{
+    if (UseHashIndex == enabled)
+        return;
+    UseHashIndex = enabled;
+    if (enabled)
+    {
+        BuildHashIndex();
+    }
+    else
+    {
+        IndexKeys.clear();
+        IndexPos.clear();
+        IndexZeroKey = 0;
+        BuildSortByKey();
+    }
+}
+
+void ImGuiStorage::BuildHashIndex()
+{
+    IM_ASSERT(UseHashIndex);
+    int slots_count = 16;
+    while (slots_count < Data.Size * 2)
+        slots_count *= 2;
+    IndexKeys.resize(slots_count);
+    IndexPos.resize(slots_count);
+    memset(IndexKeys.Data, 0, (size_t)IndexKeys.size_in_bytes());
+    IndexZeroKey = 0;
+    for (int n = 0; n < Data.Size; n++)
+        StorageIndexAdd(this, Data.Data[n].key, n);
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2703,27 +2960,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2733,28 +2983,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2764,20 +3003,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2967,6 +3198,58 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
     EndOffset = ImMax(EndOffset, new_size);
 }
 
+void ImFrameArena::clear()
+{
+    for (ImFrameArenaPage& page : Pages)
+    {
+        for (void* block : page.Overflow)
+            IM_FREE(block);
+        page.Overflow.clear();
+        if (page.Data)
+            IM_FREE(page.Data);
+        page.Data = NULL;
+        page.Size = page.Capacity = page.OverflowSize = 0;
+    }
+}
+
+void ImFrameArena::swap()
+{
+    CurrPage ^= 1;
+    ImFrameArenaPage& page = Pages[CurrPage];
+    const int high_water = page.Size + page.OverflowSize;
+    for (void* block : page.Overflow)
+        IM_FREE(block);
+    page.Overflow.resize(0);
+    if (high_water > page.Capacity || (page.Capacity > 64 * 1024 && high_water * 4 < page.Capacity))
+    {
+        // Resize to the high-water mark of the last frame that used this page, with some slack.
+        // Only shrink when usage dropped a lot (e.g. after a one-off large paste), so we don't reallocate every frame.
+        if (page.Data)
+            IM_FREE(page.Data);
+        page.Capacity = IM_MEMALIGN(high_water + high_water / 2, 4096);
+        page.Data = page.Capacity ? (char*)IM_ALLOC((size_t)page.Capacity) : NULL;
+    }
+    page.Size = page.OverflowSize = 0;
+}
+
+void* ImFrameArena::alloc(size_t sz, size_t align)
+{
+    IM_ASSERT(align > 0 && align <= 16 && (align & (align - 1)) == 0);
+    ImFrameArenaPage& page = Pages[CurrPage];
+    const int off = (int)IM_MEMALIGN(page.Size, align);
+    if (off + (int)sz <= page.Capacity)
+    {
+        page.Size = off + (int)sz;
+        return page.Data + off;
+    }
+
+    // Page is full: allocate separately until the page is regrown in swap(). MemAlloc() returns blocks aligned for any type.
+    void* block = IM_ALLOC(sz);
+    page.Overflow.push_back(block);
+    page.OverflowSize += (int)IM_MEMALIGN(sz, 16);
+    return block;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -3331,6 +3614,7 @@ void ImGui::PushStyleColor(ImGuiCol idx, ImU32 col)
     backup.Col = idx;
     backup.BackupValue = g.Style.Colors[idx];
     g.ColorStack.push_back(backup);
+    g.StyleHash = 0;
     if (g.DebugFlashStyleColorIdx != idx)
         g.Style.Colors[idx] = ColorConvertU32ToFloat4(col);
 }
@@ -3342,6 +3626,7 @@ void ImGui::PushStyleColor(ImGuiCol idx, const ImVec4& col)
     backup.Col = idx;
     backup.BackupValue = g.Style.Colors[idx];
     g.ColorStack.push_back(backup);
+    g.StyleHash = 0;
     if (g.DebugFlashStyleColorIdx != idx)
         g.Style.Colors[idx] = col;
 }
@@ -3354,6 +3639,7 @@ void ImGui::PopStyleColor(int count)
         IM_ASSERT_USER_ERROR(0, "Calling PopStyleColor() too many times!");
         count = g.ColorStack.Size;
     }
+    g.StyleHash = 0;
     while (count > 0)
     {
         ImGuiColorMod& backup = g.ColorStack.back();
@@ -3424,6 +3710,7 @@ void ImGui::PushStyleVar(ImGuiStyleVar idx, float val)
     }
     float* pvar = (float*)var_info->GetVarPtr(&g.Style);
     g.StyleVarStack.push_back(ImGuiStyleMod(idx, *pvar));
+    g.StyleHash = 0;
     *pvar = val;
 }
 
@@ -3438,6 +3725,7 @@ void ImGui::PushStyleVarX(ImGuiStyleVar idx, float val_x)
     }
     ImVec2* pvar = (ImVec2*)var_info->GetVarPtr(&g.Style);
     g.StyleVarStack.push_back(ImGuiStyleMod(idx, *pvar));
+    g.StyleHash = 0;
     pvar->x = val_x;
 }
 
@@ -3452,6 +3740,7 @@ void ImGui::PushStyleVarY(ImGuiStyleVar idx, float val_y)
     }
     ImVec2* pvar = (ImVec2*)var_info->GetVarPtr(&g.Style);
     g.StyleVarStack.push_back(ImGuiStyleMod(idx, *pvar));
+    g.StyleHash = 0;
     pvar->y = val_y;
 }
 
@@ -3466,6 +3755,7 @@ void ImGui::PushStyleVar(ImGuiStyleVar idx, const ImVec2& val)
     }
     ImVec2* pvar = (ImVec2*)var_info->GetVarPtr(&g.Style);
     g.StyleVarStack.push_back(ImGuiStyleMod(idx, *pvar));
+    g.StyleHash = 0;
     *pvar = val;
 }
 
@@ -3477,6 +3767,7 @@ void ImGui::PopStyleVar(int count)
         IM_ASSERT_USER_ERROR(0, "Calling PopStyleVar() too many times!");
         count = g.StyleVarStack.Size;
     }
+    g.StyleHash = 0;
     while (count > 0)
     {
         // We avoid a generic memcpy(data, &backup.Backup.., GDataTypeSize[info->Type] * info->Count), the overhead in Debug is not worth it.
@@ -4101,6 +4392,7 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     DebugItemPickerBreakId = 0;
     DebugFlashStyleColorTime = 0.0f;
     DebugFlashStyleColorIdx = ImGuiCol_COUNT;
+    StyleHash = 0;
     DebugHoveredDockNode = NULL;
 
     // Same as DebugBreakClearData(). Those fields are scattered in their respective subsystem to stay in hot-data locations
@@ -4187,6 +4479,7 @@ void ImGui::Shutdown()
     }
     g.IO.Fonts = NULL;
     g.DrawListSharedData.TempBuffer.clear();
+    g.FrameArena.clear();
 
     // Cleanup of other data are conditional on actually having initialized Dear ImGui.
     if (!g.Initialized)
@@ -4352,6 +4645,24 @@ static void SetCurrentWindow(ImGuiWindow* window)
     }
 }
 
+// Allocate transient memory, valid until the NewFrame() of the frame after the current one (so it may be referenced by this frame's ImDrawData).
+void* ImGui::FrameAlloc(size_t size, size_t align)
+{
+    ImGuiContext& g = *GImGui;
+    return g.FrameArena.alloc(size, align);
+}
+
+const char* ImGui::FrameStrdup(const char* str, const char* str_end)
+{
+    if (str_end == NULL)
+        str_end = str + strlen(str);
+    const size_t len = (size_t)(str_end - str);
+    char* buf = (char*)FrameAlloc(len + 1, 1);
+    memcpy(buf, str, len);
+    buf[len] = 0;
+    return buf;
+}
+
 void ImGui::GcCompactTransientMiscBuffers()
 {
     ImGuiContext& g = *GImGui;
@@ -4368,6 +4679,7 @@ void ImGui::GcCompactTransientMiscBuffers()
 // This should have no noticeable visual effect. When the window reappear however, expect new allocation/buffer growth/copy cost.
 void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
 {
+    IMGUI_PROFILER_ZONE("GcCompactTransientWindowBuffers");
     window->MemoryCompacted = true;
     window->MemoryDrawListIdxCapacity = window->DrawList->IdxBuffer.Capacity;
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
@@ -4770,9 +5082,54 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 }
 
 // IM_ALLOC() == ImGui::MemAlloc()
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+// With IMGUI_ENABLE_ALLOC_TAGS every block is prefixed with its size, tag and the context which counted it, so MemFree() can update live bytes of the right tag.
+// The header size is a multiple of 16 bytes to preserve the alignment of the underlying allocator.
+struct ImGuiAllocHeader
+{
+    size_t          Size;
+    ImGuiContext*   Ctx;        // Context current when allocating, NULL if none
+    ImU32           Tag;
+};
+static const size_t IM_ALLOC_HEADER_SIZE = (sizeof(ImGuiAllocHeader) + 15) & ~(size_t)15;
+
+static void DebugAllocTagHook(ImGuiDebugAllocInfo* info, ImGuiAllocHeader* header, bool is_alloc)
+{
+    ImGuiDebugAllocTagInfo* tag_info = &info->Tags[header->Tag];
+    if (is_alloc)
+    {
+        tag_info->LiveBytes += (ImS64)header->Size;
+        tag_info->PeakBytes = ImMax(tag_info->PeakBytes, tag_info->LiveBytes);
+        tag_info->LiveCount++;
+        tag_info->TotalAllocCount++;
+        tag_info->FrameAllocCount++;
+        tag_info->FrameAllocBytes += (ImS64)header->Size;
+    }
+    else
+    {
+        tag_info->LiveBytes -= (ImS64)header->Size;
+        tag_info->LiveCount--;
+        tag_info->FrameFreeCount++;
+    }
+}
+#endif
+
 void* ImGui::MemAlloc(size_t size)
 {
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    ImGuiAllocHeader* header = (ImGuiAllocHeader*)(*GImAllocatorAllocFunc)(IM_ALLOC_HEADER_SIZE + size, GImAllocatorUserData);
+    if (header == NULL)
+        return NULL;
+    ImGuiContext* tag_ctx = GImGui;
+    header->Size = size;
+    header->Ctx = tag_ctx;
+    header->Tag = tag_ctx ? tag_ctx->DebugAllocInfo.CurrentTag : ImGuiAllocTag_Misc;
+    if (tag_ctx)
+        DebugAllocTagHook(&tag_ctx->DebugAllocInfo, header, true);
+    void* ptr = (char*)header + IM_ALLOC_HEADER_SIZE;
+#else
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
+#endif
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
         DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
@@ -4787,6 +5144,16 @@ void ImGui::MemFree(void* ptr)
     if (ptr != NULL)
         if (ImGuiContext* ctx = GImGui)
             DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+#endif
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    if (ptr != NULL)
+    {
+        // Only the context which counted the block may uncount it. It must still be current: when it isn't, it may have been destroyed.
+        ImGuiAllocHeader* header = (ImGuiAllocHeader*)((char*)ptr - IM_ALLOC_HEADER_SIZE);
+        if (header->Ctx != NULL && header->Ctx == GImGui)
+            DebugAllocTagHook(&header->Ctx->DebugAllocInfo, header, false);
+        ptr = header;
+    }
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
@@ -4817,6 +5184,30 @@ void ImGui::DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr
     }
 }
 
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+const ImGuiDebugAllocTagInfo* ImGui::DebugGetAllocTagInfo(ImGuiAllocTag tag)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(tag >= 0 && tag < ImGuiAllocTag_COUNT);
+    return &g.DebugAllocInfo.Tags[tag];
+}
+
+const char* ImGui::DebugGetAllocTagName(ImGuiAllocTag tag)
+{
+    static const char* names[] = { "Misc", "DrawLists", "Windows", "Tables", "InputText", "Fonts", "Docking", "Settings" };
+    IM_STATIC_ASSERT(IM_ARRAYSIZE(names) == ImGuiAllocTag_COUNT);
+    IM_ASSERT(tag >= 0 && tag < ImGuiAllocTag_COUNT);
+    return names[tag];
+}
+
+void ImGui::DebugResetAllocTagPeaks()
+{
+    ImGuiContext& g = *GImGui;
+    for (ImGuiDebugAllocTagInfo& tag_info : g.DebugAllocInfo.Tags)
+        tag_info.PeakBytes = tag_info.LiveBytes;
+}
+#endif
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -4970,6 +5361,7 @@ void ImGui::StartMouseMovingWindowOrNode(ImGuiWindow* window, ImGuiDockNode* nod
 void ImGui::UpdateMouseMovingWindowNewFrame()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateMouseMovingWindowNewFrame");
     if (g.MovingWindow != NULL)
     {
         // We actually want to move the root window. g.MovingWindow == window we clicked on (could be a child window).
@@ -5034,6 +5426,7 @@ void ImGui::UpdateMouseMovingWindowNewFrame()
 void ImGui::UpdateMouseMovingWindowEndFrame()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateMouseMovingWindowEndFrame");
     if (g.ActiveId != 0 || (g.HoveredId != 0 && !g.HoveredIdIsDisabled))
         return;
 
@@ -5117,6 +5510,7 @@ static bool IsWindowActiveAndVisible(ImGuiWindow* window)
 void ImGui::UpdateHoveredWindowAndCaptureFlags()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateHoveredWindowAndCaptureFlags");
     ImGuiIO& io = g.IO;
 
     // FIXME-DPI: This storage was added on 2021/03/31 for test engine, but if we want to multiply WINDOWS_HOVER_PADDING
@@ -5216,8 +5610,22 @@ static void SetupDrawListSharedData()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
-    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
+    if (g.IO.BackendFlags & (ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasIdx32))
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasRectInstances)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_RectInstances;
+    if (g.IO.ConfigDrawListsDeferText)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_DeferText;
+    if (g.IO.ConfigDrawListsShapeCache)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_ShapeCache;
+    if (g.IO.ConfigDrawListsTextLayoutCache)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_TextLayoutCache;
+
+    // Text layout cache: remove layouts unused for a few frames, or everything when disabled
+    if (g.IO.ConfigDrawListsTextLayoutCache)
+        g.DrawListSharedData.TextLayoutCache.GarbageCollect();
+    else if (g.DrawListSharedData.TextLayoutCache.Layouts.GetBufSize() > 0)
+        g.DrawListSharedData.TextLayoutCache.Clear();
 }
 
 void ImGui::NewFrame()
@@ -5225,6 +5633,24 @@ void ImGui::NewFrame()
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
 
+    // [DEBUG] Start recording a new frame in the profiler, if enabled
+#ifdef IMGUI_ENABLE_PROFILER
+    ProfilerNewFrame();
+#endif
+    IMGUI_PROFILER_ZONE("NewFrame");
+
+    // [DEBUG] Start new frame of per-tag allocation counters
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    for (ImGuiDebugAllocTagInfo& tag_info : g.DebugAllocInfo.Tags)
+    {
+        tag_info.LastFrameAllocCount = tag_info.FrameAllocCount;
+        tag_info.LastFrameFreeCount = tag_info.FrameFreeCount;
+        tag_info.LastFrameAllocBytes = tag_info.FrameAllocBytes;
+        tag_info.FrameAllocCount = tag_info.FrameFreeCount = 0;
+        tag_info.FrameAllocBytes = 0;
+    }
+#endif
+
     // Remove pending delete hooks before frame start.
     // This deferred removal avoid issues of removal while iterating the hook vector
     for (int n = g.Hooks.Size - 1; n >= 0; n--)
@@ -5244,6 +5670,7 @@ void ImGui::NewFrame()
     g.Time += g.IO.DeltaTime;
     g.WithinFrameScope = true;
     g.FrameCount += 1;
+    g.FrameArena.swap();
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
@@ -5452,6 +5879,7 @@ void ImGui::NewFrame()
     g.ItemFlagsStack.push_back(ImGuiItemFlags_AutoClosePopups); // Default flags
     g.CurrentItemFlags = g.ItemFlagsStack.back();
     g.GroupStack.resize(0);
+    g.StyleHash = 0; // Style may have been modified directly between frames
 
     // Docking
     DockContextNewFrameUpdateDocking(&g);
@@ -5535,6 +5963,8 @@ static void AddWindowToDrawData(ImGuiWindow* window, int layer)
     if (window->DrawList->_Splitter._Count > 1)
         window->DrawList->ChannelsMerge(); // Merge if user forgot to merge back. Also required in Docking branch for ImGuiWindowFlags_DockNodeHost windows.
     ImGui::AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[layer], window->DrawList);
+    if (window->SkipRefresh && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDamageRects))
+        viewport->DrawDataBuilder.DamageUnchangedLists.push_back(window->DrawList);
     for (ImGuiWindow* child : window->DC.ChildWindows)
         if (IsWindowActiveAndVisible(child)) // Clipped children may have been marked not active
             AddWindowToDrawData(child, layer);
@@ -5548,6 +5978,7 @@ static inline int GetWindowDisplayLayer(ImGuiWindow* window)
 // Layer is locked for the root window, however child windows may use a different viewport (e.g. extruding menu)
 static inline void AddRootWindowToDrawData(ImGuiWindow* window)
 {
+    IMGUI_PROFILER_ZONE_WINDOW("AddRootWindowToDrawData", window);
     AddWindowToDrawData(window, GetWindowDisplayLayer(window));
 }
 
@@ -5589,11 +6020,291 @@ static void InitViewportDrawData(ImGuiViewportP* viewport)
 
     draw_data->Valid = true;
     draw_data->CmdListsCount = 0;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = draw_data->TotalRectInstCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = is_minimized ? ImVec2(0.0f, 0.0f) : viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale; // FIXME-VIEWPORT: This may vary on a per-monitor/viewport basis?
     draw_data->OwnerViewport = viewport;
+    draw_data->VtxCompact = false;
+    draw_data->DamageRectsValid = false;
+    draw_data->DamageRects.resize(0);
+    viewport->DrawDataBuilder.DamageUnchangedLists.resize(0);
+}
+
+// Everything but the hash, which is only needed for some lists (see UpdateViewportDrawDataDamage())
+static void CalcDrawListDamageEntry(const ImDrawList* draw_list, ImDrawDataDamageEntry* entry)
+{
+    // Vertices bounding box, clipped by the union of clip rectangles.
+    // User callbacks may render anything within their clip rectangle, and their output cannot be compared.
+    ImRect vtx_bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawVert& vtx : draw_list->VtxBuffer)
+        vtx_bounds.Add(vtx.pos);
+    ImRect clip_bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    ImRect callback_bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        if (cmd.UserCallback != NULL && cmd.UserCallback != ImDrawCallback_ResetRenderState)
+        {
+            callback_bounds.Add(ImRect(cmd.ClipRect));
+        }
+        else if (cmd.ElemCount > 0)
+        {
+            clip_bounds.Add(ImRect(cmd.ClipRect));
+        }
+        else if (cmd.RectInstCount > 0)
+        {
+            // Include stroke half-width + anti-aliasing fringe
+            clip_bounds.Add(ImRect(cmd.ClipRect));
+            for (const ImDrawRectInstance* inst = draw_list->RectInstBuffer.Data + cmd.RectInstOffset; inst < draw_list->RectInstBuffer.Data + cmd.RectInstOffset + cmd.RectInstCount; inst++)
+            {
+                const float pad = inst->Thickness * 0.5f + 1.0f;
+                vtx_bounds.Add(ImRect(inst->Min.x - pad, inst->Min.y - pad, inst->Max.x + pad, inst->Max.y + pad));
+            }
+        }
+    }
+    vtx_bounds.ClipWithFull(clip_bounds);
+    if (vtx_bounds.IsInverted())
+        vtx_bounds = callback_bounds;
+    else if (!callback_bounds.IsInverted())
+        vtx_bounds.Add(callback_bounds);
+
+    entry->DrawList = draw_list;
+    entry->Hash = 0;
+    entry->CmdCount = draw_list->CmdBuffer.Size;
+    entry->VtxCount = draw_list->VtxBuffer.Size;
+    entry->IdxCount = draw_list->IdxBuffer.Size;
+    entry->RectInstCount = draw_list->RectInstBuffer.Size;
+    entry->HasCallbacks = !callback_bounds.IsInverted();
+    entry->Changed = false;
+    entry->Bounds = vtx_bounds.IsInverted() ? ImRect() : vtx_bounds;
+}
+
+static ImGuiID CalcDrawListDamageHash(const ImDrawList* draw_list)
+{
+    ImGuiID hash = ImHashDataFast(draw_list->CmdBuffer.Data, (size_t)draw_list->CmdBuffer.size_in_bytes()); // ImDrawCmd padding is always cleared
+    hash = ImHashDataFast(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), hash);
+    hash = ImHashDataFast(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), hash);
+    hash = ImHashDataFast(draw_list->RectInstBuffer.Data, (size_t)draw_list->RectInstBuffer.size_in_bytes(), hash);
+    return hash ? hash : 1;
+}
+
+static void AddDamageRect(ImVector<ImRect>& rects, const ImRect& r, const ImRect& display_rect)
+{
+    ImRect clipped = r;
+    clipped.ClipWithFull(display_rect);
+    if (clipped.GetWidth() > 0.0f && clipped.GetHeight() > 0.0f)
+        rects.push_back(clipped);
+}
+
+static void ExpandTextRunsJobFunc(void* job_data, int job_index)
+{
+    ImDrawTextRunsJob* job = (ImDrawTextRunsJob*)job_data + job_index;
+    job->DrawList->_ExpandTextRuns(job->RunBegin, job->RunEnd);
+}
+
+// Write vertices of text recorded with ImDrawListFlags_DeferText (io.ConfigDrawListsDeferText), for draw lists submitted to all viewports.
+// - Runs are grouped into jobs of at least IM_DRAWLIST_TEXT_RUNS_JOB_MIN_QUADS quads, dispatched with platform_io.Platform_ParallelForFn when available.
+// - Each run writes to the range of VtxBuffer[] reserved when it was recorded, so output doesn't depend on the number of threads or on job ordering.
+static void ExpandViewportsTextRuns()
+{
+    ImGuiContext& g = *GImGui;
+    ImVector<ImDrawTextRunsJob>& jobs = g.DrawTextRunsJobs;
+    jobs.resize(0);
+    for (ImGuiViewportP* viewport : g.Viewports)
+        for (ImDrawList* draw_list : viewport->DrawDataP.CmdLists)
+        {
+            int run_begin = 0;
+            int quads_count = 0;
+            for (int run_n = 0; run_n < draw_list->_TextRuns.Size; run_n++)
+            {
+                quads_count += draw_list->_TextRuns.Data[run_n].QuadsCount;
+                if (quads_count < IM_DRAWLIST_TEXT_RUNS_JOB_MIN_QUADS && run_n + 1 < draw_list->_TextRuns.Size)
+                    continue;
+                ImDrawTextRunsJob job = { draw_list, run_begin, run_n + 1 };
+                jobs.push_back(job);
+                run_begin = run_n + 1;
+                quads_count = 0;
+            }
+        }
+    if (jobs.Size == 0)
+        return;
+
+    IMGUI_PROFILER_ZONE("ExpandTextRuns");
+    if (jobs.Size > 1 && g.PlatformIO.Platform_ParallelForFn != NULL)
+        g.PlatformIO.Platform_ParallelForFn(&g, jobs.Size, ExpandTextRunsJobFunc, jobs.Data);
+    else
+        for (int job_n = 0; job_n < jobs.Size; job_n++)
+            ExpandTextRunsJobFunc(jobs.Data, job_n);
+    for (ImDrawTextRunsJob& job : jobs)
+        if (job.RunEnd == job.DrawList->_TextRuns.Size)
+        {
+            job.DrawList->_TextRuns.resize(0);
+            job.DrawList->_TextRunsBuf.resize(0);
+        }
+}
+
+// Compute ImDrawData::DamageRects[] by comparing each draw list with its content in the previous Render() of the same viewport.
+// - Granularity is the draw list: a list which changed damages its bounding box in both frames. A list that moved in the
+//   stacking order is considered changed, as it may now be covered or uncovered by others.
+// - Lists of windows which skipped refresh reuse their previous entry. Other lists are hashed only when their buffer sizes and bounds are unchanged.
+// - Overlapping rectangles are merged, then the pairs adding the least area are merged until reaching IM_DRAWDATA_DAMAGE_RECTS_MAX.
+//   Past IM_DRAWDATA_DAMAGE_RECTS_MAX*4 rectangles, they are first merged by cells of a 4x4 grid over the display.
+// - Rectangles are rounded outward to whole pixels (accounting for FramebufferScale) and clipped to the display rectangle.
+static void UpdateViewportDrawDataDamage(ImGuiViewportP* viewport)
+{
+    IMGUI_PROFILER_ZONE("UpdateViewportDrawDataDamage");
+    ImDrawDataBuilder* builder = &viewport->DrawDataBuilder;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    const ImRect display_rect(draw_data->DisplayPos, draw_data->DisplayPos + draw_data->DisplaySize);
+
+    ImVector<ImDrawDataDamageEntry>& prev_entries = builder->DamagePrevEntries;
+    ImVector<ImDrawDataDamageEntry>& curr_entries = builder->DamageCurrEntries;
+    ImVector<const ImDrawList*>& unchanged_lists = builder->DamageUnchangedLists;
+    if (!builder->DamagePrevValid)
+        prev_entries.resize(0);
+    curr_entries.resize(draw_data->CmdLists.Size);
+
+    ImVector<ImRect>& rects = builder->DamageRects;
+    rects.resize(0);
+    const bool full_damage = !builder->DamagePrevValid || builder->DamagePrevDisplayPos != draw_data->DisplayPos
+        || builder->DamagePrevDisplaySize != draw_data->DisplaySize || builder->DamagePrevFramebufferScale != draw_data->FramebufferScale;
+    if (full_damage)
+        AddDamageRect(rects, display_rect, display_rect);
+
+    // Lists are generally submitted in the same order, so search from the last match first.
+    int search_start = 0;
+    int unchanged_search_start = 0;
+    int prev_max_n = -1;
+    for (int curr_n = 0; curr_n < draw_data->CmdLists.Size; curr_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[curr_n];
+        ImDrawDataDamageEntry& curr = curr_entries[curr_n];
+        int prev_n = -1;
+        for (int i = 0; i < prev_entries.Size && prev_n == -1; i++)
+        {
+            const int n = (search_start + i) % prev_entries.Size;
+            if (prev_entries[n].DrawList == draw_list)
+                prev_n = n;
+        }
+        bool unchanged_list = false;
+        for (int i = 0; i < unchanged_lists.Size && prev_n != -1 && !unchanged_list; i++)
+        {
+            const int n = (unchanged_search_start + i) % unchanged_lists.Size;
+            if (unchanged_lists[n] == draw_list)
+            {
+                unchanged_list = true;
+                unchanged_search_start = n + 1;
+            }
+        }
+
+        // A list whose sizes or bounds changed is damaged anyway: only hash it when it was unchanged in the previous frame, so we can tell
+        // whether it is unchanged in the next one. A list that keeps changing is not hashed, and is considered changed once more when it stops.
+        ImDrawDataDamageEntry* prev = (prev_n != -1) ? &prev_entries[prev_n] : NULL;
+        bool changed;
+        if (unchanged_list && prev->CmdCount == draw_list->CmdBuffer.Size && prev->VtxCount == draw_list->VtxBuffer.Size && prev->IdxCount == draw_list->IdxBuffer.Size && prev->RectInstCount == draw_list->RectInstBuffer.Size) // Sizes may differ if something was appended (e.g. RenderDimmedBackgrounds())
+        {
+            curr = *prev;
+            changed = curr.HasCallbacks;
+        }
+        else
+        {
+            CalcDrawListDamageEntry(draw_list, &curr);
+            changed = curr.HasCallbacks || (prev != NULL && (prev->CmdCount != curr.CmdCount || prev->VtxCount != curr.VtxCount || prev->IdxCount != curr.IdxCount
+                || prev->RectInstCount != curr.RectInstCount || prev->Bounds.Min != curr.Bounds.Min || prev->Bounds.Max != curr.Bounds.Max));
+            if (!changed || (!curr.HasCallbacks && !prev->Changed))
+                curr.Hash = CalcDrawListDamageHash(draw_list);
+            if (!changed)
+                changed = (prev == NULL || prev->Hash != curr.Hash);
+        }
+        curr.Changed = changed;
+        if (prev == NULL)
+        {
+            if (!full_damage)
+                AddDamageRect(rects, curr.Bounds, display_rect);
+            continue;
+        }
+        if (!full_damage && (changed || prev_n < prev_max_n))
+        {
+            AddDamageRect(rects, prev->Bounds, display_rect);
+            AddDamageRect(rects, curr.Bounds, display_rect);
+        }
+        prev->DrawList = NULL; // Mark as matched
+        prev_max_n = ImMax(prev_max_n, prev_n);
+        search_start = prev_n + 1;
+    }
+    if (!full_damage)
+        for (const ImDrawDataDamageEntry& prev : prev_entries)
+            if (prev.DrawList != NULL)
+                AddDamageRect(rects, prev.Bounds, display_rect);
+
+    // Bucket rectangles into a grid over the display first, so merging pairs below stays cheap with many changed lists (e.g. child windows).
+    if (rects.Size > IM_DRAWDATA_DAMAGE_RECTS_MAX * 4)
+    {
+        const int grid_size = 4;
+        ImRect buckets[grid_size * grid_size];
+        for (ImRect& bucket : buckets)
+            bucket = ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        const ImVec2 cell_size(ImMax(display_rect.GetWidth(), 1.0f) / grid_size, ImMax(display_rect.GetHeight(), 1.0f) / grid_size);
+        for (const ImRect& r : rects)
+        {
+            const ImVec2 center = r.GetCenter();
+            const int cell_x = ImClamp((int)((center.x - display_rect.Min.x) / cell_size.x), 0, grid_size - 1);
+            const int cell_y = ImClamp((int)((center.y - display_rect.Min.y) / cell_size.y), 0, grid_size - 1);
+            buckets[cell_y * grid_size + cell_x].Add(r);
+        }
+        rects.resize(0);
+        for (const ImRect& bucket : buckets)
+            if (!bucket.IsInverted())
+                rects.push_back(bucket);
+    }
+
+    // Merge rectangles
+    while (rects.Size > 1)
+    {
+        int best_a = -1, best_b = -1;
+        float best_cost = FLT_MAX;
+        for (int a = 0; a < rects.Size && best_cost >= 0.0f; a++)
+            for (int b = a + 1; b < rects.Size; b++)
+            {
+                if (rects[a].Overlaps(rects[b]))
+                {
+                    best_a = a; best_b = b; best_cost = -1.0f;
+                    break;
+                }
+                ImRect merged = rects[a];
+                merged.Add(rects[b]);
+                const float cost = merged.GetArea() - rects[a].GetArea() - rects[b].GetArea();
+                if (cost < best_cost)
+                {
+                    best_a = a; best_b = b; best_cost = cost;
+                }
+            }
+        if (best_cost >= 0.0f && rects.Size <= IM_DRAWDATA_DAMAGE_RECTS_MAX)
+            break;
+        rects[best_a].Add(rects[best_b]);
+        rects.erase(rects.Data + best_b);
+    }
+
+    // Output, rounded outward to framebuffer pixels
+    const ImVec2 scale = draw_data->FramebufferScale;
+    draw_data->DamageRectsValid = true;
+    draw_data->DamageRects.resize(0);
+    for (const ImRect& r : rects)
+    {
+        ImVec4 out;
+        out.x = ImMax(display_rect.Min.x, display_rect.Min.x + ImFloor((r.Min.x - display_rect.Min.x) * scale.x) / scale.x);
+        out.y = ImMax(display_rect.Min.y, display_rect.Min.y + ImFloor((r.Min.y - display_rect.Min.y) * scale.y) / scale.y);
+        out.z = ImMin(display_rect.Max.x, display_rect.Min.x + ImCeil((r.Max.x - display_rect.Min.x) * scale.x) / scale.x);
+        out.w = ImMin(display_rect.Max.y, display_rect.Min.y + ImCeil((r.Max.y - display_rect.Min.y) * scale.y) / scale.y);
+        draw_data->DamageRects.push_back(out);
+    }
+
+    // Store state for next frame
+    prev_entries.swap(curr_entries);
+    builder->DamagePrevValid = true;
+    builder->DamagePrevDisplayPos = draw_data->DisplayPos;
+    builder->DamagePrevDisplaySize = draw_data->DisplaySize;
+    builder->DamagePrevFramebufferScale = draw_data->FramebufferScale;
 }
 
 // Push a clipping rectangle for both ImGui logic (hit-testing etc.) and low-level ImDrawList rendering.
@@ -5643,7 +6354,10 @@ static void ImGui::RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32
         if (draw_list->CmdBuffer.Size == 0)
             draw_list->AddDrawCmd();
         draw_list->PushClipRect(viewport_rect.Min - ImVec2(1, 1), viewport_rect.Max + ImVec2(1, 1), false); // FIXME: Need to stricty ensure ImDrawCmd are not merged (ElemCount==6 checks below will verify that)
+        const ImDrawListFlags backup_flags = draw_list->Flags;
+        draw_list->Flags &= ~ImDrawListFlags_RectInstances; // Always output vertices, as we move the last command
         draw_list->AddRectFilled(viewport_rect.Min, viewport_rect.Max, col);
+        draw_list->Flags = backup_flags;
         ImDrawCmd cmd = draw_list->CmdBuffer.back();
         IM_ASSERT(cmd.ElemCount == 6);
         draw_list->CmdBuffer.pop_back();
@@ -5687,6 +6401,7 @@ ImGuiWindow* ImGui::FindBottomMostVisibleWindowWithinBeginStack(ImGuiWindow* par
 static void ImGui::RenderDimmedBackgrounds()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("RenderDimmedBackgrounds");
     ImGuiWindow* modal_window = GetTopMostAndVisiblePopupModal();
     if (g.DimBgRatio <= 0.0f && g.NavWindowingHighlightAlpha <= 0.0f)
         return;
@@ -5751,6 +6466,7 @@ void ImGui::EndFrame()
     if (g.FrameCountEnded == g.FrameCount)
         return;
     IM_ASSERT(g.WithinFrameScope && "Forgot to call ImGui::NewFrame()?");
+    IMGUI_PROFILER_ZONE("EndFrame");
 
     CallContextHooks(&g, ImGuiContextHookType_EndFramePre);
 
@@ -5857,6 +6573,7 @@ void ImGui::Render()
     if (g.FrameCountRendered == g.FrameCount)
         return;
     g.FrameCountRendered = g.FrameCount;
+    IMGUI_PROFILER_ZONE("Render");
 
     g.IO.MetricsRenderWindows = 0;
     CallContextHooks(&g, ImGuiContextHookType_RenderPre);
@@ -5905,6 +6622,24 @@ void ImGui::Render()
         IM_ASSERT(draw_data->CmdLists.Size == draw_data->CmdListsCount);
         for (ImDrawList* draw_list : draw_data->CmdLists)
             draw_list->_PopUnusedDrawCmd();
+    }
+
+    // Write vertices of deferred text, for all viewports at once
+    ExpandViewportsTextRuns();
+
+    for (ImGuiViewportP* viewport : g.Viewports)
+    {
+        ImDrawData* draw_data = &viewport->DrawDataP;
+
+        // Compute areas which changed since last frame, if the renderer can make use of them
+        if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDamageRects)
+            UpdateViewportDrawDataDamage(viewport);
+        else
+            viewport->DrawDataBuilder.DamagePrevValid = false;
+
+        // Output alternate vertex/index formats, if the renderer can make use of them
+        if (g.IO.BackendFlags & (ImGuiBackendFlags_RendererHasVtxCompact | ImGuiBackendFlags_RendererHasIdx32))
+            BuildDrawDataAlternateBuffers(draw_data, (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxCompact) != 0, (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasIdx32) != 0);
 
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
@@ -5929,7 +6664,19 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    ImVec2 text_size;
+    ImDrawTextLayout* layout = NULL;
+    if (g.DrawListSharedData.InitialFlags & ImDrawListFlags_TextLayoutCache)
+    {
+        if (text_display_end == NULL)
+            text_display_end = text + strlen(text);
+        if (ImDrawTextLayoutCache::IsCacheable((int)(text_display_end - text), wrap_width))
+            layout = g.DrawListSharedData.TextLayoutCache.GetLayout(font, font_size, wrap_width, text, text_display_end);
+    }
+    if (layout != NULL)
+        text_size = layout->GetTextSize();
+    else
+        text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -6456,6 +7203,7 @@ static void InitOrLoadWindowSettings(ImGuiWindow* window, ImGuiWindowSettings* s
 
 static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Windows);
     // Create window the first time
     //IMGUI_DEBUG_LOG("CreateNewWindow '%s', flags = 0x%08X\n", name, flags);
     ImGuiContext& g = *GImGui;
@@ -7241,6 +7989,99 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
     }
 }
 
+// Is 'other_window' (e.g. hovered or focused window) part of the hierarchy of 'window', as far as refreshing goes?
+static bool IsWindowInRefreshScope(ImGuiWindow* window, ImGuiWindow* other_window)
+{
+    return other_window != NULL && (window->RootWindow == other_window->RootWindow || ImGui::IsWindowWithinBeginStackOf(other_window->RootWindow, window));
+}
+
+// Hash of g.Style, cached until the next NewFrame() or PushStyleXXX()/PopStyleXXX() call.
+// Hash fields around the padding after the bools, so copying the whole structure doesn't change the hash.
+// Style modified directly in the middle of a frame, without going through PushStyleXXX(), is only noticed on the next frame.
+static ImGuiID GetStyleHash()
+{
+    ImGuiContext& g = *GImGui;
+    if (g.StyleHash != 0)
+        return g.StyleHash;
+    const ImGuiStyle& style = g.Style;
+    const char* p0 = (const char*)&style;
+    const char* p1 = (const char*)&style.CurveTessellationTol;
+    const char* p2 = (const char*)(&style + 1);
+    const size_t scalars_size = offsetof(ImGuiStyle, AntiAliasedFill) + sizeof(style.AntiAliasedFill);
+    ImGuiID hash = ImHashDataFast(p0, scalars_size);
+    hash = ImHashDataFast(p1, (size_t)(p2 - p1), hash);
+    g.StyleHash = hash ? hash : 1;
+    return g.StyleHash;
+}
+
+// [EXPERIMENTAL] Hash everything that may change the output of a window whose contents are unchanged, for ImGuiWindowRefreshFlags_RefreshOnChange.
+// Return 0 when the window needs to be refreshed regardless (e.g. it owns the active id, or receives keyboard inputs).
+static ImGuiID CalcWindowRefreshInputsHash(ImGuiWindow* window, ImU32 content_version)
+{
+    ImGuiContext& g = *GImGui;
+    const bool hovered = IsWindowInRefreshScope(window, g.HoveredWindow);
+    const bool focused = IsWindowInRefreshScope(window, g.NavWindow);
+    if (IsWindowInRefreshScope(window, g.ActiveIdWindow) || IsWindowInRefreshScope(window, g.ActiveIdPreviousFrameWindow))
+        return 0;
+    if (hovered && g.HoverItemDelayIdPreviousFrame != 0) // Hover delays are timers updated by the items themselves
+        return 0;
+    if (g.DragDropActive && (hovered || IsWindowInRefreshScope(window, g.HoveredWindowUnderMovingWindow))) // Drop targets, including docking
+        return 0;
+    if (focused)
+        for (const ImGuiInputEvent& e : g.InputEventsTrail)
+            if (e.Type == ImGuiInputEventType_Key || e.Type == ImGuiInputEventType_Text)
+                return 0;
+
+    struct ImGuiWindowRefreshInputs
+    {
+        ImVec2              Pos, SizeFull, Scroll, ScrollTarget;
+        ImVec2              CursorMaxPos, IdealMaxPos;  // Extents of the last submitted contents: refresh until the layout is stable (e.g. scrollbars, auto-fit)
+        ImGuiWindowFlags    Flags;
+        ImFont*             Font;
+        float               FontSize;
+        ImVec2              MousePos;               // Mouse and hovered ids are only relevant when hovering the window
+        int                 MouseDownMask;
+        ImGuiID             HoveredId, HoveredIdPreviousFrame;
+        ImGuiID             ActiveId;               // An active item in another window blocks hovering
+        ImGuiWindow*        WheelingWindow;         // Locks hovering while scrolling
+        ImGuiID             NavId;                  // Only relevant when focused
+        bool                Collapsed, Hovered, Focused, NavCursorVisible;
+    };
+    ImGuiWindowRefreshInputs inputs;
+    memset(&inputs, 0, sizeof(inputs)); // Clear padding bytes as we hash the whole structure
+    inputs.Pos = window->Pos;
+    inputs.SizeFull = window->SizeFull;
+    inputs.Scroll = window->Scroll;
+    inputs.ScrollTarget = window->ScrollTarget;
+    inputs.CursorMaxPos = window->DC.CursorMaxPos;
+    inputs.IdealMaxPos = window->DC.IdealMaxPos;
+    inputs.Flags = window->Flags;
+    inputs.Font = g.Font;
+    inputs.FontSize = g.FontSize;
+    inputs.Collapsed = window->Collapsed;
+    inputs.Hovered = hovered;
+    inputs.Focused = focused;
+    if (hovered)
+    {
+        inputs.MousePos = g.IO.MousePos;
+        for (int n = 0; n < IM_ARRAYSIZE(g.IO.MouseDown); n++)
+            if (g.IO.MouseDown[n])
+                inputs.MouseDownMask |= 1 << n;
+        inputs.HoveredId = g.HoveredId;
+        inputs.HoveredIdPreviousFrame = g.HoveredIdPreviousFrame;
+        inputs.WheelingWindow = g.WheelingWindow;
+        inputs.ActiveId = g.ActiveId;
+    }
+    if (focused)
+    {
+        inputs.NavId = g.NavId;
+        inputs.NavCursorVisible = g.NavCursorVisible;
+    }
+    const ImGuiID style_hash = GetStyleHash();
+    const ImGuiID hash = ImHashDataFast(&inputs, sizeof(inputs), ((ImU64)style_hash << 32) | content_version);
+    return hash ? hash : 1;
+}
+
 // [EXPERIMENTAL] Called by Begin(). NextWindowData is valid at this point.
 // This is designed as a toy/test-bed for
 void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
@@ -7249,19 +8090,28 @@ void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
     window->SkipRefresh = false;
     if ((g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasRefreshPolicy) == 0)
         return;
-    if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_TryToAvoidRefresh)
+    if (g.NextWindowData.RefreshFlagsVal & (ImGuiWindowRefreshFlags_TryToAvoidRefresh | ImGuiWindowRefreshFlags_RefreshOnChange))
     {
+        // With RefreshOnChange, store the hash before any early out so a change is always followed by a refresh.
+        // A forced refresh stores 0 so we also refresh on the following frame (e.g. to display the effect of a key press).
+        if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnChange)
+        {
+            const ImGuiID inputs_hash = CalcWindowRefreshInputsHash(window, g.NextWindowData.RefreshContentVersionVal);
+            const bool inputs_changed = (inputs_hash == 0 || inputs_hash != window->RefreshInputsHash);
+            window->RefreshInputsHash = inputs_hash;
+            if (inputs_changed)
+                return;
+        }
+
         // FIXME-IDLE: Tests for e.g. mouse clicks or keyboard while focused.
         if (window->Appearing) // If currently appearing
             return;
         if (window->Hidden) // If was hidden (previous frame)
             return;
-        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnHover) && g.HoveredWindow)
-            if (window->RootWindow == g.HoveredWindow->RootWindow || IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window))
-                return;
-        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnFocus) && g.NavWindow)
-            if (window->RootWindow == g.NavWindow->RootWindow || IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window))
-                return;
+        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnHover) && IsWindowInRefreshScope(window, g.HoveredWindow))
+            return;
+        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnFocus) && IsWindowInRefreshScope(window, g.NavWindow))
+            return;
         window->DrawList = NULL;
         window->SkipRefresh = true;
     }
@@ -7324,6 +8174,7 @@ ImGuiWindow* ImGui::FindBlockingModal(ImGuiWindow* window)
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Windows);
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
     IM_ASSERT(g.WithinFrameScope);                  // Forgot to call ImGui::NewFrame()
@@ -7334,6 +8185,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     const bool window_just_created = (window == NULL);
     if (window_just_created)
         window = CreateNewWindow(name, flags);
+    IMGUI_PROFILER_ZONE_WINDOW("Begin", window);
 
     // [DEBUG] Debug break requested by user
     if (g.DebugBreakInWindow == window->ID)
@@ -7438,6 +8290,11 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         UpdateWindowParentAndRootLinks(window, flags, parent_window);
         window->ParentWindowInBeginStack = parent_window_in_stack;
 
+        // [EXPERIMENTAL] Skip Refresh mode: a window submitting other root windows (e.g. tooltips, popups) can't skip refreshing while it does so.
+        if (parent_window_in_stack && window->RootWindow == window && !window->DockIsActive)
+            for (ImGuiWindow* w = parent_window_in_stack; w != NULL; w = w->ParentWindow)
+                w->RefreshInputsHash = 0;
+
         // Focus route
         // There's little point to expose a flag to set this: because the interesting cases won't be using parent_window_in_stack,
         // Use for e.g. linking a tool window in a standalone viewport to a document window, regardless of their Begin() stack parenting. (#6798)
@@ -7974,8 +8831,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 // - We disable this when the parent window has zero vertices, which is a common pattern leading to laying out multiple overlapping childs
                 ImGuiWindow* previous_child = parent_window->DC.ChildWindows.Size >= 2 ? parent_window->DC.ChildWindows[parent_window->DC.ChildWindows.Size - 2] : NULL;
                 bool previous_child_overlapping = previous_child ? previous_child->Rect().Overlaps(window->Rect()) : false;
-                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0);
-                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && !parent_is_empty && !previous_child_overlapping)
+                bool parent_is_empty = (parent_window->DrawList->VtxBuffer.Size == 0 && parent_window->DrawList->RectInstBuffer.Size == 0);
+                if (window->DrawList->CmdBuffer.back().ElemCount == 0 && window->DrawList->RectInstBuffer.Size == 0 && !parent_is_empty && !previous_child_overlapping)
                     render_decorations_in_parent = true;
             }
             if (render_decorations_in_parent)
@@ -8257,6 +9114,7 @@ static void ImGui::SetLastItemDataForWindow(ImGuiWindow* window, const ImRect& r
 void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Windows);
     ImGuiWindow* window = g.CurrentWindow;
 
     // Error checking: verify that user hasn't called End() too many times!
@@ -8266,6 +9124,7 @@ void ImGui::End()
         return;
     }
     ImGuiWindowStackData& window_stack_data = g.CurrentWindowStack.back();
+    IMGUI_PROFILER_ZONE_WINDOW("End", window);
 
     // Error checking: verify that user doesn't directly call End() on a child window.
     if ((window->Flags & ImGuiWindowFlags_ChildWindow) && !(window->Flags & ImGuiWindowFlags_DockNodeHost) && !window->DockIsActive)
@@ -9076,11 +9935,13 @@ void ImGui::SetNextWindowClass(const ImGuiWindowClass* window_class)
 }
 
 // This is experimental and meant to be a toy for exploring a future/wider range of features.
-void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags)
+// With ImGuiWindowRefreshFlags_RefreshOnChange, bump 'content_version' whenever the data displayed by the window changes.
+void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags, ImU32 content_version)
 {
     ImGuiContext& g = *GImGui;
     g.NextWindowData.Flags |= ImGuiNextWindowDataFlags_HasRefreshPolicy;
     g.NextWindowData.RefreshFlagsVal = flags;
+    g.NextWindowData.RefreshContentVersionVal = content_version;
 }
 
 ImDrawList* ImGui::GetWindowDrawList()
@@ -9298,6 +10159,19 @@ ImGuiID ImGuiWindow::GetID(const char* str, const char* str_end)
     return id;
 }
 
+ImGuiID ImGuiWindow::GetID(const ImGuiLiteralID& lit_id)
+{
+    ImGuiID seed = IDStack.back();
+    ImGuiID id = ImHashLiteral(lit_id, seed);
+    IM_ASSERT_PARANOID(id == ImHashStr(lit_id.Str, lit_id.StrEnd - lit_id.Str, seed));
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+    ImGuiContext& g = *Ctx;
+    if (g.DebugHookIdInfo == id)
+        ImGui::DebugHookIdInfo(id, ImGuiDataType_String, lit_id.Str, lit_id.StrEnd);
+#endif
+    return id;
+}
+
 ImGuiID ImGuiWindow::GetID(const void* ptr)
 {
     ImGuiID seed = IDStack.back();
@@ -9357,6 +10231,14 @@ void ImGui::PushID(const char* str_id_begin, const char* str_id_end)
     window->IDStack.push_back(id);
 }
 
+void ImGui::PushID(const ImGuiLiteralID& lit_id)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiID id = window->GetID(lit_id);
+    window->IDStack.push_back(id);
+}
+
 void ImGui::PushID(const void* ptr_id)
 {
     ImGuiContext& g = *GImGui;
@@ -9433,6 +10315,12 @@ ImGuiID ImGui::GetID(const char* str_id_begin, const char* str_id_end)
     return window->GetID(str_id_begin, str_id_end);
 }
 
+ImGuiID ImGui::GetID(const ImGuiLiteralID& lit_id)
+{
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    return window->GetID(lit_id);
+}
+
 ImGuiID ImGui::GetID(const void* ptr_id)
 {
     ImGuiWindow* window = GImGui->CurrentWindow;
@@ -10218,6 +11106,7 @@ static ImGuiKeyChord GetMergedModsFromKeys()
 static void ImGui::UpdateKeyboardInputs()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateKeyboardInputs");
     ImGuiIO& io = g.IO;
 
     if (io.ConfigFlags & ImGuiConfigFlags_NoKeyboard)
@@ -10285,6 +11174,7 @@ static void ImGui::UpdateKeyboardInputs()
 static void ImGui::UpdateMouseInputs()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateMouseInputs");
     ImGuiIO& io = g.IO;
 
     // Mouse Wheel swapping flag
@@ -10420,6 +11310,7 @@ static ImGuiWindow* FindBestWheelingWindow(const ImVec2& wheel)
 // Called by NewFrame()
 void ImGui::UpdateMouseWheel()
 {
+    IMGUI_PROFILER_ZONE("UpdateMouseWheel");
     // Reset the locked window if we move the mouse or after the timer elapses.
     // FIXME: Ideally we could refactor to have one timer for "changing window w/ same axis" and a shorter timer for "changing window or axis w/ other axis" (#3795)
     ImGuiContext& g = *GImGui;
@@ -10551,6 +11442,7 @@ static void DebugPrintInputEvent(const char* prefix, const ImGuiInputEvent* e)
 void ImGui::UpdateInputEvents(bool trickle_fast_inputs)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateInputEvents");
     ImGuiIO& io = g.IO;
 
     // Only trickle chars<>key when working with InputText()
@@ -13452,6 +14344,7 @@ float ImGui::GetNavTweakPressedAmount(ImGuiAxis axis)
 static void ImGui::NavUpdate()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("NavUpdate");
     ImGuiIO& io = g.IO;
 
     io.WantSetMousePos = false;
@@ -14069,6 +14962,7 @@ static float ImGui::NavUpdatePageUpPageDown()
 static void ImGui::NavEndFrame()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("NavEndFrame");
 
     // Show CTRL+TAB list window
     if (g.NavWindowingTarget != NULL)
@@ -15068,6 +15962,8 @@ void ImGui::LogButtons()
 // Called by NewFrame()
 void ImGui::UpdateSettings()
 {
+    IMGUI_PROFILER_ZONE("UpdateSettings");
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     // Load settings on first frame (if not explicitly loaded manually before)
     ImGuiContext& g = *GImGui;
     if (!g.SettingsLoaded)
@@ -15111,6 +16007,7 @@ void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 void ImGui::AddSettingsHandler(const ImGuiSettingsHandler* handler)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     IM_ASSERT(FindSettingsHandler(handler->TypeName) == NULL);
     g.SettingsHandlers.push_back(*handler);
 }
@@ -15158,6 +16055,7 @@ void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
 void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     IM_ASSERT(g.Initialized);
     //IM_ASSERT(!g.WithinFrameScope && "Cannot be called between NewFrame() and EndFrame()");
     //IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
@@ -15245,6 +16143,7 @@ void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     g.SettingsDirtyTimer = 0.0f;
     g.SettingsIniData.Buf.resize(0);
     g.SettingsIniData.Buf.push_back(0);
@@ -15258,6 +16157,7 @@ const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
 
     if (g.IO.ConfigDebugIniSettings == false)
     {
@@ -15643,6 +16543,7 @@ ImGuiViewportP* ImGui::FindHoveredViewportFromPlatformWindowStack(const ImVec2&
 static void ImGui::UpdateViewportsNewFrame()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateViewportsNewFrame");
     IM_ASSERT(g.PlatformIO.Viewports.Size <= g.Viewports.Size);
 
     // Update Minimized status (we need it first in order to decide if we'll apply Pos/Size of the main viewport)
@@ -15886,6 +16787,7 @@ static void ImGui::UpdateViewportsNewFrame()
 static void ImGui::UpdateViewportsEndFrame()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateViewportsEndFrame");
     g.PlatformIO.Viewports.resize(0);
     for (int i = 0; i < g.Viewports.Size; i++)
     {
@@ -16684,6 +17586,7 @@ namespace ImGui
 void ImGui::DockContextInitialize(ImGuiContext* ctx)
 {
     ImGuiContext& g = *ctx;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
 
     // Add .ini handle for persistent docking data
     ImGuiSettingsHandler ini_handler;
@@ -16721,6 +17624,7 @@ void ImGui::DockContextClearNodes(ImGuiContext* ctx, ImGuiID root_id, bool clear
 void ImGui::DockContextRebuildNodes(ImGuiContext* ctx)
 {
     ImGuiContext& g = *ctx;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     ImGuiDockContext* dc = &ctx->DockContext;
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockContextRebuildNodes\n");
     SaveIniSettingsToMemory();
@@ -16734,6 +17638,8 @@ void ImGui::DockContextRebuildNodes(ImGuiContext* ctx)
 void ImGui::DockContextNewFrameUpdateUndocking(ImGuiContext* ctx)
 {
     ImGuiContext& g = *ctx;
+    IMGUI_PROFILER_ZONE("DockContextNewFrameUpdateUndocking");
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     ImGuiDockContext* dc = &ctx->DockContext;
     if (!(g.IO.ConfigFlags & ImGuiConfigFlags_DockingEnable))
     {
@@ -16777,6 +17683,8 @@ void ImGui::DockContextNewFrameUpdateUndocking(ImGuiContext* ctx)
 void ImGui::DockContextNewFrameUpdateDocking(ImGuiContext* ctx)
 {
     ImGuiContext& g = *ctx;
+    IMGUI_PROFILER_ZONE("DockContextNewFrameUpdateDocking");
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     ImGuiDockContext* dc = &ctx->DockContext;
     if (!(g.IO.ConfigFlags & ImGuiConfigFlags_DockingEnable))
         return;
@@ -16809,6 +17717,8 @@ void ImGui::DockContextNewFrameUpdateDocking(ImGuiContext* ctx)
 
 void ImGui::DockContextEndFrame(ImGuiContext* ctx)
 {
+    IMGUI_PROFILER_ZONE("DockContextEndFrame");
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     // Draw backgrounds of node missing their window
     ImGuiContext& g = *ctx;
     ImGuiDockContext* dc = &g.DockContext;
@@ -17067,6 +17977,7 @@ void ImGui::DockContextQueueNotifyRemovedNode(ImGuiContext* ctx, ImGuiDockNode*
 
 void ImGui::DockContextProcessDock(ImGuiContext* ctx, ImGuiDockRequest* req)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     IM_ASSERT((req->Type == ImGuiDockRequestType_Dock && req->DockPayload != NULL) || (req->Type == ImGuiDockRequestType_Split && req->DockPayload == NULL));
     IM_ASSERT(req->DockTargetWindow != NULL || req->DockTargetNode != NULL);
 
@@ -17229,6 +18140,7 @@ static ImVec2 FixLargeWindowsWhenUndocking(const ImVec2& size, ImGuiViewport* re
 void ImGui::DockContextProcessUndockWindow(ImGuiContext* ctx, ImGuiWindow* window, bool clear_persistent_docking_ref)
 {
     ImGuiContext& g = *ctx;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockContextProcessUndockWindow window '%s', clear_persistent_docking_ref = %d\n", window->Name, clear_persistent_docking_ref);
     if (window->DockNode)
         DockNodeRemoveWindow(window->DockNode, window, clear_persistent_docking_ref ? 0 : window->DockId);
@@ -19297,6 +20209,7 @@ void ImGui::SetWindowDock(ImGuiWindow* window, ImGuiID dock_id, ImGuiCond cond)
 ImGuiID ImGui::DockSpace(ImGuiID dockspace_id, const ImVec2& size_arg, ImGuiDockNodeFlags flags, const ImGuiWindowClass* window_class)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     ImGuiWindow* window = GetCurrentWindowRead();
     if (!(g.IO.ConfigFlags & ImGuiConfigFlags_DockingEnable))
         return 0;
@@ -19467,6 +20380,7 @@ ImGuiID ImGui::DockSpaceOverViewport(ImGuiID dockspace_id, const ImGuiViewport*
 
 void ImGui::DockBuilderDockWindow(const char* window_name, ImGuiID node_id)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     // We don't preserve relative order of multiple docked windows (by clearing DockOrder back to -1)
     ImGuiContext& g = *GImGui; IM_UNUSED(g);
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockBuilderDockWindow '%s' to node 0x%08X\n", window_name, node_id);
@@ -19528,6 +20442,7 @@ void ImGui::DockBuilderSetNodeSize(ImGuiID node_id, ImVec2 size)
 ImGuiID ImGui::DockBuilderAddNode(ImGuiID node_id, ImGuiDockNodeFlags flags)
 {
     ImGuiContext& g = *GImGui; IM_UNUSED(g);
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockBuilderAddNode 0x%08X flags=%08X\n", node_id, flags);
 
     if (node_id != 0)
@@ -19551,6 +20466,7 @@ ImGuiID ImGui::DockBuilderAddNode(ImGuiID node_id, ImGuiDockNodeFlags flags)
 void ImGui::DockBuilderRemoveNode(ImGuiID node_id)
 {
     ImGuiContext& g = *GImGui; IM_UNUSED(g);
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockBuilderRemoveNode 0x%08X\n", node_id);
 
     ImGuiDockNode* node = DockContextFindNodeByID(&g, node_id);
@@ -19678,6 +20594,7 @@ void ImGui::DockBuilderRemoveNodeDockedWindows(ImGuiID root_id, bool clear_setti
 ImGuiID ImGui::DockBuilderSplitNode(ImGuiID id, ImGuiDir split_dir, float size_ratio_for_node_at_dir, ImGuiID* out_id_at_dir, ImGuiID* out_id_at_opposite_dir)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     IM_ASSERT(split_dir != ImGuiDir_None);
     IMGUI_DEBUG_LOG_DOCKING("[docking] DockBuilderSplitNode: node 0x%08X, split_dir %d\n", id, split_dir);
 
@@ -19791,6 +20708,7 @@ void ImGui::DockBuilderCopyWindowSettings(const char* src_name, const char* dst_
 void ImGui::DockBuilderCopyDockSpace(ImGuiID src_dockspace_id, ImGuiID dst_dockspace_id, ImVector<const char*>* in_window_remap_pairs)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     IM_ASSERT(src_dockspace_id != 0);
     IM_ASSERT(dst_dockspace_id != 0);
     IM_ASSERT(in_window_remap_pairs != NULL);
@@ -19871,6 +20789,7 @@ void ImGui::DockBuilderCopyDockSpace(ImGuiID src_dockspace_id, ImGuiID dst_docks
 void ImGui::DockBuilderFinish(ImGuiID root_id)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
     //DockContextRebuild(&g);
     DockContextBuildAddWindowsToNodes(&g, root_id);
 }
@@ -19948,6 +20867,7 @@ static void StoreDockStyleForWindow(ImGuiWindow* window)
 void ImGui::BeginDocked(ImGuiWindow* window, bool* p_open)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
 
     // Clear fields ahead so most early-out paths don't have to do it
     window->DockIsActive = window->DockNodeIsVisible = window->DockTabIsVisible = false;
@@ -20106,6 +21026,7 @@ void ImGui::BeginDockableDragDropSource(ImGuiWindow* window)
 void ImGui::BeginDockableDragDropTarget(ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Docking);
 
     //IM_ASSERT(window->RootWindowDockTree == window); // May also be a DockSpace
     IM_ASSERT((window->Flags & ImGuiWindowFlags_NoDocking) == 0);
@@ -20636,6 +21557,218 @@ static void Platform_SetImeDataFn_DefaultImpl(ImGuiContext*, ImGuiViewport*, ImG
 
 #endif // Default IME handlers
 
+//-----------------------------------------------------------------------------
+// [SECTION] PROFILER
+//-----------------------------------------------------------------------------
+// - ProfilerGetTicks() [Internal]
+// - ProfilerNewFrame() [Internal]
+// - ProfilerZoneBegin() [Internal]
+// - ProfilerZoneEnd() [Internal]
+// - ProfilerGetCompletedFrame() [Internal]
+// - ProfilerFormatZoneName() [Internal]
+// - ProfilerExportChromeTrace() [Internal]
+// - ProfilerSaveChromeTrace() [Internal]
+//-----------------------------------------------------------------------------
+
+#ifdef IMGUI_ENABLE_PROFILER
+
+// OS monotonic clock
+static ImU64 ProfilerGetClockTicks()
+{
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    LARGE_INTEGER counter;
+    ::QueryPerformanceCounter(&counter);
+    return (ImU64)counter.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ImU64)ts.tv_sec * 1000000000 + (ImU64)ts.tv_nsec;
+#else
+    return (ImU64)clock();
+#endif
+}
+
+static ImU64 ProfilerGetClockTicksPerSecond()
+{
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    LARGE_INTEGER frequency;
+    ::QueryPerformanceFrequency(&frequency);
+    return (ImU64)frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    return 1000000000;
+#else
+    return CLOCKS_PER_SEC;
+#endif
+}
+
+// Clock for profiler zones.
+// On x86 we read the time-stamp counter, which is several times cheaper than the OS clock, and calibrate it against the OS clock in ProfilerNewFrame().
+// This assumes an invariant TSC (constant rate across power states), which x86 CPUs have had for about 15 years.
+static inline ImU64 ProfilerGetTicks()
+{
+#ifdef IMGUI_PROFILER_USE_RDTSC
+    return (ImU64)__rdtsc();
+#else
+    return ProfilerGetClockTicks();
+#endif
+}
+
+// Called at the very beginning of NewFrame(). Whether the frame is recorded is decided here, so zones are balanced within a frame.
+void ImGui::ProfilerNewFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler* profiler = &g.Profiler;
+    profiler->ZonesStack.resize(0);
+    profiler->FrameRecording = profiler->Enabled && !profiler->Paused;
+    profiler->FrameRecordingWindows = profiler->FrameRecording && profiler->WindowZones;
+    if (!profiler->Enabled)
+        return;
+
+    // Calibrate ticks against the OS clock, refining the estimate as time passes
+#ifdef IMGUI_PROFILER_USE_RDTSC
+    const ImU64 ticks = ProfilerGetTicks();
+    const ImU64 clock_ticks = ProfilerGetClockTicks();
+    if (profiler->CalibrationClockTicks == 0)
+    {
+        profiler->CalibrationTicks = ticks;
+        profiler->CalibrationClockTicks = clock_ticks;
+    }
+    else if (clock_ticks > profiler->CalibrationClockTicks)
+    {
+        profiler->TicksPerSecond = (ImU64)((double)(ticks - profiler->CalibrationTicks) * (double)ProfilerGetClockTicksPerSecond() / (double)(clock_ticks - profiler->CalibrationClockTicks));
+    }
+#else
+    profiler->TicksPerSecond = ProfilerGetClockTicksPerSecond();
+#endif
+    if (!profiler->FrameRecording)
+        return;
+
+    profiler->FrameIdx = (profiler->FrameIdx + 1) % IMGUI_PROFILER_FRAMES_COUNT;
+    profiler->FramesCount = ImMin(profiler->FramesCount + 1, IMGUI_PROFILER_FRAMES_COUNT);
+    ImGuiProfilerFrame* frame = &profiler->Frames[profiler->FrameIdx];
+    frame->FrameCount = g.FrameCount + 1; // NewFrame() increments it right after
+    frame->Zones.resize(0);
+    frame->TicksStart = frame->TicksEnd = ProfilerGetTicks();
+}
+
+bool ImGui::ProfilerZoneBegin(const char* name, ImGuiID window_id)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler* profiler = &g.Profiler;
+    ImGuiProfilerFrame* frame = &profiler->Frames[profiler->FrameIdx];
+    if (!profiler->FrameRecording || frame->Zones.Size >= IMGUI_PROFILER_ZONES_PER_FRAME_MAX)
+        return false;
+
+    profiler->ZonesStack.push_back(frame->Zones.Size);
+    frame->Zones.resize(frame->Zones.Size + 1);
+    ImGuiProfilerZone* zone = &frame->Zones.back();
+    zone->Name = name;
+    zone->WindowID = window_id;
+    zone->Depth = profiler->ZonesStack.Size - 1;
+    zone->TicksEnd = 0;
+    zone->TicksStart = ProfilerGetTicks(); // Last, so bookkeeping is not counted in the zone
+    return true;
+}
+
+void ImGui::ProfilerZoneEnd()
+{
+    const ImU64 ticks = ProfilerGetTicks();
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler* profiler = &g.Profiler;
+    if (profiler->ZonesStack.Size == 0)
+        return;
+    ImGuiProfilerFrame* frame = &profiler->Frames[profiler->FrameIdx];
+    frame->Zones[profiler->ZonesStack.back()].TicksEnd = ticks;
+    profiler->ZonesStack.pop_back();
+    if (profiler->ZonesStack.Size == 0)
+        frame->TicksEnd = ticks;
+}
+
+// n = 0: most recent completed frame. The frame being recorded is not returned.
+static ImGuiProfilerFrame* ProfilerGetCompletedFrame(ImGuiProfiler* profiler, int n)
+{
+    const int recording_count = profiler->FrameRecording ? 1 : 0;
+    if (n < 0 || n >= profiler->FramesCount - recording_count)
+        return NULL;
+    return &profiler->Frames[(profiler->FrameIdx - recording_count - n + IMGUI_PROFILER_FRAMES_COUNT * 2) % IMGUI_PROFILER_FRAMES_COUNT];
+}
+
+static void ProfilerFormatZoneName(char* buf, size_t buf_size, const ImGuiProfilerZone* zone)
+{
+    if (zone->WindowID == 0)
+    {
+        ImStrncpy(buf, zone->Name, buf_size);
+        return;
+    }
+    if (ImGuiWindow* window = ImGui::FindWindowByID(zone->WindowID))
+        ImFormatString(buf, buf_size, "%s: %s", zone->Name, window->Name);
+    else
+        ImFormatString(buf, buf_size, "%s: 0x%08X", zone->Name, zone->WindowID);
+}
+
+static void ProfilerAppendJsonString(ImGuiTextBuffer* buf, const char* str)
+{
+    buf->append("\"");
+    for (const char* p = str; *p; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            buf->appendf("\\%c", *p);
+        else if ((unsigned char)*p < 0x20)
+            buf->appendf("\\u%04x", (unsigned int)(unsigned char)*p);
+        else
+            buf->append(p, p + 1);
+    }
+    buf->append("\"");
+}
+
+// Completed frames in the ring, oldest first, as Chrome Trace Event Format "complete" events (timestamps in microseconds).
+// Load the output in chrome://tracing or https://ui.perfetto.dev
+void ImGui::ProfilerExportChromeTrace(ImGuiTextBuffer* out_buf)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfiler* profiler = &g.Profiler;
+    const double us_per_tick = profiler->TicksPerSecond ? 1000000.0 / (double)profiler->TicksPerSecond : 0.0;
+    ImU64 ticks_origin = 0;
+    char name[256];
+    out_buf->append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (int n = profiler->FramesCount - 1; n >= 0; n--)
+    {
+        const ImGuiProfilerFrame* frame = ProfilerGetCompletedFrame(profiler, n);
+        if (frame == NULL)
+            continue;
+        const bool first_frame = (ticks_origin == 0);
+        if (first_frame)
+            ticks_origin = frame->TicksStart;
+        out_buf->appendf("%s\n{\"name\":\"Frame %d\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}", first_frame ? "" : ",",
+            frame->FrameCount, (frame->TicksStart - ticks_origin) * us_per_tick, (frame->TicksEnd - frame->TicksStart) * us_per_tick);
+        for (const ImGuiProfilerZone& zone : frame->Zones)
+        {
+            if (zone.TicksEnd == 0)
+                continue;
+            ProfilerFormatZoneName(name, IM_ARRAYSIZE(name), &zone);
+            out_buf->append(",\n{\"name\":");
+            ProfilerAppendJsonString(out_buf, name);
+            out_buf->appendf(",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}", zone.WindowID ? "window" : "imgui",
+                (zone.TicksStart - ticks_origin) * us_per_tick, (zone.TicksEnd - zone.TicksStart) * us_per_tick);
+        }
+    }
+    out_buf->append("\n]}\n");
+}
+
+bool ImGui::ProfilerSaveChromeTrace(const char* filename)
+{
+    ImGuiTextBuffer buf;
+    ProfilerExportChromeTrace(&buf);
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    ImFileWrite(buf.c_str(), sizeof(char), (ImU64)buf.size(), f);
+    ImFileClose(f);
+    return true;
+}
+
+#endif // #ifdef IMGUI_ENABLE_PROFILER
+
 //-----------------------------------------------------------------------------
 // [SECTION] METRICS/DEBUGGER WINDOW
 //-----------------------------------------------------------------------------
@@ -20651,6 +21784,7 @@ static void Platform_SetImeDataFn_DefaultImpl(ImGuiContext*, ImGuiViewport*, ImG
 // - DebugNodeDrawCmdShowMeshAndBoundingBox() [Internal]
 // - DebugNodeFont() [Internal]
 // - DebugNodeFontGlyph() [Internal]
+// - DebugNodeProfiler() [Internal]
 // - DebugNodeStorage() [Internal]
 // - DebugNodeTabBar() [Internal]
 // - DebugNodeViewport() [Internal]
@@ -20981,6 +22115,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         SameLine();
         MetricsHelpMarker("You can also call ImGui::ShowIDStackToolWindow() from your code.");
 
+        Checkbox("Use scalar ImDrawList primitives (disable SIMD kernels)", &g.DrawListSharedData.UseScalarKernels);
         Checkbox("Show windows begin order", &cfg->ShowWindowsBeginOrder);
         Checkbox("Show windows rectangles", &cfg->ShowWindowsRects);
         SameLine();
@@ -21327,6 +22462,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     {
         ImGuiDebugAllocInfo* info = &g.DebugAllocInfo;
         Text("%d current allocations", info->TotalAllocCount - info->TotalFreeCount);
+        Text("Frame arena: %d bytes used this frame, %d bytes reserved", g.FrameArena.size(), g.FrameArena.capacity());
         if (SmallButton("GC now")) { g.GcCompactAll = true; }
         Text("Recent frames with allocations:");
         int buf_size = IM_ARRAYSIZE(info->LastEntriesBuf);
@@ -21340,9 +22476,49 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 Text("<- %d frames ago", g.FrameCount - entry->FrameCount);
             }
         }
+
+        // Per-subsystem accounting (opt-in, requires a 16-bytes header on each block)
+        Text("Allocations per subsystem:");
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+        if (SmallButton("Reset peaks"))
+            DebugResetAllocTagPeaks();
+        if (BeginTable("##alloctags", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            TableSetupColumn("Tag");
+            TableSetupColumn("Live bytes");
+            TableSetupColumn("Live allocs");
+            TableSetupColumn("Peak bytes");
+            TableSetupColumn("Allocs/frame");
+            TableSetupColumn("Bytes/frame");
+            TableSetupColumn("Frees/frame");
+            TableHeadersRow();
+            for (int tag_n = 0; tag_n < ImGuiAllocTag_COUNT; tag_n++)
+            {
+                const ImGuiDebugAllocTagInfo* tag_info = DebugGetAllocTagInfo((ImGuiAllocTag)tag_n);
+                TableNextColumn(); TextUnformatted(DebugGetAllocTagName((ImGuiAllocTag)tag_n));
+                TableNextColumn(); Text("%lld", (long long)tag_info->LiveBytes);
+                TableNextColumn(); Text("%d", tag_info->LiveCount);
+                TableNextColumn(); Text("%lld", (long long)tag_info->PeakBytes);
+                TableNextColumn(); Text("%d", tag_info->LastFrameAllocCount);
+                TableNextColumn(); Text("%lld", (long long)tag_info->LastFrameAllocBytes);
+                TableNextColumn(); Text("%d", tag_info->LastFrameFreeCount);
+            }
+            EndTable();
+        }
+#else
+        TextDisabled("Define IMGUI_ENABLE_ALLOC_TAGS in imconfig.h to enable.");
+#endif
         TreePop();
     }
 
+#ifdef IMGUI_ENABLE_PROFILER
+    if (TreeNode("Profiler"))
+    {
+        DebugNodeProfiler(&g.Profiler);
+        TreePop();
+    }
+#endif
+
     if (TreeNode("Inputs"))
     {
         Text("KEYBOARD/GAMEPAD/MOUSE KEYS");
@@ -21750,6 +22926,8 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
 
     if (window && !window->WasActive)
         TextDisabled("Warning: owning Window is inactive. This DrawList is not being rendered!");
+    if (draw_list->_TextRuns.Size > 0)
+        TextDisabled("%d deferred text runs: their vertices will be written by Render().", draw_list->_TextRuns.Size);
 
     for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.Data; pcmd < draw_list->CmdBuffer.Data + cmd_count; pcmd++)
     {
@@ -21758,6 +22936,14 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
             BulletText("Callback %p, user_data %p", pcmd->UserCallback, pcmd->UserCallbackData);
             continue;
         }
+        if (pcmd->RectInstCount > 0)
+        {
+            BulletText("RectInstances:%5d, ClipRect (%4.0f,%4.0f)-(%4.0f,%4.0f)", pcmd->RectInstCount, pcmd->ClipRect.x, pcmd->ClipRect.y, pcmd->ClipRect.z, pcmd->ClipRect.w);
+            if (IsItemHovered() && fg_draw_list)
+                for (const ImDrawRectInstance* inst = draw_list->RectInstBuffer.Data + pcmd->RectInstOffset; inst < draw_list->RectInstBuffer.Data + pcmd->RectInstOffset + pcmd->RectInstCount; inst++)
+                    fg_draw_list->AddRect(inst->Min, inst->Max, IM_COL32(255, 255, 0, 255));
+            continue;
+        }
 
         char texid_desc[20];
         FormatTextureIDForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), pcmd->TextureId);
@@ -21950,6 +23136,158 @@ void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
     Text("UV: (%.3f,%.3f)->(%.3f,%.3f)", glyph->U0, glyph->V0, glyph->U1, glyph->V1);
 }
 
+#ifdef IMGUI_ENABLE_PROFILER
+static int IMGUI_CDECL ProfilerZoneStatsComparerByTotal(const void* lhs, const void* rhs)
+{
+    const double a = ((const ImGuiProfilerZoneStats*)lhs)->TotalMs;
+    const double b = ((const ImGuiProfilerZoneStats*)rhs)->TotalMs;
+    return (a < b) ? +1 : (a > b) ? -1 : 0;
+}
+
+// [DEBUG] Display profiler frames: flame graph of one frame + averages over all frames in the ring
+void ImGui::DebugNodeProfiler(ImGuiProfiler* profiler)
+{
+    ImGuiContext& g = *GImGui;
+    Checkbox("Enabled", &profiler->Enabled);
+    SameLine();
+    Checkbox("Paused", &profiler->Paused);
+    SameLine();
+    Checkbox("Per-window zones", &profiler->WindowZones);
+    SetItemTooltip("Record Begin()/End() of every window.\nThis is most of the profiler overhead when there are many windows.");
+    SameLine();
+    if (Button("Export trace"))
+        ProfilerSaveChromeTrace("imgui_trace.json");
+    SetItemTooltip("Save recorded frames to imgui_trace.json\n(Chrome Trace Event format: open in chrome://tracing or ui.perfetto.dev)");
+
+    int completed_count = 0;
+    while (ProfilerGetCompletedFrame(profiler, completed_count) != NULL)
+        completed_count++;
+    if (completed_count == 0 || profiler->TicksPerSecond == 0)
+    {
+        TextDisabled("No frames recorded.");
+        return;
+    }
+    const double ms_per_tick = 1000.0 / (double)profiler->TicksPerSecond;
+
+    // Flame graph
+    profiler->ViewFrameOffset = ImClamp(profiler->ViewFrameOffset, 0, completed_count - 1);
+    SetNextItemWidth(GetFontSize() * 12);
+    SliderInt("Frame", &profiler->ViewFrameOffset, 0, completed_count - 1, "%d frames ago");
+    const ImGuiProfilerFrame* frame = ProfilerGetCompletedFrame(profiler, profiler->ViewFrameOffset);
+    SameLine();
+    Text("Frame %d: %.3f ms, %d zones", frame->FrameCount, (frame->TicksEnd - frame->TicksStart) * ms_per_tick, frame->Zones.Size);
+
+    int max_depth = 0;
+    for (const ImGuiProfilerZone& zone : frame->Zones)
+        max_depth = ImMax(max_depth, zone.Depth);
+    const float row_height = GetTextLineHeight() + 2.0f;
+    const ImVec2 graph_size(GetContentRegionAvail().x, row_height * (max_depth + 1));
+    const ImRect graph_bb(GetCursorScreenPos(), GetCursorScreenPos() + graph_size);
+    ItemSize(graph_bb);
+    if (ItemAdd(graph_bb, 0))
+    {
+        ImDrawList* draw_list = GetWindowDrawList();
+        draw_list->AddRectFilled(graph_bb.Min, graph_bb.Max, GetColorU32(ImGuiCol_FrameBg));
+        const double frame_ticks = (double)ImMax(frame->TicksEnd - frame->TicksStart, (ImU64)1);
+        const bool graph_hovered = IsItemHovered();
+        const ImGuiProfilerZone* hovered_zone = NULL;
+        char name[256];
+        for (const ImGuiProfilerZone& zone : frame->Zones)
+        {
+            if (zone.TicksEnd == 0)
+                continue;
+            const float x0 = graph_bb.Min.x + (float)((zone.TicksStart - frame->TicksStart) / frame_ticks) * graph_size.x;
+            const float x1 = ImMax(graph_bb.Min.x + (float)((zone.TicksEnd - frame->TicksStart) / frame_ticks) * graph_size.x, x0 + 1.0f);
+            const ImRect zone_bb(x0, graph_bb.Min.y + zone.Depth * row_height, x1, graph_bb.Min.y + (zone.Depth + 1) * row_height - 1.0f);
+            const float hue = (ImHashStr(zone.Name) & 0xFF) / 255.0f;
+            draw_list->AddRectFilled(zone_bb.Min, zone_bb.Max, ImColor::HSV(hue, 0.45f, 0.65f));
+            if (zone_bb.GetWidth() > GetFontSize() * 2)
+            {
+                ProfilerFormatZoneName(name, IM_ARRAYSIZE(name), &zone);
+                RenderTextClipped(zone_bb.Min + ImVec2(2.0f, 1.0f), zone_bb.Max, name, NULL, NULL, ImVec2(0.0f, 0.0f), &zone_bb);
+            }
+            if (graph_hovered && zone_bb.Contains(g.IO.MousePos))
+                hovered_zone = &zone;
+        }
+        if (hovered_zone && BeginTooltip())
+        {
+            ProfilerFormatZoneName(name, IM_ARRAYSIZE(name), hovered_zone);
+            TextUnformatted(name);
+            Text("%.3f ms (starts at +%.3f ms)", (hovered_zone->TicksEnd - hovered_zone->TicksStart) * ms_per_tick, (hovered_zone->TicksStart - frame->TicksStart) * ms_per_tick);
+            EndTooltip();
+        }
+    }
+
+    // Averages over all completed frames
+    profiler->StatsTemp.resize(0);
+    profiler->StatsTempMap.Clear();
+    for (int n = 0; n < completed_count; n++)
+    {
+        const ImGuiProfilerFrame* stats_frame = ProfilerGetCompletedFrame(profiler, n);
+        for (const ImGuiProfilerZone& zone : stats_frame->Zones)
+        {
+            if (zone.TicksEnd == 0)
+                continue;
+            int* stats_idx = profiler->StatsTempMap.GetIntRef(ImHashStr(zone.Name, 0, zone.WindowID), -1);
+            if (*stats_idx == -1)
+            {
+                *stats_idx = profiler->StatsTemp.Size;
+                ImGuiProfilerZoneStats new_stats = {};
+                new_stats.Name = zone.Name;
+                new_stats.WindowID = zone.WindowID;
+                new_stats.LastFrameCount = -1;
+                profiler->StatsTemp.push_back(new_stats);
+            }
+            ImGuiProfilerZoneStats* stats = &profiler->StatsTemp[*stats_idx];
+            const double ms = (zone.TicksEnd - zone.TicksStart) * ms_per_tick;
+            if (stats->LastFrameCount != stats_frame->FrameCount)
+            {
+                stats->LastFrameCount = stats_frame->FrameCount;
+                stats->LastFrameMs = 0.0;
+            }
+            stats->LastFrameMs += ms;
+            stats->MaxMs = ImMax(stats->MaxMs, stats->LastFrameMs);
+            stats->TotalMs += ms;
+            stats->Calls++;
+        }
+    }
+    ImQsort(profiler->StatsTemp.Data, (size_t)profiler->StatsTemp.Size, sizeof(ImGuiProfilerZoneStats), ProfilerZoneStatsComparerByTotal);
+
+    Text("Averages over %d frames (times include nested zones):", completed_count);
+    if (BeginTable("##ProfilerStats", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit, ImVec2(0.0f, GetTextLineHeightWithSpacing() * 16)))
+    {
+        TableSetupScrollFreeze(0, 1);
+        TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+        TableSetupColumn("Avg ms/frame");
+        TableSetupColumn("Max ms/frame");
+        TableSetupColumn("Calls/frame");
+        TableHeadersRow();
+        char name[256];
+        ImGuiListClipper clipper;
+        clipper.Begin(profiler->StatsTemp.Size);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                const ImGuiProfilerZoneStats* stats = &profiler->StatsTemp[n];
+                ImGuiProfilerZone zone = {};
+                zone.Name = stats->Name;
+                zone.WindowID = stats->WindowID;
+                ProfilerFormatZoneName(name, IM_ARRAYSIZE(name), &zone);
+                TableNextRow();
+                TableNextColumn();
+                TextUnformatted(name);
+                TableNextColumn();
+                Text("%.4f", stats->TotalMs / completed_count);
+                TableNextColumn();
+                Text("%.4f", stats->MaxMs);
+                TableNextColumn();
+                Text("%.1f", (float)stats->Calls / completed_count);
+            }
+        EndTable();
+    }
+}
+#endif // #ifdef IMGUI_ENABLE_PROFILER
+
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
@@ -22034,6 +23372,17 @@ void ImGui::DebugNodeViewport(ImGuiViewportP* viewport)
             (flags & ImGuiViewportFlags_NoAutoMerge) ? " NoAutoMerge" : "",
             (flags & ImGuiViewportFlags_TopMost) ? " TopMost" : "",
             (flags & ImGuiViewportFlags_CanHostOtherWindows) ? " CanHostOtherWindows" : "");
+        if (viewport->DrawDataP.DamageRectsValid)
+        {
+            float damage_area = 0.0f;
+            for (const ImVec4& r : viewport->DrawDataP.DamageRects)
+                damage_area += (r.z - r.x) * (r.w - r.y);
+            const float display_area = viewport->DrawDataP.DisplaySize.x * viewport->DrawDataP.DisplaySize.y;
+            BulletText("DamageRects: %d (%.1f%% of display)", viewport->DrawDataP.DamageRects.Size, display_area > 0.0f ? damage_area * 100.0f / display_area : 0.0f);
+            if (IsItemHovered())
+                for (const ImVec4& r : viewport->DrawDataP.DamageRects)
+                    GetForegroundDrawList(viewport)->AddRect(ImVec2(r.x, r.y), ImVec2(r.z, r.w), IM_COL32(255, 0, 255, 255));
+        }
         for (ImDrawList* draw_list : viewport->DrawDataP.CmdLists)
             DebugNodeDrawList(NULL, viewport, draw_list, "DrawList");
         TreePop();
@@ -22089,7 +23438,7 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("WindowClassId: 0x%08X", window->WindowClass.ClassId);
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
-    BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d, SkipRefresh: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems, window->SkipRefresh);
     for (int layer = 0; layer < ImGuiNavLayer_COUNT; layer++)
     {
         ImRect r = window->NavRectRel[layer];
@@ -165,7 +165,9 @@ struct ImDrawData;                  // All draw command lists required to render
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
+struct ImDrawRectInstance;          // A rectangle primitive expanded by the renderer (when ImGuiBackendFlags_RendererHasRectInstances is set)
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+struct ImDrawVertCompact;           // A single vertex in compact format (quantized pos + uv + col = 12 bytes, when ImGuiBackendFlags_RendererHasVtxCompact is set)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
@@ -178,6 +180,7 @@ struct ImGuiIO;                     // Main configuration and I/O between your a
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiLiteralID;              // Helper for string literal IDs hashed at compile-time, see IM_LITERAL_ID()
 struct ImGuiMultiSelectIO;          // Structure to interact with a BeginMultiSelect()/EndMultiSelect() block
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame
 struct ImGuiPayload;                // User data payload for drag and drop operations
@@ -528,11 +531,13 @@ namespace ImGui
     IMGUI_API void          PushID(const char* str_id_begin, const char* str_id_end);       // push string into the ID stack (will hash string).
     IMGUI_API void          PushID(const void* ptr_id);                                     // push pointer into the ID stack (will hash pointer).
     IMGUI_API void          PushID(int int_id);                                             // push integer into the ID stack (will hash integer).
+    IMGUI_API void          PushID(const ImGuiLiteralID& lit_id);                           // push string literal into the ID stack, hashed at compile-time. e.g. PushID(IM_LITERAL_ID("Settings")) == PushID("Settings")
     IMGUI_API void          PopID();                                                        // pop from the ID stack.
     IMGUI_API ImGuiID       GetID(const char* str_id);                                      // calculate unique ID (hash of whole ID stack + given parameter). e.g. if you want to query into ImGuiStorage yourself
     IMGUI_API ImGuiID       GetID(const char* str_id_begin, const char* str_id_end);
     IMGUI_API ImGuiID       GetID(const void* ptr_id);
     IMGUI_API ImGuiID       GetID(int int_id);
+    IMGUI_API ImGuiID       GetID(const ImGuiLiteralID& lit_id);                            // e.g. GetID(IM_LITERAL_ID("##Slider")) == GetID("##Slider"), without hashing the string at runtime
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
@@ -1666,6 +1671,10 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasDamageRects= 1 << 4,   // Backend Renderer uses ImDrawData::DamageRects[] to only redraw and present the areas that changed. This enables computing them in Render().
+    ImGuiBackendFlags_RendererHasRectInstances=1 << 5,  // Backend Renderer supports ImDrawCmd::RectInstCount > 0 (see ImDrawRectInstance). This allows AddRect()/AddRectFilled() to output compact rectangle instances instead of tessellated vertices.
+    ImGuiBackendFlags_RendererHasVtxCompact = 1 << 6,   // Backend Renderer supports ImDrawList::VtxBufferCompact[] (12 bytes ImDrawVertCompact), used when ImDrawData::VtxCompact is set. This reduces vertex upload bandwidth.
+    ImGuiBackendFlags_RendererHasIdx32      = 1 << 7,   // Backend Renderer supports ImDrawList::IdxBuffer32[] (32-bit indices with VtxOffset applied), output for lists with more than 64K vertices when ImDrawIdx is 16-bit. Implies support for large meshes.
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2334,6 +2343,9 @@ struct ImGuiIO
     bool        ConfigWindowsCopyContentsWithCtrlC; // = false      // [EXPERIMENTAL] CTRL+C copy the contents of focused window into the clipboard. Experimental because: (1) has known issues with nested Begin/End pairs (2) text output quality varies (3) text output is in submission order rather than spatial order.
     bool        ConfigScrollbarScrollByPage;    // = true           // Enable scrolling page by page when clicking outside the scrollbar grab. When disabled, always scroll to clicked location. When enabled, Shift+Click scrolls to clicked location.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigDrawListsDeferText;       // = false          // [EXPERIMENTAL] Write vertices of non-wrapped text during Render() instead of when submitting it, using platform_io.Platform_ParallelForFn when available. Output may contain zero-area quads in place of clipped glyphs.
+    bool        ConfigDrawListsShapeCache;      // = false          // [EXPERIMENTAL] Cache tessellation of circles and n-gons around a unit circle, and only translate/scale/color it when drawing the same shape again. Positions may differ from regular output by a few ULP.
+    bool        ConfigDrawListsTextLayoutCache; // = false          // [EXPERIMENTAL] Cache size and glyphs of text displayed in consecutive frames (16 to 256 bytes, or word-wrapped), for CalcTextSize() and text rendering. Output is the same, except possibly where a word-wrapped line ends exactly at the wrap width.
 
     // Inputs Behaviors
     // (other variables, ones which are expected to be tweaked within UI code, are exposed in ImGuiStyle)
@@ -2638,6 +2650,43 @@ struct ImGuiOnceUponAFrame
     operator bool() const { int current_frame = ImGui::GetFrameCount(); if (RefFrame == current_frame) return false; RefFrame = current_frame; return true; }
 };
 
+// Helper: String literal ID, hashed at compile-time. Use with the IM_LITERAL_ID() macro: ImGui::PushID(IM_LITERAL_ID("Settings")).
+// - Gives the same ID as hashing the literal at runtime (including the "###" operator), for the current hash function (see IMGUI_USE_CRC32C_HASH).
+// - The CRC is linear: hashing a string from 'seed' == shifting 'seed' through as many zero bytes, XOR hashing the string from zero.
+//   The second part is computed at compile-time, the first part is 8 lookups in a table (one row of 16 values per seed nibble) shared by all literals of the same length.
+// - Compile-time evaluation is recursive (C++11 constexpr): keep literals shorter than the compiler constexpr depth limit (512 with GCC/Clang by default).
+template<size_t LEN> struct ImGuiLiteralIDSeedShift { static const ImU32 Table[8 * 16]; };
+struct ImGuiLiteralID
+{
+    const char*     Str;        // Literal, for debug tools
+    const char*     StrEnd;
+    ImU32           Crc;        // CRC of the hashed part of the literal (after the last "###", if any) from a zero register
+    const ImU32*    SeedShift;  // ImGuiLiteralIDSeedShift<hashed length>::Table
+
+    template<ImU32 CRC, size_t LEN>
+    static ImGuiLiteralID Make(const char* str, size_t str_len) { ImGuiLiteralID lit_id = { str, str + str_len, CRC, ImGuiLiteralIDSeedShift<LEN>::Table }; return lit_id; }
+
+#ifdef IMGUI_USE_CRC32C_HASH
+    static constexpr ImU32  CrcBit(ImU32 crc)                               { return (crc >> 1) ^ ((crc & 1) ? 0x82F63B78u : 0u); }
+#else
+    static constexpr ImU32  CrcBit(ImU32 crc)                               { return (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u); }
+#endif
+    static constexpr ImU32  CrcByte(ImU32 crc)                              { return CrcBit(CrcBit(CrcBit(CrcBit(CrcBit(CrcBit(CrcBit(CrcBit(crc)))))))); }
+    static constexpr ImU32  CrcStr(ImU32 crc, const char* s, size_t n)      { return n == 0 ? crc : CrcStr(CrcByte(crc ^ (unsigned char)s[0]), s + 1, n - 1); }
+    static constexpr ImU32  CrcZeroes(ImU32 crc, size_t n)                  { return n == 0 ? crc : CrcZeroes(CrcByte(crc), n - 1); }
+    static constexpr size_t HashStart(const char* s, size_t n, size_t i = 0, size_t last = 0) { return i + 3 > n ? last : HashStart(s, n, i + 1, (s[i] == '#' && s[i + 1] == '#' && s[i + 2] == '#') ? i : last); }
+};
+template<size_t LEN> const ImU32 ImGuiLiteralIDSeedShift<LEN>::Table[8 * 16] =
+{
+#define IM_LITERAL_ID_SHIFT(_VALUE, _NIBBLE)    ImGuiLiteralID::CrcZeroes((_VALUE) << ((_NIBBLE) * 4), LEN)
+#define IM_LITERAL_ID_SHIFT16(_NIBBLE)          IM_LITERAL_ID_SHIFT(0u, _NIBBLE), IM_LITERAL_ID_SHIFT(1u, _NIBBLE), IM_LITERAL_ID_SHIFT(2u, _NIBBLE), IM_LITERAL_ID_SHIFT(3u, _NIBBLE), IM_LITERAL_ID_SHIFT(4u, _NIBBLE), IM_LITERAL_ID_SHIFT(5u, _NIBBLE), IM_LITERAL_ID_SHIFT(6u, _NIBBLE), IM_LITERAL_ID_SHIFT(7u, _NIBBLE), IM_LITERAL_ID_SHIFT(8u, _NIBBLE), IM_LITERAL_ID_SHIFT(9u, _NIBBLE), IM_LITERAL_ID_SHIFT(10u, _NIBBLE), IM_LITERAL_ID_SHIFT(11u, _NIBBLE), IM_LITERAL_ID_SHIFT(12u, _NIBBLE), IM_LITERAL_ID_SHIFT(13u, _NIBBLE), IM_LITERAL_ID_SHIFT(14u, _NIBBLE), IM_LITERAL_ID_SHIFT(15u, _NIBBLE)
+    IM_LITERAL_ID_SHIFT16(0), IM_LITERAL_ID_SHIFT16(1), IM_LITERAL_ID_SHIFT16(2), IM_LITERAL_ID_SHIFT16(3), IM_LITERAL_ID_SHIFT16(4), IM_LITERAL_ID_SHIFT16(5), IM_LITERAL_ID_SHIFT16(6), IM_LITERAL_ID_SHIFT16(7),
+#undef IM_LITERAL_ID_SHIFT16
+#undef IM_LITERAL_ID_SHIFT
+};
+#define IM_LITERAL_ID_HASHED_LEN(_LITERAL)  (sizeof(_LITERAL) - 1 - ImGuiLiteralID::HashStart(_LITERAL, sizeof(_LITERAL) - 1))
+#define IM_LITERAL_ID(_LITERAL)             (ImGuiLiteralID::Make<ImGuiLiteralID::CrcStr(0, (_LITERAL) + (sizeof(_LITERAL) - 1 - IM_LITERAL_ID_HASHED_LEN(_LITERAL)), IM_LITERAL_ID_HASHED_LEN(_LITERAL)), IM_LITERAL_ID_HASHED_LEN(_LITERAL)>(_LITERAL, sizeof(_LITERAL) - 1))
+
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 struct ImGuiTextFilter
 {
@@ -2699,6 +2748,8 @@ struct ImGuiStoragePair
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// For large or frequently inserted storages, call SetHashIndex(true) to use an open-addressing hash index instead (O(1) lookup and insertion, pairs are kept in insertion order).
+// Storages are sorted unless you opt in, e.g. ImGui::GetStateStorage()->SetHashIndex(true) in a window holding a tree with many thousands of nodes.
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2706,12 +2757,17 @@ struct ImGuiStoragePair
 struct ImGuiStorage
 {
     // [Internal]
-    ImVector<ImGuiStoragePair>      Data;
+    ImVector<ImGuiStoragePair>      Data;           // Sorted by key, or in insertion order when using the hash index
+    ImVector<ImGuiID>               IndexKeys;      // Hash index slots (power of two count): key, 0 for an empty slot. Keys are probed linearly.
+    ImVector<int>                   IndexPos;       // Hash index slots: position of the pair in Data
+    int                             IndexZeroKey;   // Position + 1 in Data of the pair with key 0, which can't go in a slot. 0 if none.
+    bool                            UseHashIndex;
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    ImGuiStorage()      { IndexZeroKey = 0; UseHashIndex = false; }
+    void                Clear() { Data.clear(); IndexKeys.clear(); IndexPos.clear(); IndexZeroKey = 0; }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2732,6 +2788,10 @@ struct ImGuiStorage
 
     // Advanced: for quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
     IMGUI_API void      BuildSortByKey();
+    // Advanced: select the hash index for this storage. Enabling keeps the current order of Data, disabling sorts it back.
+    // Call BuildHashIndex() after modifying Data directly while the hash index is used.
+    IMGUI_API void      SetHashIndex(bool enabled);
+    IMGUI_API void      BuildHashIndex();
     // Obsolete: use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
@@ -2980,6 +3040,8 @@ struct ImGuiSelectionRequest
 // - use the AdapterIndexToStorageId() indirection layer to abstract how persistent selection data is derived from an index.
 // - use decently optimized logic to allow queries and insertion of very large selection sets.
 // - do not preserve selection order.
+// - can optionally store selected ids in [0..ItemsCount) as a bit array (UseBitset), which turns range requests (e.g. Shift+Click, Ctrl+A over 1M items)
+//   into bit range fills when using the default adapter. Other ids are stored in a hash set. Iteration is in ascending id order for the bit array part.
 // Many combinations are possible depending on how you prefer to store your items and how you prefer to store your selection.
 // Large applications are likely to eventually want to get rid of this indirection layer and do their own thing.
 // See https://github.com/ocornut/imgui/wiki/Multi-Select for details and pseudo-code using this helper.
@@ -2988,10 +3050,12 @@ struct ImGuiSelectionBasicStorage
     // Members
     int             Size;           //          // Number of selected items, maintained by this helper.
     bool            PreserveOrder;  // = false  // GetNextSelectedItem() will return ordered selection (currently implemented by two additional sorts of selection. Could be improved)
+    bool            UseBitset;      // = false  // Store ids in [0..ItemsCount) in a bit array, others in a hash set. Set before first use. Incompatible with PreserveOrder.
     void*           UserData;       // = NULL   // User data for use by adapter function        // e.g. selection.UserData = (void*)my_items;
     ImGuiID         (*AdapterIndexToStorageId)(ImGuiSelectionBasicStorage* self, int idx);      // e.g. selection.AdapterIndexToStorageId = [](ImGuiSelectionBasicStorage* self, int idx) { return ((MyItems**)self->UserData)[idx]->ID; };
     int             _SelectionOrder;// [Internal] Increasing counter to store selection order
     ImGuiStorage    _Storage;       // [Internal] Selection set. Think of this as similar to e.g. std::set<ImGuiID>. Prefer not accessing directly: iterate with GetNextSelectedItem().
+    ImVector<ImU32> _Bits;          // [Internal] Selection bit array when UseBitset is set, covering ids [0.._Bits.Size*32).
 
     // Methods
     IMGUI_API ImGuiSelectionBasicStorage();
@@ -3060,6 +3124,8 @@ struct ImDrawCmd
     void*           UserCallbackData;   // 4-8  // Callback user data (when UserCallback != NULL). If called AddCallback() with size == 0, this is a copy of the AddCallback() argument. If called AddCallback() with size > 0, this is pointing to a buffer where data is stored.
     int             UserCallbackDataSize;  // 4 // Size of callback user data when using storage, otherwise 0.
     int             UserCallbackDataOffset;// 4 // [Internal] Offset of callback user data when using storage, otherwise -1.
+    unsigned int    RectInstOffset;     // 4    // Start offset in the parent ImDrawList's RectInstBuffer[] (when RectInstCount > 0).
+    unsigned int    RectInstCount;      // 4    // If > 0, render this many ImDrawRectInstance instead of triangles (ElemCount is 0). Only output when ImGuiBackendFlags_RendererHasRectInstances is set.
 
     ImDrawCmd()     { memset(this, 0, sizeof(*this)); } // Also ensure our padding fields are zeroed
 
@@ -3067,6 +3133,22 @@ struct ImDrawCmd
     inline ImTextureID GetTexID() const { return TextureId; }
 };
 
+// Rectangle instance, output by AddRect()/AddRectFilled() when 'io.BackendFlags & ImGuiBackendFlags_RendererHasRectInstances' is set.
+// The renderer expands them itself (e.g. one instanced quad per rectangle + signed distance function in the pixel shader):
+// - Filled when Thickness == 0.0f, otherwise a stroke of Thickness width centered on the rectangle edges.
+// - Corners set in Flags (ImDrawFlags_RoundCornersXXX) are rounded with the Rounding radius (already clamped to the rectangle size). Rounding == 0.0f for square corners.
+// - Edges are expected to be anti-aliased over 1 pixel, like the tessellated output. No texture is sampled: Col is used as-is.
+// - Instances are stored in the parent ImDrawList's RectInstBuffer[] and rendered in order with other commands, using the ImDrawCmd's ClipRect.
+struct ImDrawRectInstance
+{
+    ImVec2          Min;                // Upper-left
+    ImVec2          Max;                // Lower-right
+    float           Rounding;           // Corner radius, 0.0f when not rounded
+    float           Thickness;          // Stroke thickness, 0.0f when filled
+    ImU32           Col;
+    ImDrawFlags     Flags;              // Rounded corners (ImDrawFlags_RoundCornersXXX)
+};
+
 // Vertex layout
 #ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
 struct ImDrawVert
@@ -3083,6 +3165,17 @@ struct ImDrawVert
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
 
+// Compact vertex layout, output in ImDrawList::VtxBufferCompact[] when 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxCompact' is set
+// and every vertex of the frame fits (otherwise ImDrawData::VtxCompact is false and the regular ImDrawVert buffers must be used).
+// Decode as: pos = ImDrawData::DisplayPos + pos / IM_DRAWVERT_COMPACT_POS_SCALE, uv = uv / 65535.0f (e.g. R16G16_SINT + R16G16_UNORM + R8G8B8A8_UNORM attributes).
+#define IM_DRAWVERT_COMPACT_POS_SCALE   8.0f    // Positions are stored with 1/8 pixel precision (-4096..+4096 pixels around DisplayPos)
+struct ImDrawVertCompact
+{
+    ImS16   pos[2];
+    ImU16   uv[2];
+    ImU32   col;
+};
+
 // [Internal] For use by ImDrawList
 struct ImDrawCmdHeader
 {
@@ -3091,6 +3184,23 @@ struct ImDrawCmdHeader
     unsigned int    VtxOffset;
 };
 
+// [Internal] For use by ImDrawList with ImDrawListFlags_DeferText
+// Indices are written when the run is recorded, vertices are written by ImDrawList::_ExpandTextRuns(). As the number of visible
+// glyphs is only known after expansion, 'QuadsCount' is an upper bound and unused quads are output as zero-area quads.
+struct ImDrawTextRun
+{
+    ImFont*         Font;
+    float           Size;
+    ImVec2          Pos;            // Top-left of first line, already aligned to pixel
+    ImU32           Col;
+    bool            CpuFineClip;
+    ImVec4          ClipRect;
+    int             TextOffset;     // Offset of text in ImDrawList::_TextRunsBuf[]
+    int             TextLength;
+    int             VtxOffset;      // Offset of first vertex in ImDrawList::VtxBuffer[]
+    int             QuadsCount;     // Number of quads reserved in VtxBuffer[]/IdxBuffer[]
+};
+
 // [Internal] For use by ImDrawListSplitter
 struct ImDrawChannel
 {
@@ -3145,6 +3255,10 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_RectInstances           = 1 << 4,  // Output AddRect()/AddRectFilled() as ImDrawRectInstance instead of vertices. Set when 'ImGuiBackendFlags_RendererHasRectInstances' is enabled.
+    ImDrawListFlags_DeferText               = 1 << 5,  // Record text as ImDrawTextRun and only write its vertices in Render(), possibly in parallel. Set when 'io.ConfigDrawListsDeferText' is enabled.
+    ImDrawListFlags_ShapeCache              = 1 << 6,  // Reuse tessellation of AddCircle()/AddCircleFilled()/AddNgon()/AddNgonFilled() shapes from ImDrawListSharedData. Set when 'io.ConfigDrawListsShapeCache' is enabled.
+    ImDrawListFlags_TextLayoutCache         = 1 << 7,  // Render text from layouts cached in ImDrawListSharedData (not with ImDrawListFlags_DeferText). Set when 'io.ConfigDrawListsTextLayoutCache' is enabled.
 };
 
 // Draw command list
@@ -3162,6 +3276,9 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Draw commands. Typically 1 command = 1 GPU draw call, unless the command is a callback.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawRectInstance> RectInstBuffer;// Rectangle instances buffer (ImDrawListFlags_RectInstances). Each command consume ImDrawCmd::RectInstCount of those
+    ImVector<ImDrawVertCompact> VtxBufferCompact;// Vertex buffer in compact format, filled by Render() when ImDrawData::VtxCompact is set (ImGuiBackendFlags_RendererHasVtxCompact).
+    ImVector<ImU32>         IdxBuffer32;        // 32-bit index buffer with ImDrawCmd::VtxOffset already applied, filled by Render() for lists with more than 64K vertices (ImGuiBackendFlags_RendererHasIdx32). When not empty, use instead of IdxBuffer and ignore VtxOffset.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
 
     // [Internal, used while building lists]
@@ -3175,6 +3292,8 @@ struct ImDrawList
     ImVector<ImVec4>        _ClipRectStack;     // [Internal]
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
+    ImVector<ImDrawTextRun> _TextRuns;          // [Internal] text waiting for its vertices (ImDrawListFlags_DeferText)
+    ImVector<char>          _TextRunsBuf;       // [Internal] copy of text referenced by _TextRuns[]
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
 
@@ -3300,6 +3419,11 @@ struct ImDrawList
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
     IMGUI_API void  _SetTextureID(ImTextureID texture_id);
+    IMGUI_API void  _AddRectInstance(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness);
+    IMGUI_API void  _AddTextRun(ImFont* font, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, bool cpu_fine_clip);
+    IMGUI_API void  _ExpandTextRuns(int run_begin, int run_end);
+    IMGUI_API void  _FlushTextRuns();
+    IMGUI_API void  _AddCircleCached(const ImVec2& center, float radius, ImU32 col, int a_step, int num_segments, float thickness, bool filled);
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
@@ -3314,11 +3438,15 @@ struct ImDrawData
     int                 CmdListsCount;      // Number of ImDrawList* to render
     int                 TotalIdxCount;      // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int                 TotalVtxCount;      // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    int                 TotalRectInstCount; // For convenience, sum of all ImDrawList's RectInstBuffer.Size
     ImVector<ImDrawList*> CmdLists;         // Array of ImDrawList* to render. The ImDrawLists are owned by ImGuiContext and only pointed to from here.
     ImVec2              DisplayPos;         // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2              FramebufferScale;   // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
     ImGuiViewport*      OwnerViewport;      // Viewport carrying the ImDrawData instance, might be of use to the renderer (generally not).
+    bool                DamageRectsValid;   // Set when DamageRects[] was computed (requires ImGuiBackendFlags_RendererHasDamageRects). When false, consider that the whole display changed.
+    bool                VtxCompact;         // Set when every ImDrawList::VtxBufferCompact[] was filled (requires ImGuiBackendFlags_RendererHasVtxCompact). When false, use the VtxBuffer[] arrays.
+    ImVector<ImVec4>    DamageRects;        // Areas that changed since the previous Render() of this viewport, in the same coordinates as ImDrawCmd::ClipRect (x1,y1,x2,y2). Empty = nothing changed. If you don't present a frame, you need to accumulate them yourself.
 
     // Functions
     ImDrawData()    { Clear(); }
@@ -3504,6 +3632,7 @@ struct ImFontAtlas
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexReady;           // Set when texture was built matching current font input
+    int                         BuildCount;         // Incremented on each build, to discard data derived from glyphs (e.g. ImDrawListSharedData::TextLayoutCache)
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
@@ -3731,6 +3860,11 @@ struct ImGuiPlatformIO
     // [Experimental] Configure decimal point e.g. '.' or ',' useful for some languages (e.g. German), generally pulled from *localeconv()->decimal_point
     ImWchar     Platform_LocaleDecimalPoint;     // '.'
 
+    // Optional: Worker pool used by Render() to write vertices of deferred text (io.ConfigDrawListsDeferText)
+    // Call 'job_func(job_data, n)' for n in [0, jobs_count) and return once all calls have completed. Jobs may run in any order and on any thread, they don't call into the ImGuiContext.
+    void        (*Platform_ParallelForFn)(ImGuiContext* ctx, int jobs_count, void (*job_func)(void* job_data, int job_index), void* job_data);
+    void*       Platform_ParallelForUserData;
+
     //------------------------------------------------------------------
     // Interface with Renderer Backend
     //------------------------------------------------------------------
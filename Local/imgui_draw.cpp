@@ -377,6 +377,7 @@ void ImGui::StyleColorsLight(ImGuiStyle* dst)
 ImDrawListSharedData::ImDrawListSharedData()
 {
     memset(this, 0, sizeof(*this));
+    IM_PLACEMENT_NEW(&TextLayoutCache) ImDrawTextLayoutCache();
     for (int i = 0; i < IM_ARRAYSIZE(ArcFastVtx); i++)
     {
         const float a = ((float)i * 2 * IM_PI) / (float)IM_ARRAYSIZE(ArcFastVtx);
@@ -414,6 +415,9 @@ void ImDrawList::_ResetForNewFrame()
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
+    RectInstBuffer.resize(0);
+    VtxBufferCompact.resize(0);
+    IdxBuffer32.resize(0);
     Flags = _Data->InitialFlags;
     memset(&_CmdHeader, 0, sizeof(_CmdHeader));
     _VtxCurrentIdx = 0;
@@ -422,6 +426,8 @@ void ImDrawList::_ResetForNewFrame()
     _ClipRectStack.resize(0);
     _TextureIdStack.resize(0);
     _CallbacksDataBuf.resize(0);
+    _TextRuns.resize(0);
+    _TextRunsBuf.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
@@ -433,6 +439,9 @@ void ImDrawList::_ClearFreeMemory()
     CmdBuffer.clear();
     IdxBuffer.clear();
     VtxBuffer.clear();
+    RectInstBuffer.clear();
+    VtxBufferCompact.clear();
+    IdxBuffer32.clear();
     Flags = ImDrawListFlags_None;
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
@@ -440,22 +449,31 @@ void ImDrawList::_ClearFreeMemory()
     _ClipRectStack.clear();
     _TextureIdStack.clear();
     _CallbacksDataBuf.clear();
+    _TextRuns.clear();
+    _TextRunsBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     ImDrawList* dst = IM_NEW(ImDrawList(_Data));
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
+    dst->RectInstBuffer = RectInstBuffer;
+    dst->VtxBufferCompact = VtxBufferCompact;
+    dst->IdxBuffer32 = IdxBuffer32;
+    dst->_TextRuns = _TextRuns;
+    dst->_TextRunsBuf = _TextRunsBuf;
     dst->Flags = Flags;
     return dst;
 }
 
 void ImDrawList::AddDrawCmd()
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TextureId = _CmdHeader.TextureId;
@@ -467,13 +485,13 @@ void ImDrawList::AddDrawCmd()
 }
 
 // Pop trailing draw command (used before merging or presenting to user)
-// Note that this leaves the ImDrawList in a state unfit for further commands, as most code assume that CmdBuffer.Size > 0 && CmdBuffer.back().UserCallback == NULL
+// Note that this leaves the ImDrawList in a state unfit for further commands, as most code assume that CmdBuffer.Size > 0 && CmdBuffer.back().UserCallback == NULL && CmdBuffer.back().RectInstCount == 0
 void ImDrawList::_PopUnusedDrawCmd()
 {
     while (CmdBuffer.Size > 0)
     {
         ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
-        if (curr_cmd->ElemCount != 0 || curr_cmd->UserCallback != NULL)
+        if (curr_cmd->ElemCount != 0 || curr_cmd->UserCallback != NULL || curr_cmd->RectInstCount != 0)
             return;// break;
         CmdBuffer.pop_back();
     }
@@ -481,6 +499,7 @@ void ImDrawList::_PopUnusedDrawCmd()
 
 void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t userdata_size)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
@@ -525,7 +544,7 @@ void ImDrawList::_TryMergeDrawCmds()
     IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL)
+    if (ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && curr_cmd->UserCallback == NULL && prev_cmd->UserCallback == NULL && curr_cmd->RectInstCount == 0 && prev_cmd->RectInstCount == 0)
     {
         prev_cmd->ElemCount += curr_cmd->ElemCount;
         CmdBuffer.pop_back();
@@ -548,7 +567,7 @@ void ImDrawList::_OnChangedClipRect()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL && prev_cmd->RectInstCount == 0)
     {
         CmdBuffer.pop_back();
         return;
@@ -570,7 +589,7 @@ void ImDrawList::_OnChangedTextureID()
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = curr_cmd - 1;
-    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(&_CmdHeader, prev_cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, curr_cmd) && prev_cmd->UserCallback == NULL && prev_cmd->RectInstCount == 0)
     {
         CmdBuffer.pop_back();
         return;
@@ -607,6 +626,7 @@ int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(const ImVec2& cr_min, const ImVec2& cr_max, bool intersect_with_current_clip_rect)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect)
     {
@@ -638,6 +658,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     _TextureIdStack.push_back(texture_id);
     _CmdHeader.TextureId = texture_id;
     _OnChangedTextureID();
@@ -664,6 +685,7 @@ void ImDrawList::_SetTextureID(ImTextureID texture_id)
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     // Large mesh support (when enabled)
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
@@ -698,9 +720,68 @@ void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
     IdxBuffer.shrink(IdxBuffer.Size - idx_count);
 }
 
+// SIMD kernels for vertex emission
+// - SSE2 versions are used with IMGUI_ENABLE_SSE, NEON versions with IMGUI_ENABLE_NEON, otherwise (or with ImDrawListSharedData::UseScalarKernels) the scalar code runs.
+// - They perform the same operations in the same order as the scalar code, so output is bit-identical. With SSE, ImRsqrt() uses _mm_rsqrt_ss()
+//   which gives the same approximation as _mm_rsqrt_ps(). Note that enabling FMA contraction (e.g. '-ffp-contract=fast' with '-mfma', or the
+//   default on AArch64) may let the compiler fuse multiply-adds differently in both versions.
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SSE_DRAWVERT   // Default ImDrawVert layout (pos, uv, col): 4 vertices are written as 5 unaligned 16-bytes stores.
+
+// Write 4 vertices of an axis-aligned quad with corners a, (c.x,a.y), c, (a.x,c.y).
+// 'p' = (a.x, a.y, c.x, c.y), 'uv' = (uv_a.x, uv_a.y, uv_c.x, uv_c.y).
+static inline void ImDrawList_WriteRectVtxSSE(ImDrawVert* vtx, __m128 p, __m128 uv, ImU32 col)
+{
+    const __m128 c = _mm_castsi128_ps(_mm_set1_epi32((int)col));
+    const __m128 p_uv_hi = _mm_unpackhi_ps(p, uv);                                                                                  // c.x uv_c.x c.y uv_c.y
+    float* dst = &vtx->pos.x;
+    _mm_storeu_ps(dst + 0, _mm_movelh_ps(p, uv));                                                                                   // a.x a.y uv_a.x uv_a.y
+    _mm_storeu_ps(dst + 4, _mm_unpacklo_ps(_mm_move_ss(p, c), p_uv_hi));                                                            // col | c.x a.y uv_c.x
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(_mm_unpacklo_ps(_mm_shuffle_ps(uv, uv, _MM_SHUFFLE(1, 1, 1, 1)), c), p, _MM_SHUFFLE(3, 2, 1, 0))); // uv_a.y col | c.x c.y
+    _mm_storeu_ps(dst + 12, _mm_shuffle_ps(uv, _mm_unpacklo_ps(c, p), _MM_SHUFFLE(1, 0, 3, 2)));                                    // uv_c.x uv_c.y col | a.x
+    _mm_storeu_ps(dst + 16, _mm_unpacklo_ps(_mm_movehl_ps(p_uv_hi, p_uv_hi), _mm_unpacklo_ps(uv, c)));                              // c.y uv_a.x uv_c.y col
+}
+
+// Write 6 indices (0,1,2, 0,2,3) of a quad starting at vertex 'vtx_idx'.
+static inline void ImDrawList_WriteRectIdxSSE(ImDrawIdx* idx, ImDrawIdx vtx_idx)
+{
+    if (sizeof(ImDrawIdx) == 2)
+    {
+        const __m128i v = _mm_add_epi16(_mm_set1_epi16((short)vtx_idx), _mm_setr_epi16(0, 1, 2, 0, 2, 3, 0, 0));
+        const int v45 = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+        _mm_storel_epi64((__m128i*)(void*)idx, v);
+        memcpy(idx + 4, &v45, 4);
+    }
+    else
+    {
+        const __m128i base = _mm_set1_epi32((int)vtx_idx);
+        _mm_storeu_si128((__m128i*)(void*)idx, _mm_add_epi32(base, _mm_setr_epi32(0, 1, 2, 0)));
+        _mm_storel_epi64((__m128i*)(void*)(idx + 4), _mm_add_epi32(base, _mm_setr_epi32(2, 3, 0, 0)));
+    }
+}
+
+// Write 4 vertices and 6 indices of an axis-aligned quad.
+static inline void ImDrawList_WriteRectSSE(ImDrawVert* vtx, ImDrawIdx* idx, ImDrawIdx vtx_idx, __m128 p, __m128 uv, ImU32 col)
+{
+    ImDrawList_WriteRectVtxSSE(vtx, p, uv, col);
+    ImDrawList_WriteRectIdxSSE(idx, vtx_idx);
+}
+#endif
+
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+    if (!_Data->UseScalarKernels)
+    {
+        const ImVec2 uv = _Data->TexUvWhitePixel;
+        ImDrawList_WriteRectSSE(_VtxWritePtr, _IdxWritePtr, (ImDrawIdx)_VtxCurrentIdx, _mm_setr_ps(a.x, a.y, c.x, c.y), _mm_setr_ps(uv.x, uv.y, uv.x, uv.y), col);
+        _VtxWritePtr += 4;
+        _VtxCurrentIdx += 4;
+        _IdxWritePtr += 6;
+        return;
+    }
+#endif
     ImVec2 b(c.x, a.y), d(a.x, c.y), uv(_Data->TexUvWhitePixel);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
@@ -716,6 +797,16 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 
 void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
 {
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+    if (!_Data->UseScalarKernels)
+    {
+        ImDrawList_WriteRectSSE(_VtxWritePtr, _IdxWritePtr, (ImDrawIdx)_VtxCurrentIdx, _mm_setr_ps(a.x, a.y, c.x, c.y), _mm_setr_ps(uv_a.x, uv_a.y, uv_c.x, uv_c.y), col);
+        _VtxWritePtr += 4;
+        _VtxCurrentIdx += 4;
+        _IdxWritePtr += 6;
+        return;
+    }
+#endif
     ImVec2 b(c.x, a.y), d(a.x, c.y), uv_b(uv_c.x, uv_a.y), uv_d(uv_a.x, uv_c.y);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
@@ -750,10 +841,134 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Normals of segments [i, i+1] for i in [0, count). The point following the last one is the first one.
+static void ImDrawList_CalcSegmentNormals(const ImVec2* points, const int points_count, const int count, ImVec2* out_normals, bool use_simd)
+{
+    int i = 0;
+#if defined(IMGUI_ENABLE_SSE)
+    if (use_simd)
+    {
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        for (; i + 4 <= count && i + 4 < points_count; i += 4)
+        {
+            const __m128 d01 = _mm_sub_ps(_mm_loadu_ps(&points[i + 1].x), _mm_loadu_ps(&points[i].x));     // dx0 dy0 dx1 dy1
+            const __m128 d23 = _mm_sub_ps(_mm_loadu_ps(&points[i + 3].x), _mm_loadu_ps(&points[i + 2].x)); // dx2 dy2 dx3 dy3
+            __m128 dx = _mm_shuffle_ps(d01, d23, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 dy = _mm_shuffle_ps(d01, d23, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const __m128 mask = _mm_cmpgt_ps(d2, _mm_setzero_ps());
+            const __m128 inv_len = _mm_rsqrt_ps(d2);
+            dx = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dx, inv_len)), _mm_andnot_ps(mask, dx));
+            dy = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dy, inv_len)), _mm_andnot_ps(mask, dy));
+            const __m128 neg_dx = _mm_xor_ps(dx, sign_mask);
+            _mm_storeu_ps(&out_normals[i].x, _mm_unpacklo_ps(dy, neg_dx));
+            _mm_storeu_ps(&out_normals[i + 2].x, _mm_unpackhi_ps(dy, neg_dx));
+        }
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    if (use_simd)
+    {
+        for (; i + 4 <= count && i + 4 < points_count; i += 4)
+        {
+            const float32x4x2_t p0 = vld2q_f32(&points[i].x); // x0 x1 x2 x3, y0 y1 y2 y3
+            const float32x4x2_t p1 = vld2q_f32(&points[i + 1].x);
+            float32x4_t dx = vsubq_f32(p1.val[0], p0.val[0]);
+            float32x4_t dy = vsubq_f32(p1.val[1], p0.val[1]);
+            const float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+            const uint32x4_t mask = vcgtq_f32(d2, vdupq_n_f32(0.0f));
+            const float32x4_t inv_len = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(d2));
+            dx = vbslq_f32(mask, vmulq_f32(dx, inv_len), dx);
+            dy = vbslq_f32(mask, vmulq_f32(dy, inv_len), dy);
+            float32x4x2_t normals;
+            normals.val[0] = dy;
+            normals.val[1] = vnegq_f32(dx);
+            vst2q_f32(&out_normals[i].x, normals);
+        }
+    }
+#else
+    IM_UNUSED(use_simd);
+#endif
+    for (; i < count; i++)
+    {
+        const int i2 = (i + 1) == points_count ? 0 : i + 1;
+        float dx = points[i2].x - points[i].x;
+        float dy = points[i2].y - points[i].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i].x = dy;
+        out_normals[i].y = -dx;
+    }
+}
+
+// Averaged normals at points [1, points_count) (and point 0 if 'closed'), from the normals of the two segments sharing each point.
+// Scaled so that offsetting a point by them keeps a constant distance to both segments (within limits).
+static void ImDrawList_CalcPointNormals(const ImVec2* normals, const int points_count, bool closed, ImVec2* out_normals, bool use_simd)
+{
+    int i = 1;
+#if defined(IMGUI_ENABLE_SSE)
+    if (use_simd)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 min_d2 = _mm_set1_ps(0.000001f);
+        const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+        for (; i + 4 <= points_count; i += 4)
+        {
+            const __m128 dm01 = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i - 1].x), _mm_loadu_ps(&normals[i].x)), half);     // x0 y0 x1 y1
+            const __m128 dm23 = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i + 1].x), _mm_loadu_ps(&normals[i + 2].x)), half); // x2 y2 x3 y3
+            const __m128 sq01 = _mm_mul_ps(dm01, dm01);
+            const __m128 sq23 = _mm_mul_ps(dm23, dm23);
+            const __m128 d2 = _mm_add_ps(_mm_shuffle_ps(sq01, sq23, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(sq01, sq23, _MM_SHUFFLE(3, 1, 3, 1)));
+            const __m128 mask = _mm_cmpgt_ps(d2, min_d2);
+            const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+            const __m128 mask01 = _mm_unpacklo_ps(mask, mask), mask23 = _mm_unpackhi_ps(mask, mask);
+            const __m128 scaled01 = _mm_mul_ps(dm01, _mm_unpacklo_ps(inv_len2, inv_len2));
+            const __m128 scaled23 = _mm_mul_ps(dm23, _mm_unpackhi_ps(inv_len2, inv_len2));
+            _mm_storeu_ps(&out_normals[i].x, _mm_or_ps(_mm_and_ps(mask01, scaled01), _mm_andnot_ps(mask01, dm01)));
+            _mm_storeu_ps(&out_normals[i + 2].x, _mm_or_ps(_mm_and_ps(mask23, scaled23), _mm_andnot_ps(mask23, dm23)));
+        }
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    if (use_simd)
+    {
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t min_d2 = vdupq_n_f32(0.000001f);
+        const float32x4_t max_inv_len2 = vdupq_n_f32(IM_FIXNORMAL2F_MAX_INVLEN2);
+        for (; i + 4 <= points_count; i += 4)
+        {
+            const float32x4x2_t n0 = vld2q_f32(&normals[i - 1].x);
+            const float32x4x2_t n1 = vld2q_f32(&normals[i].x);
+            float32x4x2_t dm;
+            dm.val[0] = vmulq_f32(vaddq_f32(n0.val[0], n1.val[0]), half);
+            dm.val[1] = vmulq_f32(vaddq_f32(n0.val[1], n1.val[1]), half);
+            const float32x4_t d2 = vaddq_f32(vmulq_f32(dm.val[0], dm.val[0]), vmulq_f32(dm.val[1], dm.val[1]));
+            const uint32x4_t mask = vcgtq_f32(d2, min_d2);
+            const float32x4_t inv_len2 = vminq_f32(vdivq_f32(one, d2), max_inv_len2);
+            dm.val[0] = vbslq_f32(mask, vmulq_f32(dm.val[0], inv_len2), dm.val[0]);
+            dm.val[1] = vbslq_f32(mask, vmulq_f32(dm.val[1], inv_len2), dm.val[1]);
+            vst2q_f32(&out_normals[i].x, dm);
+        }
+    }
+#else
+    IM_UNUSED(use_simd);
+#endif
+    for (; i < points_count + (closed ? 1 : 0); i++)
+    {
+        const int i0 = i - 1;
+        const int i1 = (i == points_count) ? 0 : i;
+        float dm_x = (normals[i0].x + normals[i1].x) * 0.5f;
+        float dm_y = (normals[i0].y + normals[i1].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_normals[i1].x = dm_x;
+        out_normals[i1].y = dm_y;
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -786,23 +1001,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        // The first <points_count> items are normals at each line segment, then averaged normals at each line point, then after that there are either 2 or 4 temp points for each line point
+        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 4 : 6));
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        ImVec2* temp_points = temp_normals + points_count;
+        ImVec2* temp_point_normals = temp_normals + points_count;
+        ImVec2* temp_points = temp_point_normals + points_count;
 
-        // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        // Calculate normals (tangents) for each line segment, then averaged normals for each line point
+        const bool use_simd = !_Data->UseScalarKernels;
+        ImDrawList_CalcSegmentNormals(points, points_count, count, temp_normals, use_simd);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        ImDrawList_CalcPointNormals(temp_normals, points_count, closed, temp_point_normals, use_simd);
 
         // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
         if (use_texture || !thick_line)
@@ -835,12 +1045,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
+                // Averaged normals
+                const float dm_x = temp_point_normals[i2].x * half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
+                const float dm_y = temp_point_normals[i2].y * half_draw_size;
 
                 // Add temporary vertexes for the outer edges
                 ImVec2* out_vtx = &temp_points[i2 * 2];
@@ -931,10 +1138,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
+                // Averaged normals
+                const float dm_x = temp_point_normals[i2].x;
+                const float dm_y = temp_point_normals[i2].y;
                 float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
                 float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
                 float dm_in_x = dm_x * half_inner_thickness;
@@ -1012,6 +1218,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 // - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
 void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -1035,30 +1242,19 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals of each edge, then averaged normals at each point
+        const bool use_simd = !_Data->UseScalarKernels;
+        _Data->TempBuffer.reserve_discard(points_count * 2);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        ImVec2* temp_point_normals = temp_normals + points_count;
+        ImDrawList_CalcSegmentNormals(points, points_count, points_count, temp_normals, use_simd);
+        ImDrawList_CalcPointNormals(temp_normals, points_count, true, temp_point_normals, use_simd);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+            // Averaged normals
+            const float dm_x = temp_point_normals[i1].x * (AA_SIZE * 0.5f);
+            const float dm_y = temp_point_normals[i1].y * (AA_SIZE * 0.5f);
 
             // Add vertices
             _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
@@ -1094,6 +1290,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 
 void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     if (radius < 0.5f)
     {
         _Path.push_back(center);
@@ -1186,6 +1383,7 @@ void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_
 
 void ImDrawList::_PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     if (radius < 0.5f)
     {
         _Path.push_back(center);
@@ -1402,15 +1600,25 @@ static inline ImDrawFlags FixRectCornerFlags(ImDrawFlags flags)
     return flags;
 }
 
-void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
+// Clamp rounding to the rectangle size. Returns 0.0f when no corner is rounded.
+static inline float FixRectRounding(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags* p_flags)
 {
+    ImDrawFlags flags = *p_flags;
     if (rounding >= 0.5f)
     {
-        flags = FixRectCornerFlags(flags);
+        flags = *p_flags = FixRectCornerFlags(flags);
         rounding = ImMin(rounding, ImFabs(b.x - a.x) * (((flags & ImDrawFlags_RoundCornersTop) == ImDrawFlags_RoundCornersTop) || ((flags & ImDrawFlags_RoundCornersBottom) == ImDrawFlags_RoundCornersBottom) ? 0.5f : 1.0f) - 1.0f);
         rounding = ImMin(rounding, ImFabs(b.y - a.y) * (((flags & ImDrawFlags_RoundCornersLeft) == ImDrawFlags_RoundCornersLeft) || ((flags & ImDrawFlags_RoundCornersRight) == ImDrawFlags_RoundCornersRight) ? 0.5f : 1.0f) - 1.0f);
     }
     if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
+        return 0.0f;
+    return rounding;
+}
+
+void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDrawFlags flags)
+{
+    rounding = FixRectRounding(a, b, rounding, &flags);
+    if (rounding == 0.0f)
     {
         PathLineTo(a);
         PathLineTo(ImVec2(b.x, a.y));
@@ -1445,6 +1653,11 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    if ((Flags & ImDrawListFlags_RectInstances) && thickness > 0.0f)
+    {
+        _AddRectInstance(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), col, rounding, flags, thickness);
+        return;
+    }
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
@@ -1456,7 +1669,11 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
-    if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
+    if (Flags & ImDrawListFlags_RectInstances)
+    {
+        _AddRectInstance(p_min, p_max, col, rounding, flags, 0.0f);
+    }
+    else if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
@@ -1468,6 +1685,42 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
     }
 }
 
+// Record a rectangle instance (ImDrawListFlags_RectInstances) for the renderer to expand.
+// Instance commands are never the trailing command: consecutive instances sharing a ClipRect are appended to the previous command,
+// so code adding vertices or callbacks can keep assuming that CmdBuffer.back() is a regular draw command.
+void ImDrawList::_AddRectInstance(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness)
+{
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+    IM_ASSERT_PARANOID(CmdBuffer.Size > 0);
+    ImDrawRectInstance inst;
+    inst.Min = p_min;
+    inst.Max = p_max;
+    inst.Rounding = FixRectRounding(p_min, p_max, rounding, &flags);
+    inst.Thickness = thickness;
+    inst.Col = col;
+    inst.Flags = (inst.Rounding > 0.0f) ? (flags & ImDrawFlags_RoundCornersMask_) : ImDrawFlags_RoundCornersNone;
+
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    ImDrawCmd* prev_cmd = curr_cmd - 1;
+    IM_ASSERT(curr_cmd->UserCallback == NULL && curr_cmd->RectInstCount == 0);
+    if (curr_cmd->ElemCount == 0 && CmdBuffer.Size > 1 && prev_cmd->RectInstCount > 0 && prev_cmd->RectInstOffset + prev_cmd->RectInstCount == (unsigned int)RectInstBuffer.Size && memcmp(&prev_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) == 0)
+    {
+        prev_cmd->RectInstCount++;
+    }
+    else
+    {
+        if (curr_cmd->ElemCount != 0)
+        {
+            AddDrawCmd();
+            curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+        }
+        curr_cmd->RectInstOffset = (unsigned int)RectInstBuffer.Size;
+        curr_cmd->RectInstCount = 1;
+        AddDrawCmd(); // Force a new command after us
+    }
+    RectInstBuffer.push_back(inst);
+}
+
 // p_min = upper-left, p_max = lower-right
 void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_max, ImU32 col_upr_left, ImU32 col_upr_right, ImU32 col_bot_right, ImU32 col_bot_left)
 {
@@ -1535,6 +1788,15 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX); // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
+    if ((Flags & ImDrawListFlags_ShapeCache) && radius - 0.5f >= 0.5f)
+    {
+        const int a_step = (num_segments <= 0) ? ImClamp(IM_DRAWLIST_ARCFAST_SAMPLE_MAX / _CalcCircleAutoSegmentCount(radius - 0.5f), 1, IM_DRAWLIST_ARCFAST_TABLE_SIZE / 4) : 0;
+        _AddCircleCached(center, radius - 0.5f, col, a_step, num_segments, thickness, false);
+        return;
+    }
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1543,9 +1805,6 @@ void ImDrawList::AddCircle(const ImVec2& center, float radius, ImU32 col, int nu
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius - 0.5f, 0.0f, a_max, num_segments - 1);
@@ -1559,6 +1818,15 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
         return;
 
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX); // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
+    if (Flags & ImDrawListFlags_ShapeCache)
+    {
+        const int a_step = (num_segments <= 0) ? ImClamp(IM_DRAWLIST_ARCFAST_SAMPLE_MAX / _CalcCircleAutoSegmentCount(radius), 1, IM_DRAWLIST_ARCFAST_TABLE_SIZE / 4) : 0;
+        _AddCircleCached(center, radius, col, a_step, num_segments, 0.0f, true);
+        return;
+    }
+
     if (num_segments <= 0)
     {
         // Use arc with automatic segment count
@@ -1567,9 +1835,6 @@ void ImDrawList::AddCircleFilled(const ImVec2& center, float radius, ImU32 col,
     }
     else
     {
-        // Explicit segment count (still clamp to avoid drawing insanely tessellated shapes)
-        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
-
         // Because we are filling a closed shape we remove 1 from the count of segments/points
         const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
         PathArcTo(center, radius, 0.0f, a_max, num_segments - 1);
@@ -1583,6 +1848,11 @@ void ImDrawList::AddNgon(const ImVec2& center, float radius, ImU32 col, int num_
 {
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
+    if ((Flags & ImDrawListFlags_ShapeCache) && radius - 0.5f >= 0.5f && num_segments <= IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX)
+    {
+        _AddCircleCached(center, radius - 0.5f, col, 0, num_segments, thickness, false);
+        return;
+    }
 
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1595,6 +1865,11 @@ void ImDrawList::AddNgonFilled(const ImVec2& center, float radius, ImU32 col, in
 {
     if ((col & IM_COL32_A_MASK) == 0 || num_segments <= 2)
         return;
+    if ((Flags & ImDrawListFlags_ShapeCache) && radius >= 0.5f && num_segments <= IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX)
+    {
+        _AddCircleCached(center, radius, col, 0, num_segments, 0.0f, true);
+        return;
+    }
 
     // Because we are filling a closed shape we remove 1 from the count of segments/points
     const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
@@ -1602,6 +1877,127 @@ void ImDrawList::AddNgonFilled(const ImVec2& center, float radius, ImU32 col, in
     PathFillConvex(col);
 }
 
+// Draw a closed circle or n-gon from ImDrawListSharedData::ShapeCache[], tessellating it around a unit circle on first use (ImDrawListFlags_ShapeCache).
+// - 'a_step > 0': same points as _PathArcToFastEx(center, radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, a_step) without the last one.
+// - 'a_step == 0': same points as PathArcTo(center, radius, 0.0f, a_max, num_segments - 1) with a_max excluding the last point.
+// Points are computed exactly as with the path functions. Stroke/fringe offsets are computed from the unit shape, so they may differ by a few ULP.
+void ImDrawList::_AddCircleCached(const ImVec2& center, float radius, ImU32 col, int a_step, int num_segments, float thickness, bool filled)
+{
+    ImDrawListSharedData* data = _Data;
+    ImDrawListShapeCacheKey key;
+    key.AStep = a_step;
+    key.NumSegments = (a_step > 0) ? 0 : num_segments;
+    key.Thickness = filled ? 0.0f : thickness;
+    key.Flags = Flags & (filled ? ImDrawListFlags_AntiAliasedFill : (ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex));
+    key.FringeScale = _FringeScale;
+
+    // Lookup, or find least recently used entry
+    ImDrawListShapeCacheEntry* entry = &data->ShapeCache[data->ShapeCacheLastIndex];
+    if (entry->LastUse == 0 || memcmp(&entry->Key, &key, sizeof(key)) != 0)
+    {
+        ImDrawListShapeCacheEntry* entry_lru = NULL;
+        entry = NULL;
+        for (ImDrawListShapeCacheEntry& e : data->ShapeCache)
+        {
+            if (e.LastUse != 0 && memcmp(&e.Key, &key, sizeof(key)) == 0)
+            {
+                entry = &e;
+                break;
+            }
+            if (entry_lru == NULL || e.LastUse < entry_lru->LastUse)
+                entry_lru = &e;
+        }
+        if (entry == NULL)
+        {
+            // Tessellate unit shape with a temporary draw list
+            IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+            entry = entry_lru;
+            entry->Key = key;
+            ImDrawList unit_draw_list(data);
+            unit_draw_list._ResetForNewFrame();
+            unit_draw_list.Flags = key.Flags;
+            unit_draw_list._FringeScale = _FringeScale;
+            if (a_step > 0)
+            {
+                unit_draw_list._PathArcToFastEx(ImVec2(0.0f, 0.0f), 1.0f, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, a_step);
+                unit_draw_list._Path.Size--;
+            }
+            else
+            {
+                const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+                unit_draw_list._PathArcToN(ImVec2(0.0f, 0.0f), 1.0f, 0.0f, a_max, num_segments - 1);
+            }
+            ImVector<ImVec2> unit_points;
+            unit_points.swap(unit_draw_list._Path);
+            const int points_count = unit_points.Size;
+            if (filled)
+                unit_draw_list.AddConvexPolyFilled(unit_points.Data, points_count, IM_COL32_WHITE);
+            else
+                unit_draw_list.AddPolyline(unit_points.Data, points_count, IM_COL32_WHITE, ImDrawFlags_Closed, thickness);
+
+            // Find which point each vertex derives from: AddPolyline() without anti-aliasing outputs 4 vertices per segment, other paths output N vertices per point.
+            const bool stroke_per_segment = !filled && !(key.Flags & ImDrawListFlags_AntiAliasedLines);
+            const int vtx_per_point = unit_draw_list.VtxBuffer.Size / points_count;
+            entry->TexLinesIndex = (int)ImMax(thickness, 1.0f);
+            const ImVec4 tex_uvs = (!filled && entry->TexLinesIndex <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX && data->TexUvLines) ? data->TexUvLines[entry->TexLinesIndex] : ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+            entry->VtxBuffer.resize(unit_draw_list.VtxBuffer.Size);
+            for (int vtx_n = 0; vtx_n < unit_draw_list.VtxBuffer.Size; vtx_n++)
+            {
+                const ImDrawVert& src = unit_draw_list.VtxBuffer.Data[vtx_n];
+                int point_n = stroke_per_segment ? (vtx_n >> 2) : (vtx_n / vtx_per_point);
+                if (stroke_per_segment && ((vtx_n & 3) == 1 || (vtx_n & 3) == 2))
+                    point_n = (point_n + 1 == points_count) ? 0 : point_n + 1;
+                ImDrawListShapeCacheVtx& dst = entry->VtxBuffer.Data[vtx_n];
+                dst.Dir = unit_points.Data[point_n];
+                dst.Offset = ImVec2(src.pos.x - dst.Dir.x, src.pos.y - dst.Dir.y);
+                dst.ColTrans = (src.col != IM_COL32_WHITE) ? 1 : 0;
+                dst.UvIndex = (src.uv.x == data->TexUvWhitePixel.x && src.uv.y == data->TexUvWhitePixel.y) ? 0 : (src.uv.x == tex_uvs.x && src.uv.y == tex_uvs.y) ? 1 : 2;
+            }
+            entry->IdxBuffer.resize(unit_draw_list.IdxBuffer.Size);
+            for (int idx_n = 0; idx_n < unit_draw_list.IdxBuffer.Size; idx_n++)
+                entry->IdxBuffer.Data[idx_n] = (ImU16)unit_draw_list.IdxBuffer.Data[idx_n];
+        }
+        data->ShapeCacheLastIndex = (int)(entry - data->ShapeCache);
+    }
+    entry->LastUse = ++data->ShapeCacheUseCounter;
+
+    // Emit translated, scaled and colored copy
+    const int vtx_count = entry->VtxBuffer.Size;
+    const int idx_count = entry->IdxBuffer.Size;
+    if (vtx_count == 0)
+        return;
+    PrimReserve(idx_count, vtx_count);
+    ImVec2 uvs[3];
+    uvs[0] = data->TexUvWhitePixel;
+    if (entry->TexLinesIndex <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX && data->TexUvLines)
+    {
+        const ImVec4 tex_uvs = data->TexUvLines[entry->TexLinesIndex];
+        uvs[1] = ImVec2(tex_uvs.x, tex_uvs.y);
+        uvs[2] = ImVec2(tex_uvs.z, tex_uvs.w);
+    }
+    else
+    {
+        uvs[1] = uvs[2] = uvs[0];
+    }
+    const ImU32 cols[2] = { col, col & ~IM_COL32_A_MASK };
+    const ImDrawListShapeCacheVtx* src = entry->VtxBuffer.Data;
+    ImDrawVert* vtx_write = _VtxWritePtr;
+    for (int vtx_n = 0; vtx_n < vtx_count; vtx_n++, src++, vtx_write++)
+    {
+        vtx_write->pos.x = center.x + src->Dir.x * radius + src->Offset.x;
+        vtx_write->pos.y = center.y + src->Dir.y * radius + src->Offset.y;
+        vtx_write->uv = uvs[src->UvIndex];
+        vtx_write->col = cols[src->ColTrans];
+    }
+    const unsigned int vtx_current_idx = _VtxCurrentIdx;
+    const ImU16* src_idx = entry->IdxBuffer.Data;
+    for (int idx_n = 0; idx_n < idx_count; idx_n++)
+        _IdxWritePtr[idx_n] = (ImDrawIdx)(vtx_current_idx + src_idx[idx_n]);
+    _VtxWritePtr = vtx_write;
+    _IdxWritePtr += idx_count;
+    _VtxCurrentIdx += (unsigned int)vtx_count;
+}
+
 // Ellipse
 void ImDrawList::AddEllipse(const ImVec2& center, const ImVec2& radius, ImU32 col, float rot, int num_segments, float thickness)
 {
@@ -1752,6 +2148,8 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 // Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
 // Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
 // Provided as a convenience for user but not used by main library.
+// With IM_DRAWLIST_CONCAVE_GRID_MIN_POINTS points or more, vertices are bucketed in a uniform grid so that
+// testing an ear only visits reflex vertices near the triangle. This produces the same triangles as a full scan.
 //-----------------------------------------------------------------------------
 // - ImTriangulator [Internal]
 // - AddConcavePolyFilled()
@@ -1768,6 +2166,8 @@ struct ImTriangulatorNode
 {
     ImTriangulatorNodeType  Type;
     int                     Index;
+    int                     SpanIndex;  // Position in _Ears[] or _Reflexes[] depending on Type
+    int                     Cell;       // Grid cell, when using a grid
     ImVec2                  Pos;
     ImTriangulatorNode*     Next;
     ImTriangulatorNode*     Prev;
@@ -1780,34 +2180,47 @@ struct ImTriangulatorNodeSpan
     ImTriangulatorNode**    Data = NULL;
     int                     Size = 0;
 
-    void    push_back(ImTriangulatorNode* node) { Data[Size++] = node; }
-    void    find_erase_unsorted(int idx)        { for (int i = Size - 1; i >= 0; i--) if (Data[i]->Index == idx) { Data[i] = Data[Size - 1]; Size--; return; } }
+    void    push_back(ImTriangulatorNode* node) { node->SpanIndex = Size; Data[Size++] = node; }
+    void    erase_unsorted(ImTriangulatorNode* node) { IM_ASSERT(Data[node->SpanIndex] == node); Data[node->SpanIndex] = Data[Size - 1]; Data[node->SpanIndex]->SpanIndex = node->SpanIndex; Size--; }
 };
 
 struct ImTriangulator
 {
     static int EstimateTriangleCount(int points_count)      { return (points_count < 3) ? 0 : points_count - 2; }
-    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2; }
+    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 3 + sizeof(int) * (CalcGridCellsMax(points_count) * 2 + 1); }
+    static int CalcGridCellsMax(int points_count)           { return (points_count < IM_DRAWLIST_CONCAVE_GRID_MIN_POINTS) ? 0 : points_count / 2; }
 
     void    Init(const ImVec2* points, int points_count, void* scratch_buffer);
     void    GetNextTriangle(unsigned int out_triangle[3]);     // Return relative indexes for next triangle
 
     // Internal functions
     void    BuildNodes(const ImVec2* points, int points_count);
+    void    BuildGrid(int points_count, int cells_max);
     void    BuildReflexes();
     void    BuildEars();
     void    FlipNodeList();
     bool    IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
     void    ReclassifyNode(ImTriangulatorNode* node);
+    void    AddReflex(ImTriangulatorNode* node)     { _Reflexes.push_back(node); if (_GridCellReflexCount) _GridCellReflexCount[node->Cell]++; }
+    void    RemoveReflex(ImTriangulatorNode* node)  { _Reflexes.erase_unsorted(node); if (_GridCellReflexCount) _GridCellReflexCount[node->Cell]--; }
 
     // Internal members
     int                     _TrianglesLeft = 0;
     ImTriangulatorNode*     _Nodes = NULL;
     ImTriangulatorNodeSpan  _Ears;
     ImTriangulatorNodeSpan  _Reflexes;
+
+    // Internal members: grid (NULL _GridCellStart when not used)
+    ImVec2                  _GridMin;
+    ImVec2                  _GridInvCellSize;
+    int                     _GridSizeX = 0;
+    int                     _GridSizeY = 0;
+    ImTriangulatorNode**    _GridNodes = NULL;              // points_count x Node*, sorted by cell
+    int*                    _GridCellStart = NULL;          // (cells + 1) x int, offsets in _GridNodes[]
+    int*                    _GridCellReflexCount = NULL;    // cells x int, to skip cells without reflexes
 };
 
-// Distribute storage for nodes, ears and reflexes.
+// Distribute storage for nodes, ears, reflexes and grid.
 // FIXME-OPT: if everything is convex, we could report it to caller and let it switch to an convex renderer
 // (this would require first building reflexes to bail to convex if empty, without even building nodes)
 void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_buffer)
@@ -1818,6 +2231,13 @@ void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_
     _Ears.Data     = (ImTriangulatorNode**)(_Nodes + points_count);                // points_count x Node*
     _Reflexes.Data = (ImTriangulatorNode**)(_Nodes + points_count) + points_count; // points_count x Node*
     BuildNodes(points, points_count);
+    if (int cells_max = CalcGridCellsMax(points_count))
+    {
+        _GridNodes = _Reflexes.Data + points_count;                                // points_count x Node*
+        _GridCellStart = (int*)(_GridNodes + points_count);                        // (cells_max + 1) x int
+        _GridCellReflexCount = _GridCellStart + cells_max + 1;                     // cells_max x int
+        BuildGrid(points_count, cells_max);
+    }
     BuildReflexes();
     BuildEars();
 }
@@ -1836,6 +2256,39 @@ void ImTriangulator::BuildNodes(const ImVec2* points, int points_count)
     _Nodes[points_count - 1].Next = _Nodes;
 }
 
+// Sort nodes by cell of a grid covering the polygon bounding box. Cells are about square, with 2 points per cell on average.
+void ImTriangulator::BuildGrid(int points_count, int cells_max)
+{
+    ImVec2 p_min = _Nodes[0].Pos, p_max = _Nodes[0].Pos;
+    for (int i = 1; i < points_count; i++)
+    {
+        p_min = ImMin(p_min, _Nodes[i].Pos);
+        p_max = ImMax(p_max, _Nodes[i].Pos);
+    }
+    const float w = ImMax(p_max.x - p_min.x, 1e-6f);
+    const float h = ImMax(p_max.y - p_min.y, 1e-6f);
+    _GridSizeX = ImClamp((int)ImSqrt(cells_max * w / h), 1, cells_max);
+    _GridSizeY = ImClamp(cells_max / _GridSizeX, 1, cells_max);
+    _GridMin = p_min;
+    _GridInvCellSize = ImVec2(_GridSizeX / w, _GridSizeY / h);
+
+    const int cells_count = _GridSizeX * _GridSizeY;
+    memset(_GridCellStart, 0, sizeof(int) * (cells_count + 1));
+    memset(_GridCellReflexCount, 0, sizeof(int) * cells_count);
+    for (int i = 0; i < points_count; i++)
+    {
+        const int cx = ImClamp((int)((_Nodes[i].Pos.x - p_min.x) * _GridInvCellSize.x), 0, _GridSizeX - 1);
+        const int cy = ImClamp((int)((_Nodes[i].Pos.y - p_min.y) * _GridInvCellSize.y), 0, _GridSizeY - 1);
+        _Nodes[i].Cell = cy * _GridSizeX + cx;
+        _GridCellStart[_Nodes[i].Cell + 1]++;
+    }
+    for (int cell = 0; cell < cells_count; cell++)
+        _GridCellStart[cell + 1] += _GridCellStart[cell];
+    for (int i = 0; i < points_count; i++)
+        _GridNodes[_GridCellReflexCount[_Nodes[i].Cell]++ + _GridCellStart[_Nodes[i].Cell]] = &_Nodes[i]; // Use reflex counts as cursors
+    memset(_GridCellReflexCount, 0, sizeof(int) * cells_count);
+}
+
 void ImTriangulator::BuildReflexes()
 {
     ImTriangulatorNode* n1 = _Nodes;
@@ -1844,7 +2297,7 @@ void ImTriangulator::BuildReflexes()
         if (ImTriangleIsClockwise(n1->Prev->Pos, n1->Pos, n1->Next->Pos))
             continue;
         n1->Type = ImTriangulatorNodeType_Reflex;
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     }
 }
 
@@ -1868,10 +2321,14 @@ void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
     {
         FlipNodeList();
 
+        while (_Reflexes.Size > 0)
+        {
+            _Reflexes.Data[_Reflexes.Size - 1]->Type = ImTriangulatorNodeType_Convex;
+            RemoveReflex(_Reflexes.Data[_Reflexes.Size - 1]);
+        }
         ImTriangulatorNode* node = _Nodes;
         for (int i = _TrianglesLeft; i >= 0; i--, node = node->Next)
             node->Type = ImTriangulatorNodeType_Convex;
-        _Reflexes.Size = 0;
         BuildReflexes();
         BuildEars();
 
@@ -1924,6 +2381,58 @@ void ImTriangulator::FlipNodeList()
 // A triangle is an ear is no other vertex is inside it. We can test reflexes vertices only (see reference algorithm)
 bool ImTriangulator::IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
 {
+    if (_GridCellStart != NULL)
+    {
+        // Visit cells overlapping the triangle, row by row. Triangles spanning several rows are often long and thin (fans),
+        // so we use the horizontal extent of the triangle within each row. Rows and extents are enlarged by 1% of a cell to be conservative with rounding.
+        const ImVec2* tri[3] = { &v0, &v1, &v2 };
+        const ImVec2 tri_min = ImMin(ImMin(v0, v1), v2);
+        const ImVec2 tri_max = ImMax(ImMax(v0, v1), v2);
+        const float cell_w = 1.0f / _GridInvCellSize.x;
+        const float cell_h = 1.0f / _GridInvCellSize.y;
+        const int cy0 = ImClamp((int)((tri_min.y - _GridMin.y) * _GridInvCellSize.y), 0, _GridSizeY - 1);
+        const int cy1 = ImClamp((int)((tri_max.y - _GridMin.y) * _GridInvCellSize.y), 0, _GridSizeY - 1);
+        for (int cy = cy0; cy <= cy1; cy++)
+        {
+            const float y_lo = ImMax(_GridMin.y + (cy - 0.01f) * cell_h, tri_min.y);
+            const float y_hi = ImMin(_GridMin.y + (cy + 1.01f) * cell_h, tri_max.y);
+            float x_lo = tri_min.x, x_hi = tri_max.x;
+            if (cy0 != cy1)
+            {
+                x_lo = tri_max.x;
+                x_hi = tri_min.x;
+                for (int edge = 0; edge < 3; edge++)
+                {
+                    ImVec2 a = *tri[edge], b = *tri[(edge + 1) % 3];
+                    if (a.y > b.y)
+                        ImSwap(a, b);
+                    if (b.y < y_lo || a.y > y_hi)
+                        continue;
+                    const float dx_dy = (b.y > a.y) ? (b.x - a.x) / (b.y - a.y) : 0.0f;
+                    const float xa = (a.y < y_lo) ? a.x + (y_lo - a.y) * dx_dy : a.x;
+                    const float xb = (b.y > y_hi) ? a.x + (y_hi - a.y) * dx_dy : b.x;
+                    x_lo = ImMin(x_lo, ImMin(xa, xb));
+                    x_hi = ImMax(x_hi, ImMax(xa, xb));
+                }
+            }
+            const int cx0 = ImClamp((int)((x_lo - cell_w * 0.01f - _GridMin.x) * _GridInvCellSize.x), 0, _GridSizeX - 1);
+            const int cx1 = ImClamp((int)((x_hi + cell_w * 0.01f - _GridMin.x) * _GridInvCellSize.x), 0, _GridSizeX - 1);
+            for (int cell = cy * _GridSizeX + cx0, cell_end = cy * _GridSizeX + cx1; cell <= cell_end; cell++)
+            {
+                if (_GridCellReflexCount[cell] == 0)
+                    continue;
+                for (ImTriangulatorNode** p = _GridNodes + _GridCellStart[cell], ** p_end = _GridNodes + _GridCellStart[cell + 1]; p < p_end; p++)
+                {
+                    ImTriangulatorNode* reflex = *p;
+                    if (reflex->Type == ImTriangulatorNodeType_Reflex && reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
+                        if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
+                            return false;
+                }
+            }
+        }
+        return true;
+    }
+
     ImTriangulatorNode** p_end = _Reflexes.Data + _Reflexes.Size;
     for (ImTriangulatorNode** p = _Reflexes.Data; p < p_end; p++)
     {
@@ -1952,11 +2461,11 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     if (type == n1->Type)
         return;
     if (n1->Type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.find_erase_unsorted(n1->Index);
+        RemoveReflex(n1);
     else if (n1->Type == ImTriangulatorNodeType_Ear)
-        _Ears.find_erase_unsorted(n1->Index);
+        _Ears.erase_unsorted(n1);
     if (type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     else if (type == ImTriangulatorNodeType_Ear)
         _Ears.push_back(n1);
     n1->Type = type;
@@ -1969,6 +2478,7 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
 // Caller can build AABB of points, and avoid filling if 'draw_list->_CmdHeader.ClipRect.Overlays(points_bb) == false')
 void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_count, ImU32 col)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -1997,30 +2507,19 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals of each edge, then averaged normals at each point
+        const bool use_simd = !_Data->UseScalarKernels;
+        _Data->TempBuffer.reserve_discard(points_count * 2);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        ImVec2* temp_point_normals = temp_normals + points_count;
+        ImDrawList_CalcSegmentNormals(points, points_count, points_count, temp_normals, use_simd);
+        ImDrawList_CalcPointNormals(temp_normals, points_count, true, temp_point_normals, use_simd);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+            // Averaged normals
+            const float dm_x = temp_point_normals[i1].x * (AA_SIZE * 0.5f);
+            const float dm_y = temp_point_normals[i1].y * (AA_SIZE * 0.5f);
 
             // Add vertices
             _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
@@ -2079,6 +2578,7 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     IM_UNUSED(draw_list);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
@@ -2109,6 +2609,7 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     // Note that we never use or rely on _Channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_Count <= 1)
         return;
@@ -2124,7 +2625,7 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
     for (int i = 1; i < _Count; i++)
     {
         ImDrawChannel& ch = _Channels[i];
-        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL) // Equivalent of PopUnusedDrawCmd()
+        if (ch._CmdBuffer.Size > 0 && ch._CmdBuffer.back().ElemCount == 0 && ch._CmdBuffer.back().UserCallback == NULL && ch._CmdBuffer.back().RectInstCount == 0) // Equivalent of PopUnusedDrawCmd()
             ch._CmdBuffer.pop_back();
 
         if (ch._CmdBuffer.Size > 0 && last_cmd != NULL)
@@ -2132,7 +2633,7 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
             // Do not include ImDrawCmd_AreSequentialIdxOffset() in the compare as we rebuild IdxOffset values ourselves.
             // Manipulating IdxOffset (e.g. by reordering draw commands like done by RenderDimmedBackgroundBehindWindow()) is not supported within a splitter.
             ImDrawCmd* next_cmd = &ch._CmdBuffer[0];
-            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL)
+            if (ImDrawCmd_HeaderCompare(last_cmd, next_cmd) == 0 && last_cmd->UserCallback == NULL && next_cmd->UserCallback == NULL && last_cmd->RectInstCount == 0 && next_cmd->RectInstCount == 0)
             {
                 // Merge previous channel last draw command with current channel first draw command if matching.
                 last_cmd->ElemCount += next_cmd->ElemCount;
@@ -2164,8 +2665,8 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
     }
     draw_list->_IdxWritePtr = idx_write;
 
-    // Ensure there's always a non-callback draw command trailing the command-buffer
-    if (draw_list->CmdBuffer.Size == 0 || draw_list->CmdBuffer.back().UserCallback != NULL)
+    // Ensure there's always a non-callback, non-instance draw command trailing the command-buffer
+    if (draw_list->CmdBuffer.Size == 0 || draw_list->CmdBuffer.back().UserCallback != NULL || draw_list->CmdBuffer.back().RectInstCount != 0)
         draw_list->AddDrawCmd();
 
     // If current command is used with different settings we need to add a new command
@@ -2209,19 +2710,23 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
 void ImDrawData::Clear()
 {
     Valid = false;
-    CmdListsCount = TotalIdxCount = TotalVtxCount = 0;
+    CmdListsCount = TotalIdxCount = TotalVtxCount = TotalRectInstCount = 0;
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
+    VtxCompact = false;
+    DamageRectsValid = false;
+    DamageRects.resize(0);
 }
 
 // Important: 'out_list' is generally going to be draw_data->CmdLists, but may be another temporary list
 // as long at it is expected that the result will be later merged into draw_data->CmdLists[].
 void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     if (draw_list->CmdBuffer.Size == 0)
         return;
-    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL)
+    if (draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->CmdBuffer[0].UserCallback == NULL && draw_list->CmdBuffer[0].RectInstCount == 0)
         return;
 
     // Draw list sanity check. Detect mismatch between PrimReserve() calls and incrementing _VtxCurrentIdx, _VtxWritePtr etc.
@@ -2260,13 +2765,75 @@ void ImGui::AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>
     draw_data->CmdListsCount++;
     draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
     draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
+    draw_data->TotalRectInstCount += draw_list->RectInstBuffer.Size;
+}
+
+// Fill the buffers of alternate formats requested by the renderer, once all lists of 'draw_data' are finalized:
+// - ImDrawList::VtxBufferCompact[] (ImGuiBackendFlags_RendererHasVtxCompact). All or nothing: a single vertex outside of the
+//   representable range (positions too far from DisplayPos, texture coordinates outside of 0..1) and ImDrawData::VtxCompact stays false.
+// - ImDrawList::IdxBuffer32[] (ImGuiBackendFlags_RendererHasIdx32), only for lists which 16-bit indices can't address without VtxOffset.
+void ImGui::BuildDrawDataAlternateBuffers(ImDrawData* draw_data, bool vtx_compact, bool idx32)
+{
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+    draw_data->VtxCompact = false;
+    if (vtx_compact)
+    {
+        const ImVec2 origin = draw_data->DisplayPos;
+        const float pos_min = -32768.0f, pos_max = 32767.0f;
+        bool fits = true;
+        for (int list_n = 0; list_n < draw_data->CmdLists.Size && fits; list_n++)
+        {
+            ImDrawList* draw_list = draw_data->CmdLists[list_n];
+            draw_list->VtxBufferCompact.resize(draw_list->VtxBuffer.Size);
+            ImDrawVertCompact* dst = draw_list->VtxBufferCompact.Data;
+            for (const ImDrawVert* src = draw_list->VtxBuffer.Data; src < draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size; src++, dst++)
+            {
+                const float x = ImFloor((src->pos.x - origin.x) * IM_DRAWVERT_COMPACT_POS_SCALE + 0.5f);
+                const float y = ImFloor((src->pos.y - origin.y) * IM_DRAWVERT_COMPACT_POS_SCALE + 0.5f);
+                if (!(x >= pos_min && x <= pos_max && y >= pos_min && y <= pos_max && src->uv.x >= 0.0f && src->uv.x <= 1.0f && src->uv.y >= 0.0f && src->uv.y <= 1.0f)) // Also reject NaN
+                {
+                    fits = false;
+                    break;
+                }
+                dst->pos[0] = (ImS16)x;
+                dst->pos[1] = (ImS16)y;
+                dst->uv[0] = (ImU16)(src->uv.x * 65535.0f + 0.5f);
+                dst->uv[1] = (ImU16)(src->uv.y * 65535.0f + 0.5f);
+                dst->col = src->col;
+            }
+        }
+        if (!fits)
+            for (ImDrawList* draw_list : draw_data->CmdLists)
+                draw_list->VtxBufferCompact.resize(0);
+        draw_data->VtxCompact = fits;
+    }
+
+    for (ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        if (!idx32 || sizeof(ImDrawIdx) > 2 || draw_list->VtxBuffer.Size <= (1 << 16))
+        {
+            draw_list->IdxBuffer32.resize(0);
+            continue;
+        }
+        draw_list->IdxBuffer32.resize(draw_list->IdxBuffer.Size);
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            const ImDrawIdx* src = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+            ImU32* dst = draw_list->IdxBuffer32.Data + cmd.IdxOffset;
+            for (unsigned int n = 0; n < cmd.ElemCount; n++)
+                dst[n] = cmd.VtxOffset + src[n];
+        }
+    }
 }
 
 void ImDrawData::AddDrawList(ImDrawList* draw_list)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
     IM_ASSERT(CmdLists.Size == CmdListsCount);
     draw_list->_PopUnusedDrawCmd();
+    draw_list->_FlushTextRuns();
     ImGui::AddDrawListToDrawDataEx(this, &CmdLists, draw_list);
+    VtxCompact = false; // Compact buffers are only built by Render()
 }
 
 // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
@@ -2274,6 +2841,7 @@ void ImDrawData::DeIndexAllBuffers()
 {
     ImVector<ImDrawVert> new_vtx_buffer;
     TotalVtxCount = TotalIdxCount = 0;
+    VtxCompact = false;
     for (int i = 0; i < CmdListsCount; i++)
     {
         ImDrawList* cmd_list = CmdLists[i];
@@ -2284,6 +2852,7 @@ void ImDrawData::DeIndexAllBuffers()
             new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
         cmd_list->VtxBuffer.swap(new_vtx_buffer);
         cmd_list->IdxBuffer.resize(0);
+        cmd_list->IdxBuffer32.resize(0);
         TotalVtxCount += cmd_list->VtxBuffer.Size;
     }
 }
@@ -2302,9 +2871,17 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // [SECTION] Helpers ShadeVertsXXX functions
 //-----------------------------------------------------------------------------
 
+// Vertices of deferred text (ImDrawListFlags_DeferText) in the range need to be written first
+static inline void ShadeVertsFlushTextRuns(ImDrawList* draw_list, int vert_start_idx)
+{
+    if (draw_list->_TextRuns.Size > 0 && draw_list->_TextRuns.back().VtxOffset + draw_list->_TextRuns.back().QuadsCount * 4 > vert_start_idx)
+        draw_list->_FlushTextRuns();
+}
+
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    ShadeVertsFlushTextRuns(draw_list, vert_start_idx);
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
@@ -2329,6 +2906,7 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    ShadeVertsFlushTextRuns(draw_list, vert_start_idx);
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -2353,6 +2931,7 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
 
 void ImGui::ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out)
 {
+    ShadeVertsFlushTextRuns(draw_list, vert_start_idx);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
     for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
@@ -2494,6 +3073,7 @@ void    ImFontAtlas::Clear()
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     // Build atlas on demand
     if (TexPixelsAlpha8 == NULL)
         Build();
@@ -2506,6 +3086,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -2530,6 +3111,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f && "Is ImFontConfig struct correctly initialized?");
@@ -2582,6 +3164,7 @@ static void         Decode85(const unsigned char* src, unsigned char* dst)
 // Load embedded ProggyClean.ttf at size 13, disable oversampling
 ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     ImFontConfig font_cfg = font_cfg_template ? *font_cfg_template : ImFontConfig();
     if (!font_cfg_template)
     {
@@ -2603,6 +3186,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 
 ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     size_t data_size = 0;
     void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
@@ -2639,6 +3223,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* font_data, int font_data_size, f
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     const unsigned int buf_decompressed_size = stb_decompress_length((const unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char*)IM_ALLOC(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -2651,6 +3236,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_d
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg, const ImWchar* glyph_ranges)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     int compressed_ttf_size = (((int)strlen(compressed_ttf_data_base85) + 4) / 5) * 4;
     void* compressed_ttf = IM_ALLOC((size_t)compressed_ttf_size);
     Decode85((const unsigned char*)compressed_ttf_data_base85, (unsigned char*)compressed_ttf);
@@ -2661,6 +3247,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
 
 int ImFontAtlas::AddCustomRectRegular(int width, int height)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
     ImFontAtlasCustomRect r;
@@ -2672,6 +3259,7 @@ int ImFontAtlas::AddCustomRectRegular(int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
 #ifdef IMGUI_USE_WCHAR32
     IM_ASSERT(id <= IM_UNICODE_CODEPOINT_MAX);
 #endif
@@ -2720,6 +3308,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
 
     // Default font is none are specified
@@ -3300,6 +3889,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             font->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->BuildCount++;
 }
 
 // Retrieve list of range (2 int per range, values are inclusive)
@@ -3658,6 +4248,7 @@ static ImWchar FindFirstExistingGlyph(ImFont* font, const ImWchar* candidate_cha
 
 void ImFont::BuildLookupTable()
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     int max_codepoint = 0;
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
@@ -3773,6 +4364,7 @@ void ImFont::GrowIndex(int new_size)
 // 'cfg' is not necessarily == 'this->ConfigData' because multiple source fonts+configs can be used to build one target font.
 void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     if (cfg != NULL)
     {
         // Clamp & recenter if needed
@@ -3817,6 +4409,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Fonts);
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
     unsigned int index_size = (unsigned int)IndexLookup.Size;
 
@@ -3894,7 +4487,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
         if (c < 0x80)
             next_s = s + 1;
         else
-            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+            next_s = s + ImTextDecodeUtf8(&c, s, text_end);
 
         if (c < 32)
         {
@@ -3996,13 +4589,30 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Printable ASCII characters don't need decoding nor checking for line breaks
+        const char* ascii_end = ImTextSkipPrintableAscii(s, word_wrap_enabled ? word_wrap_eol : text_end);
+        if (s < ascii_end && IndexAdvanceX.Size >= 0x80)
+        {
+            const float* advance_x = IndexAdvanceX.Data;
+            for (; s < ascii_end; s++)
+            {
+                const float char_width = advance_x[(unsigned char)*s] * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < ascii_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
             s += 1;
         else
-            s += ImTextCharFromUtf8(&c, s, text_end);
+            s += ImTextDecodeUtf8(&c, s, text_end);
 
         if (c < 32)
         {
@@ -4054,6 +4664,213 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+// Write quad of a glyph, with horizontal clipping and optional CPU fine clipping. Return false if it was clipped out.
+static inline bool ImFont_WriteGlyphQuad(ImDrawVert*& vtx_write, ImDrawIdx*& idx_write, unsigned int& vtx_index, float x1, float y1, float x2, float y2, float u1, float v1, float u2, float v2, ImU32 col, const ImVec4& clip_rect, bool cpu_fine_clip, bool use_simd)
+{
+#ifndef IMGUI_ENABLE_SSE_DRAWVERT
+    IM_UNUSED(use_simd);
+#endif
+    // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
+    if (x1 > clip_rect.z || x2 < clip_rect.x)
+        return false;
+
+    // CPU side clipping used to fit text in their frame when the frame is too small. Only does clipping for axis aligned quads.
+    if (cpu_fine_clip)
+    {
+        if (x1 < clip_rect.x)
+        {
+            u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
+            x1 = clip_rect.x;
+        }
+        if (y1 < clip_rect.y)
+        {
+            v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
+            y1 = clip_rect.y;
+        }
+        if (x2 > clip_rect.z)
+        {
+            u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
+            x2 = clip_rect.z;
+        }
+        if (y2 > clip_rect.w)
+        {
+            v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
+            y2 = clip_rect.w;
+        }
+        if (y1 >= y2)
+            return false;
+    }
+
+    // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+    if (use_simd)
+    {
+        ImDrawList_WriteRectVtxSSE(vtx_write, _mm_setr_ps(x1, y1, x2, y2), _mm_setr_ps(u1, v1, u2, v2), col);
+        vtx_write += 4;
+        if (idx_write)
+        {
+            ImDrawList_WriteRectIdxSSE(idx_write, (ImDrawIdx)vtx_index);
+            vtx_index += 4;
+            idx_write += 6;
+        }
+        return true;
+    }
+#endif
+    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+    vtx_write += 4;
+    if (idx_write)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+        idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+        vtx_index += 4;
+        idx_write += 6;
+    }
+    return true;
+}
+
+// Write quads of glyphs in [s, text_end), starting at (x, y) which is the beginning of a line. Return the number of quads written.
+// With idx_write == NULL only vertices are written: this is used by ImDrawList::_ExpandTextRuns(), indices being written by ImDrawList::_AddTextRun().
+static inline int ImFont_RenderTextGlyphs(ImFont* font, ImDrawVert* vtx_write, ImDrawIdx* idx_write, unsigned int vtx_index, float x, float y, float scale, ImU32 col, const ImVec4& clip_rect, const char* s, const char* text_end, float wrap_width, bool cpu_fine_clip, bool use_simd)
+{
+    const float start_x = x;
+    const float line_height = font->FontSize * scale;
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const ImDrawVert* vtx_write_start = vtx_write;
+
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    const char* word_wrap_eol = NULL;
+
+    while (s < text_end)
+    {
+        if (word_wrap_enabled)
+        {
+            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
+            if (!word_wrap_eol)
+                word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - start_x));
+
+            if (s >= word_wrap_eol)
+            {
+                x = start_x;
+                y += line_height;
+                if (y > clip_rect.w)
+                    break; // break out of main loop
+                word_wrap_eol = NULL;
+                s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+                continue;
+            }
+        }
+
+        // Printable ASCII characters don't need decoding nor checking for line breaks
+        const char* ascii_end = ImTextSkipPrintableAscii(s, word_wrap_enabled ? word_wrap_eol : text_end);
+        if (s < ascii_end)
+        {
+            for (; s < ascii_end; s++)
+            {
+                const ImFontGlyph* glyph = font->FindGlyph((ImWchar)(unsigned char)*s);
+                if (glyph == NULL)
+                    continue;
+                float char_width = glyph->AdvanceX * scale;
+                if (glyph->Visible)
+                    ImFont_WriteGlyphQuad(vtx_write, idx_write, vtx_index, x + glyph->X0 * scale, y + glyph->Y0 * scale, x + glyph->X1 * scale, y + glyph->Y1 * scale, glyph->U0, glyph->V0, glyph->U1, glyph->V1, glyph->Colored ? col_untinted : col, clip_rect, cpu_fine_clip, use_simd);
+                x += char_width;
+            }
+            continue;
+        }
+
+        // Decode and advance source
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextDecodeUtf8(&c, s, text_end);
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                x = start_x;
+                y += line_height;
+                if (y > clip_rect.w)
+                    break; // break out of main loop
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c);
+        if (glyph == NULL)
+            continue;
+
+        float char_width = glyph->AdvanceX * scale;
+        if (glyph->Visible)
+            ImFont_WriteGlyphQuad(vtx_write, idx_write, vtx_index, x + glyph->X0 * scale, y + glyph->Y0 * scale, x + glyph->X1 * scale, y + glyph->Y1 * scale, glyph->U0, glyph->V0, glyph->U1, glyph->V1, glyph->Colored ? col_untinted : col, clip_rect, cpu_fine_clip, use_simd); // Support for untinted glyphs
+        x += char_width;
+    }
+    return (int)(vtx_write - vtx_write_start) / 4;
+}
+
+// Same as ImFont::RenderText() with ImFont_RenderTextGlyphs(), from a cached layout (ImDrawListFlags_TextLayoutCache): without decoding text and looking up glyphs.
+static void ImFont_RenderTextLayout(ImDrawList* draw_list, ImDrawTextLayout* layout, float x, float y, ImU32 col, const ImVec4& clip_rect, bool cpu_fine_clip)
+{
+    if (!layout->GlyphsReady)
+        layout->BuildGlyphs();
+    const float start_x = x;
+    const float line_height = layout->Font->FontSize * layout->Scale;
+    const ImDrawTextLayoutGlyph* glyph = layout->Glyphs.Data;
+    const ImDrawTextLayoutGlyph* glyph_end = glyph + layout->Glyphs.Size;
+
+    // Fast-forward to first visible line
+    int text_offset = 0;
+    while (y + line_height < clip_rect.y && glyph < glyph_end)
+    {
+        while (glyph < glyph_end && !glyph->NewLine)
+            glyph++;
+        if (glyph < glyph_end)
+            text_offset = (glyph++)->TextOffset;
+        y += line_height;
+    }
+    if (glyph == glyph_end)
+        return;
+
+    // Reserve as many vertices as ImFont::RenderText() would (this matters when ImDrawListFlags_AllowVtxOffset starts a new command)
+    const int vtx_count_max = (layout->Text.Size - text_offset) * 4;
+    const int idx_count_max = (layout->Text.Size - text_offset) * 6;
+    const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+    draw_list->PrimReserve(idx_count_max, vtx_count_max);
+
+    const bool use_simd = !draw_list->_Data->UseScalarKernels;
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_index = draw_list->_VtxCurrentIdx;
+    for (; glyph < glyph_end; glyph++)
+    {
+        if (glyph->NewLine)
+        {
+            x = start_x;
+            y += line_height;
+            if (y > clip_rect.w)
+                break;
+            continue;
+        }
+        if (glyph->Visible)
+            ImFont_WriteGlyphQuad(vtx_write, idx_write, vtx_index, x + glyph->X0, y + glyph->Y0, x + glyph->X1, y + glyph->Y1, glyph->U0, glyph->V0, glyph->U1, glyph->V1, glyph->Colored ? col_untinted : col, clip_rect, cpu_fine_clip, use_simd);
+        x += glyph->AdvanceX;
+    }
+
+    // Give back unused vertices
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_index;
+    draw_list->VtxBuffer.Size = (int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data);
+    draw_list->IdxBuffer.Size = (int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
 {
@@ -4066,10 +4883,18 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (y > clip_rect.w)
         return;
 
-    const float start_x = x;
     const float scale = size / FontSize;
     const float line_height = FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const bool defer = (draw_list->Flags & ImDrawListFlags_DeferText) && !word_wrap_enabled;
+
+    // Cached layout: skip decoding text and looking up glyphs
+    if ((draw_list->Flags & ImDrawListFlags_TextLayoutCache) && !defer && ImDrawTextLayoutCache::IsCacheable((int)(text_end - text_begin), wrap_width))
+        if (ImDrawTextLayout* layout = draw_list->_Data->TextLayoutCache.GetLayout(this, size, wrap_width, text_begin, text_end))
+        {
+            ImFont_RenderTextLayout(draw_list, layout, x, y, col, clip_rect, cpu_fine_clip);
+            return;
+        }
 
     // Fast-forward to first visible line
     const char* s = text_begin;
@@ -4109,34 +4934,176 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     if (s == text_end)
         return;
 
+    // Deferred text: reserve quads and write indices now, vertices will be written by Render()
+    if (defer)
+    {
+        draw_list->_AddTextRun(this, size, ImVec2(x, y), col, clip_rect, s, text_end, cpu_fine_clip);
+        return;
+    }
+
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
     const int vtx_count_max = (int)(text_end - s) * 4;
     const int idx_count_max = (int)(text_end - s) * 6;
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
     draw_list->PrimReserve(idx_count_max, vtx_count_max);
-    ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
-    ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
-    unsigned int vtx_index = draw_list->_VtxCurrentIdx;
+    const int quads_count = ImFont_RenderTextGlyphs(this, draw_list->_VtxWritePtr, draw_list->_IdxWritePtr, draw_list->_VtxCurrentIdx, x, y, scale, col, clip_rect, s, text_end, wrap_width, cpu_fine_clip, !draw_list->_Data->UseScalarKernels);
 
-    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
-    const char* word_wrap_eol = NULL;
+    // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
+    draw_list->_VtxWritePtr += quads_count * 4;
+    draw_list->_IdxWritePtr += quads_count * 6;
+    draw_list->_VtxCurrentIdx += quads_count * 4;
+    draw_list->VtxBuffer.Size = (int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data); // Same as calling shrink()
+    draw_list->IdxBuffer.Size = (int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+}
 
+// Record text for ImDrawListFlags_DeferText. Called by ImFont::RenderText() with 'pos' aligned to pixel and 'text_begin' being the first visible line.
+// - We reserve one quad per character which may output a glyph and write their indices now. Characters are counted without decoding them,
+//   stepping over UTF-8 sequences the same way as ImTextCharFromUtf8(). Spaces (when invisible), "\r" and "\n" don't output a glyph.
+// - Large text is split at line boundaries into runs of about IM_DRAWLIST_TEXT_RUN_SPLIT_SIZE bytes, which may be expanded on different threads.
+void ImDrawList::_AddTextRun(ImFont* font, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, bool cpu_fine_clip)
+{
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    const ImFontGlyph* space_glyph = font->FindGlyph(' ');
+    const bool space_visible = (space_glyph != NULL && space_glyph->Visible);
+
+    const int text_offset = _TextRunsBuf.Size;
+    const char* s = text_begin;
+    float y = pos.y;
     while (s < text_end)
     {
+        const char* run_begin = s;
+        const float run_y = y;
+        int quads_count = 0;
+        while (s < text_end)
+        {
+            // Step over characters as ImTextCharFromUtf8() does, including on invalid UTF-8: a lead byte takes the length of its sequence,
+            // or fewer bytes when there are zeros among the next 4 bytes (or the text ends). A "\n" inside an invalid sequence doesn't break the line.
+            const unsigned char c = (unsigned char)*s;
+            int char_len = 1;
+            if (c >= 0xC0 && c < 0xF8)
+            {
+                int non_zero_bytes = 0;
+                for (int n = 0; n < 4 && s + n < text_end; n++)
+                    non_zero_bytes += (s[n] != 0);
+                char_len = ImMin((c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : 2, non_zero_bytes);
+            }
+            s += char_len;
+            if (c == '\n')
+            {
+                y += line_height;
+                if (y > clip_rect.w)
+                    text_end = s; // Same as rendering: stop after the last visible line
+                if (s - run_begin >= IM_DRAWLIST_TEXT_RUN_SPLIT_SIZE)
+                    break;
+            }
+            else if (c != '\r' && (c != ' ' || space_visible))
+            {
+                quads_count++;
+            }
+        }
+        if (quads_count == 0)
+            continue;
+
+        PrimReserve(quads_count * 6, quads_count * 4);
+        ImDrawTextRun run;
+        run.Font = font;
+        run.Size = size;
+        run.Pos = ImVec2(pos.x, run_y);
+        run.Col = col;
+        run.CpuFineClip = cpu_fine_clip;
+        run.ClipRect = clip_rect;
+        run.TextOffset = text_offset + (int)(run_begin - text_begin);
+        run.TextLength = (int)(s - run_begin);
+        run.VtxOffset = (int)(_VtxWritePtr - VtxBuffer.Data);
+        run.QuadsCount = quads_count;
+        _TextRuns.push_back(run);
+
+        ImDrawIdx* idx_write = _IdxWritePtr;
+        unsigned int vtx_index = _VtxCurrentIdx;
+        for (int n = 0; n < quads_count; n++, idx_write += 6, vtx_index += 4)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+            idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+        }
+        _VtxWritePtr += quads_count * 4;
+        _IdxWritePtr = idx_write;
+        _VtxCurrentIdx = vtx_index;
+    }
+
+    // Keep a copy of the text, as it often lives in temporary buffers
+    _TextRunsBuf.resize(text_offset + (int)(text_end - text_begin));
+    memcpy(_TextRunsBuf.Data + text_offset, text_begin, (size_t)(text_end - text_begin));
+}
+
+// Write vertices of _TextRuns[run_begin..run_end). Quads which ended up not being used (clipped or invisible glyphs, invalid UTF-8 sequences) are zero-area quads.
+// Different ranges of runs may be expanded concurrently: each run only writes to its own range of VtxBuffer[].
+void ImDrawList::_ExpandTextRuns(int run_begin, int run_end)
+{
+    IM_ASSERT(run_begin >= 0 && run_begin <= run_end && run_end <= _TextRuns.Size);
+    const bool use_simd = !_Data->UseScalarKernels;
+    for (int run_n = run_begin; run_n < run_end; run_n++)
+    {
+        const ImDrawTextRun& run = _TextRuns.Data[run_n];
+        const char* text = _TextRunsBuf.Data + run.TextOffset;
+        ImDrawVert* vtx_write = VtxBuffer.Data + run.VtxOffset;
+        const int quads_count = ImFont_RenderTextGlyphs(run.Font, vtx_write, NULL, 0, run.Pos.x, run.Pos.y, run.Size / run.Font->FontSize, run.Col, run.ClipRect, text, text + run.TextLength, 0.0f, run.CpuFineClip, use_simd);
+        IM_ASSERT(quads_count <= run.QuadsCount);
+
+        ImDrawVert unused_vtx;
+        unused_vtx.pos = run.Pos;
+        unused_vtx.uv = _Data->TexUvWhitePixel;
+        unused_vtx.col = IM_COL32_BLACK_TRANS;
+        for (ImDrawVert* vtx = vtx_write + quads_count * 4, *vtx_end = vtx_write + run.QuadsCount * 4; vtx < vtx_end; vtx++)
+            *vtx = unused_vtx;
+    }
+}
+
+// Write vertices of all pending text runs. Render() does it for draw lists submitted to viewports (possibly in parallel),
+// this is for other uses of the vertices (e.g. ImDrawData::AddDrawList(), ShadeVertsXXX functions).
+void ImDrawList::_FlushTextRuns()
+{
+    if (_TextRuns.Size == 0)
+        return;
+    _ExpandTextRuns(0, _TextRuns.Size);
+    _TextRuns.resize(0);
+    _TextRunsBuf.resize(0);
+}
+
+// Decode text and lookup glyphs, the same way as ImFont_RenderTextGlyphs() from the beginning of a line.
+// FIXME: With word-wrapping, available width is computed from a position relative to 0.0f instead of the text position, which may round differently.
+void ImDrawTextLayout::BuildGlyphs()
+{
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+    Glyphs.resize(0);
+    Glyphs.reserve(Text.Size); // Upper bound without word-wrapping
+    QuadsCount = 0;
+
+    const bool word_wrap_enabled = (WrapWidth > 0.0f);
+    const char* word_wrap_eol = NULL;
+    const char* text_begin = Text.begin();
+    const char* text_end = Text.end();
+    const char* s = text_begin;
+    float x = 0.0f;
+    while (s < text_end)
+    {
+        ImDrawTextLayoutGlyph glyph_out;
+        memset(&glyph_out, 0, sizeof(glyph_out));
         if (word_wrap_enabled)
         {
-            // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - start_x));
+                word_wrap_eol = Font->CalcWordWrapPositionA(Scale, s, text_end, WrapWidth - x);
 
             if (s >= word_wrap_eol)
             {
-                x = start_x;
-                y += line_height;
-                if (y > clip_rect.w)
-                    break; // break out of main loop
+                x = 0.0f;
                 word_wrap_eol = NULL;
                 s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+                glyph_out.NewLine = true;
+                glyph_out.TextOffset = (int)(s - text_begin);
+                Glyphs.push_back(glyph_out);
                 continue;
             }
         }
@@ -4146,99 +5113,127 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
         if (c < 0x80)
             s += 1;
         else
-            s += ImTextCharFromUtf8(&c, s, text_end);
+            s += ImTextDecodeUtf8(&c, s, text_end);
 
         if (c < 32)
         {
             if (c == '\n')
             {
-                x = start_x;
-                y += line_height;
-                if (y > clip_rect.w)
-                    break; // break out of main loop
+                x = 0.0f;
+                glyph_out.NewLine = true;
+                glyph_out.TextOffset = (int)(s - text_begin);
+                Glyphs.push_back(glyph_out);
                 continue;
             }
             if (c == '\r')
                 continue;
         }
 
-        const ImFontGlyph* glyph = FindGlyph((ImWchar)c);
+        const ImFontGlyph* glyph = Font->FindGlyph((ImWchar)c);
         if (glyph == NULL)
             continue;
+        glyph_out.X0 = glyph->X0 * Scale;
+        glyph_out.Y0 = glyph->Y0 * Scale;
+        glyph_out.X1 = glyph->X1 * Scale;
+        glyph_out.Y1 = glyph->Y1 * Scale;
+        glyph_out.U0 = glyph->U0;
+        glyph_out.V0 = glyph->V0;
+        glyph_out.U1 = glyph->U1;
+        glyph_out.V1 = glyph->V1;
+        glyph_out.AdvanceX = glyph->AdvanceX * Scale;
+        glyph_out.Visible = (glyph->Visible != 0);
+        glyph_out.Colored = (glyph->Colored != 0);
+        Glyphs.push_back(glyph_out);
+        if (glyph_out.Visible)
+            QuadsCount++;
+        x += glyph_out.AdvanceX;
+    }
+    GlyphsReady = true;
+}
 
-        float char_width = glyph->AdvanceX * scale;
-        if (glyph->Visible)
-        {
-            // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
-            float x1 = x + glyph->X0 * scale;
-            float x2 = x + glyph->X1 * scale;
-            float y1 = y + glyph->Y0 * scale;
-            float y2 = y + glyph->Y1 * scale;
-            if (x1 <= clip_rect.z && x2 >= clip_rect.x)
-            {
-                // Render a character
-                float u1 = glyph->U0;
-                float v1 = glyph->V0;
-                float u2 = glyph->U1;
-                float v2 = glyph->V1;
-
-                // CPU side clipping used to fit text in their frame when the frame is too small. Only does clipping for axis aligned quads.
-                if (cpu_fine_clip)
-                {
-                    if (x1 < clip_rect.x)
-                    {
-                        u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
-                        x1 = clip_rect.x;
-                    }
-                    if (y1 < clip_rect.y)
-                    {
-                        v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
-                        y1 = clip_rect.y;
-                    }
-                    if (x2 > clip_rect.z)
-                    {
-                        u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
-                        x2 = clip_rect.z;
-                    }
-                    if (y2 > clip_rect.w)
-                    {
-                        v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
-                        y2 = clip_rect.w;
-                    }
-                    if (y1 >= y2)
-                    {
-                        x += char_width;
-                        continue;
-                    }
-                }
+ImDrawTextLayout* ImDrawTextLayoutCache::GetLayout(ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end)
+{
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+    const int text_len = (int)(text_end - text_begin);
+    if (!IsCacheable(text_len, wrap_width))
+        return NULL;
+    if (wrap_width <= 0.0f)
+        wrap_width = 0.0f; // CalcTextSize() default is -1.0f, RenderText() default is 0.0f
 
-                // Support for untinted glyphs
-                ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+    // Glyphs and their UV are copied in layouts
+    const ImFontAtlas* atlas = font->ContainerAtlas;
+    if (Atlas != atlas || AtlasBuildCount != atlas->BuildCount)
+    {
+        Clear();
+        Atlas = atlas;
+        AtlasBuildCount = atlas->BuildCount;
+    }
 
-                // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
-                {
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
-                    idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
-                    idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
-                    vtx_write += 4;
-                    vtx_index += 4;
-                    idx_write += 6;
-                }
-            }
+    // Same text as the last lookup
+    if (text_begin == LastText)
+    {
+        ImDrawTextLayout* layout = Layouts.GetByIndex(LastIndex);
+        if (layout->Matches(font, size, wrap_width, text_begin, text_len))
+        {
+            layout->LastUse = Generation;
+            return layout;
         }
-        x += char_width;
     }
 
-    // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
-    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
-    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
-    draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
-    draw_list->_VtxWritePtr = vtx_write;
-    draw_list->_IdxWritePtr = idx_write;
-    draw_list->_VtxCurrentIdx = vtx_index;
+    ImU32 size_bits, wrap_width_bits;
+    memcpy(&size_bits, &size, 4);
+    memcpy(&wrap_width_bits, &wrap_width, 4);
+    const ImGuiID key = ImHashDataFast(text_begin, (size_t)text_len, (ImU64)(size_t)font ^ ((ImU64)size_bits << 32) ^ ((ImU64)wrap_width_bits << 16));
+    ImDrawTextLayout* layout = Layouts.GetByKey(key);
+    if (layout == NULL)
+    {
+        // Changing values and scrolling text would only fill the cache: wait for the text to be seen again in the next generation
+        if (!SeenKeys[(Generation - 1) & 1].GetBool(key))
+        {
+            SeenKeys[Generation & 1].SetBool(key, true);
+            return NULL;
+        }
+        layout = Layouts.GetOrAddByKey(key);
+        layout->Font = font;
+        layout->Size = size;
+        layout->WrapWidth = wrap_width;
+        layout->Scale = size / font->FontSize;
+        layout->Text.resize(text_len);
+        memcpy(layout->Text.Data, text_begin, (size_t)text_len);
+    }
+    else if (!layout->Matches(font, size, wrap_width, text_begin, text_len))
+    {
+        return NULL; // Hash collision: leave the other layout alone
+    }
+    layout->LastUse = Generation;
+    LastText = text_begin;
+    LastIndex = Layouts.GetIndex(layout);
+    return layout;
+}
+
+// Start a new generation, removing layouts which haven't been used recently.
+void ImDrawTextLayoutCache::GarbageCollect()
+{
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_DrawLists);
+    Generation++;
+    SeenKeys[Generation & 1].Data.resize(0); // Keep allocation
+    LastText = NULL;
+    ImGuiStorage& map = Layouts.Map;
+    for (int n = 0; n < map.Data.Size; n++)
+        if (ImDrawTextLayout* layout = Layouts.TryGetMapData(n))
+            if (Generation - layout->LastUse > IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_AGE)
+                Layouts.Remove(map.Data[n].key, layout);
+
+    // ImPool keeps keys of removed items in its map: compact it once they are the majority (e.g. displaying changing values creates a new layout every frame)
+    if (map.Data.Size > Layouts.GetAliveCount() * 2 + 64)
+    {
+        int dst_n = 0;
+        for (int src_n = 0; src_n < map.Data.Size; src_n++)
+            if (map.Data[src_n].val_i != -1)
+                map.Data[dst_n++] = map.Data[src_n];
+        map.Data.resize(dst_n);
+        map.BuildHashIndex();
+    }
 }
 
 //-----------------------------------------------------------------------------
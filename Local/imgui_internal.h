@@ -63,6 +63,23 @@ Index of this file:
 #include <immintrin.h>
 #endif
 
+// Enable NEON intrinsics if available (AArch64 only, as we need vdivq_f32() and vsqrtq_f32())
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
+// Enable hardware CRC32C instructions for ImHashData()/ImHashStr() if available (only used with IMGUI_USE_CRC32C_HASH)
+// - x86: requires SSE 4.2 at compile-time (e.g. '-msse4.2' with GCC/Clang, '/arch:AVX' with MSVC). Emscripten only partially supports SSE 4.2 so is excluded.
+// - ARM: requires the ARMv8 CRC32 extension at compile-time (e.g. '-march=armv8-a+crc', default on AArch64 for Apple targets).
+#if defined(IMGUI_USE_CRC32C_HASH) && defined(IMGUI_ENABLE_SSE) && (defined(__SSE4_2__) || defined(__AVX__)) && !defined(__EMSCRIPTEN__)
+#define IMGUI_ENABLE_SSE4_2_CRC
+#include <nmmintrin.h>
+#elif defined(IMGUI_USE_CRC32C_HASH) && defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#define IMGUI_ENABLE_ARM_CRC
+#include <arm_acle.h>
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -124,6 +141,8 @@ Index of this file:
 struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
+struct ImDrawTextRunsJob;           // Range of deferred text runs expanded by Render()
+struct ImDrawDataDamageEntry;       // Draw list content in the previous frame, to compute damage rectangles
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
@@ -238,6 +257,17 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 #define IMGUI_DEBUG_LOG_DOCKING(...)    do { if (g.DebugLogFlags & ImGuiDebugLogFlags_EventDocking)     IMGUI_DEBUG_LOG(__VA_ARGS__); } while (0)
 #define IMGUI_DEBUG_LOG_VIEWPORT(...)   do { if (g.DebugLogFlags & ImGuiDebugLogFlags_EventViewport)    IMGUI_DEBUG_LOG(__VA_ARGS__); } while (0)
 
+// Profiler zones for the Metrics/Debugger "Profiler" section and ImGui::ProfilerExportChromeTrace(). See ImGuiProfiler.
+// The zone is ended when leaving the enclosing scope. The name needs to be a literal or a persistent string.
+#if !defined(IMGUI_DISABLE_DEBUG_TOOLS) && !defined(IMGUI_DISABLE_PROFILER)
+#define IMGUI_ENABLE_PROFILER
+#define IMGUI_PROFILER_ZONE(_NAME)                  ImGuiProfilerZoneScope IM_CONCAT(profiler_zone_, __LINE__)(_NAME, 0)
+#define IMGUI_PROFILER_ZONE_WINDOW(_NAME,_WINDOW)   ImGuiProfilerZoneScope IM_CONCAT(profiler_zone_, __LINE__)(_NAME, (_WINDOW)->ID)
+#else
+#define IMGUI_PROFILER_ZONE(_NAME)                  ((void)0)
+#define IMGUI_PROFILER_ZONE_WINDOW(_NAME,_WINDOW)   ((void)0)
+#endif
+
 // Static Asserts
 #define IM_STATIC_ASSERT(_COND)         static_assert(_COND, "")
 
@@ -267,6 +297,8 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 #define IM_ROUND(_VAL)                  ((float)(int)((_VAL) + 0.5f))                           //
 #define IM_STRINGIFY_HELPER(_X)         #_X
 #define IM_STRINGIFY(_X)                IM_STRINGIFY_HELPER(_X)                                 // Preprocessor idiom to stringify e.g. an integer.
+#define IM_CONCAT_HELPER(_A,_B)         _A##_B
+#define IM_CONCAT(_A,_B)                IM_CONCAT_HELPER(_A,_B)                                 // Preprocessor idiom to paste e.g. __LINE__ into an identifier.
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 #define IM_FLOOR IM_TRUNC
 #endif
@@ -345,6 +377,8 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+IMGUI_API ImGuiID       ImHashLiteral(const ImGuiLiteralID& lit_id, ImGuiID seed = 0);    // == ImHashStr(lit_id.Str, 0, seed)
+IMGUI_API ImGuiID       ImHashDataFast(const void* data, size_t data_size, ImU64 seed = 0);  // 8 bytes at a time, for cache keys and change detection. Values differ from ImHashData(), never use for IDs.
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -358,6 +392,13 @@ IMGUI_API ImU32         ImAlphaBlendColors(ImU32 col_a, ImU32 col_b);
 static inline bool      ImIsPowerOfTwo(int v)           { return v != 0 && (v & (v - 1)) == 0; }
 static inline bool      ImIsPowerOfTwo(ImU64 v)         { return v != 0 && (v & (v - 1)) == 0; }
 static inline int       ImUpperPowerOfTwo(int v)        { v--; v |= v >> 1; v |= v >> 2; v |= v >> 4; v |= v >> 8; v |= v >> 16; v++; return v; }
+#if defined(__GNUC__) || defined(__clang__)
+static inline int       ImCountSetBits(ImU32 v)         { return __builtin_popcount(v); }
+static inline int       ImCountTrailingZeroes(ImU32 v)  { IM_ASSERT(v != 0); return __builtin_ctz(v); }
+#else
+static inline int       ImCountSetBits(ImU32 v)         { v = v - ((v >> 1) & 0x55555555); v = (v & 0x33333333) + ((v >> 2) & 0x33333333); return (int)((((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24); }
+static inline int       ImCountTrailingZeroes(ImU32 v)  { IM_ASSERT(v != 0); static const int debruijn[32] = { 0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8, 31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 }; return debruijn[((v & (0u - v)) * 0x077CB531u) >> 27]; }
+#endif
 
 // Helpers: String
 IMGUI_API int           ImStricmp(const char* str1, const char* str2);                      // Case insensitive compare.
@@ -401,6 +442,65 @@ IMGUI_API int           ImTextCountUtf8BytesFromChar(const char* in_text, const
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                        // return number of bytes to express string in UTF-8
 IMGUI_API const char*   ImTextFindPreviousUtf8Codepoint(const char* in_text_start, const char* in_text_curr);                   // return previous UTF-8 code-point.
 IMGUI_API int           ImTextCountLines(const char* in_text, const char* in_text_end);                                         // return number of lines taken by text. trailing carriage return doesn't count as an extra line.
+IM_MSVC_RUNTIME_CHECKS_OFF
+// - ImTextSkipPrintableAscii(): return first character which isn't printable ASCII (0x20 to 0x7F), which text loops can process without decoding nor checking for control characters.
+//   Checks 16 bytes at a time with SSE2/NEON (32 with AVX2).
+// - ImTextDecodeUtf8(): same result as ImTextCharFromUtf8(), with ASCII and valid 2-3 bytes sequences decoded inline. Anything else (4 bytes sequences, invalid or truncated input) goes through ImTextCharFromUtf8().
+static inline const char* ImTextSkipPrintableAscii(const char* in_text, const char* in_text_end)
+{
+#if defined(IMGUI_ENABLE_SSE)
+#if defined(__AVX2__)
+    for (; in_text_end - in_text >= 32; in_text += 32)
+    {
+        const ImU32 mask = (ImU32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)(const void*)in_text), _mm256_set1_epi8(0x1F))); // Signed compare: bytes >= 0x80 are negative
+        if (mask != 0xFFFFFFFF)
+            return in_text + ImCountTrailingZeroes(~mask);
+    }
+#endif
+    for (; in_text_end - in_text >= 16; in_text += 16)
+    {
+        const ImU32 mask = (ImU32)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)(const void*)in_text), _mm_set1_epi8(0x1F))); // Signed compare: bytes >= 0x80 are negative
+        if (mask != 0xFFFF)
+            return in_text + ImCountTrailingZeroes(~mask & 0xFFFF);
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    for (; in_text_end - in_text >= 16; in_text += 16)
+        if (vminvq_u8(vcgtq_s8(vld1q_s8((const int8_t*)(const void*)in_text), vdupq_n_s8(0x1F))) == 0)
+            break;
+#endif
+    while (in_text < in_text_end && (signed char)*in_text > 0x1F)
+        in_text++;
+    return in_text;
+}
+
+static inline int ImTextDecodeUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    const unsigned char* s = (const unsigned char*)in_text;
+    const unsigned int c0 = s[0];
+    if (c0 < 0x80)
+    {
+        *out_char = c0;
+        return 1;
+    }
+    // Continuation bytes are checked in order and can't be 0, so we never read past a zero-terminator when 'in_text_end' is NULL.
+    const size_t available = in_text_end ? (size_t)(in_text_end - in_text) : 4;
+    if (c0 >= 0xC2 && c0 < 0xE0 && available >= 2 && (s[1] & 0xC0) == 0x80)
+    {
+        *out_char = ((c0 & 0x1F) << 6) | (s[1] & 0x3F);
+        return 2;
+    }
+    if (c0 >= 0xE0 && c0 < 0xF0 && available >= 3 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80)
+    {
+        const unsigned int c = ((c0 & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        if (c >= 0x800 && (c >> 11) != 0x1B) // Not overlong, not a surrogate half
+        {
+            *out_char = c;
+            return 3;
+        }
+    }
+    return ImTextCharFromUtf8(out_char, in_text, in_text_end);
+}
+IM_MSVC_RUNTIME_CHECKS_RESTORE
 
 // Helpers: File System
 #ifdef IMGUI_DISABLE_FILE_FUNCTIONS
@@ -716,14 +816,50 @@ struct ImChunkStream
     void    swap(ImChunkStream<T>& rhs) { rhs.Buf.swap(Buf); }
 };
 
+// Helper: ImFrameArena
+// Linear allocator for transient per-frame data. Nothing is freed individually: the whole page is recycled at once.
+// Double-buffered: data allocated during frame N stays valid until the NewFrame() of frame N+2, so it may be referenced by
+// the ImDrawData of frame N, which the backend consumes after Render().
+// Pointers are stable. When a page is full, extra blocks are allocated separately and the page is regrown to its high-water
+// mark when recycled, so an application in a steady state doesn't call MemAlloc(). No memory is allocated until first used.
+struct ImFrameArenaPage
+{
+    char*           Data;
+    int             Size;
+    int             Capacity;
+    int             OverflowSize;       // Bytes allocated in Overflow[] because Data[] was full
+    ImVector<void*> Overflow;
+
+    ImFrameArenaPage()  { Data = NULL; Size = Capacity = OverflowSize = 0; }
+};
+
+struct IMGUI_API ImFrameArena
+{
+    ImFrameArenaPage    Pages[2];
+    int                 CurrPage;
+
+    ImFrameArena()      { CurrPage = 0; }
+    ~ImFrameArena()     { clear(); }
+    void    clear();                                        // Free all memory. Invalidate all pointers.
+    void    swap();                                         // Recycle the page used two frames ago. Called by NewFrame().
+    void*   alloc(size_t sz, size_t align = 8);             // Alignment up to 16 bytes
+    int     size() const                                    { return Pages[CurrPage].Size + Pages[CurrPage].OverflowSize; }
+    int     capacity() const                                { return Pages[0].Capacity + Pages[1].Capacity; }
+};
+
 // Helper: ImGuiTextIndex
 // Maintain a line index for a text buffer. This is a strong candidate to be moved into the public API.
+// TextUnformattedIndexed() also maintains the width of the widest line, measuring appended lines only.
 struct ImGuiTextIndex
 {
     ImVector<int>   LineOffsets;
     int             EndOffset = 0;                          // Because we don't own text buffer we need to maintain EndOffset (may bake in LineOffsets?)
+    float           MaxLineWidth = 0.0f;                    // Width of widest line among the first MaxLineWidthLines lines, with MaxLineWidthFont/MaxLineWidthFontSize
+    int             MaxLineWidthLines = 0;                  // Last of those lines may have grown since: it is measured again
+    ImFont*         MaxLineWidthFont = NULL;
+    float           MaxLineWidthFontSize = 0.0f;
 
-    void            clear()                                 { LineOffsets.clear(); EndOffset = 0; }
+    void            clear()                                 { LineOffsets.clear(); EndOffset = 0; MaxLineWidth = 0.0f; MaxLineWidthLines = 0; MaxLineWidthFont = NULL; MaxLineWidthFontSize = 0.0f; }
     int             size()                                  { return LineOffsets.Size; }
     const char*     get_line_begin(const char* base, int n) { return base + LineOffsets[n]; }
     const char*     get_line_end(const char* base, int n)   { return base + (n + 1 < LineOffsets.Size ? (LineOffsets[n + 1] - 1) : EndOffset); }
@@ -761,6 +897,120 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: AddConcavePolyFilled() uses a grid to find reflex vertices when the polygon has at least this number of points.
+#ifndef IM_DRAWLIST_CONCAVE_GRID_MIN_POINTS
+#define IM_DRAWLIST_CONCAVE_GRID_MIN_POINTS                     64
+#endif
+
+// ImDrawList: Number of tessellated shapes kept by ImDrawListSharedData for ImDrawListFlags_ShapeCache. Least recently used ones are replaced.
+#ifndef IM_DRAWLIST_SHAPE_CACHE_SIZE
+#define IM_DRAWLIST_SHAPE_CACHE_SIZE                            32
+#endif
+
+// ImDrawList: Text layout cache (ImDrawListFlags_TextLayoutCache). Longer text is not cached, nor shorter text without word-wrapping (measuring it is as fast as a lookup).
+// Layouts unused for this number of frames are removed.
+#ifndef IM_DRAWLIST_TEXT_LAYOUT_CACHE_MIN_LENGTH
+#define IM_DRAWLIST_TEXT_LAYOUT_CACHE_MIN_LENGTH                16
+#endif
+#ifndef IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_LENGTH
+#define IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_LENGTH                256
+#endif
+#ifndef IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_AGE
+#define IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_AGE                   8
+#endif
+
+// ImDrawList: Deferred text (ImDrawListFlags_DeferText). Large text is split in runs of this size (in bytes), Render() groups runs into jobs of at least this number of quads.
+#ifndef IM_DRAWLIST_TEXT_RUN_SPLIT_SIZE
+#define IM_DRAWLIST_TEXT_RUN_SPLIT_SIZE                         1024
+#endif
+#ifndef IM_DRAWLIST_TEXT_RUNS_JOB_MIN_QUADS
+#define IM_DRAWLIST_TEXT_RUNS_JOB_MIN_QUADS                     1024
+#endif
+
+// Tessellation of a circle or n-gon around a unit circle (ImDrawListFlags_ShapeCache)
+// Output positions are 'center + Dir * radius + Offset': 'Dir' is the point of the unit shape which the vertex derives from,
+// 'Offset' is the stroke or anti-aliasing fringe offset, which doesn't depend on radius.
+struct ImDrawListShapeCacheVtx
+{
+    ImVec2          Dir;
+    ImVec2          Offset;
+    ImU8            ColTrans;       // Use color with alpha 0 (anti-aliasing fringe)
+    ImU8            UvIndex;        // 0: TexUvWhitePixel, 1/2: left/right edge of TexUvLines[TexLinesIndex]
+};
+
+struct ImDrawListShapeCacheKey
+{
+    int             AStep;          // > 0: full circle of ArcFastVtx[] samples with this step, 0: 'NumSegments' from PathArcTo()
+    int             NumSegments;
+    float           Thickness;      // 0.0f for filled shapes
+    ImDrawListFlags Flags;          // Anti-aliasing flags
+    float           FringeScale;
+};
+
+struct ImDrawListShapeCacheEntry
+{
+    ImDrawListShapeCacheKey             Key;
+    unsigned int                        LastUse;    // 0: unused entry
+    int                                 TexLinesIndex;
+    ImVector<ImDrawListShapeCacheVtx>   VtxBuffer;
+    ImVector<ImU16>                     IdxBuffer;
+};
+
+// A glyph or a line break of a cached text layout (ImDrawListFlags_TextLayoutCache).
+// Glyph metrics are pre-scaled, and ImFont::RenderText() applies them in the same order as when decoding text, so output is the same.
+struct ImDrawTextLayoutGlyph
+{
+    float           X0, Y0, X1, Y1;     // Scaled glyph rectangle, relative to current position
+    float           U0, V0, U1, V1;
+    float           AdvanceX;           // Scaled
+    bool            Visible;
+    bool            Colored;
+    bool            NewLine;            // Line break (from '\n' or word-wrapping), other fields are unused except TextOffset
+    int             TextOffset;         // Line break: offset of the next line in text
+};
+
+// Layout of a text for a given font, size and wrap width. Text size and glyphs are computed on first use.
+struct ImDrawTextLayout
+{
+    ImFont*                         Font;
+    float                           Size;
+    float                           WrapWidth;
+    float                           Scale;          // Size / Font->FontSize
+    int                             LastUse;        // Generation of last use
+    int                             QuadsCount;     // Number of visible glyphs in Glyphs[]
+    bool                            TextSizeReady;
+    bool                            GlyphsReady;
+    ImVec2                          TextSize;       // Font->CalcTextSizeA(Size, FLT_MAX, WrapWidth, text)
+    ImVector<char>                  Text;
+    ImVector<ImDrawTextLayoutGlyph> Glyphs;
+
+    ImDrawTextLayout()              { Font = NULL; Size = WrapWidth = Scale = 0.0f; LastUse = QuadsCount = 0; TextSizeReady = GlyphsReady = false; }
+    const ImVec2&                   GetTextSize()   { if (!TextSizeReady) { TextSize = Font->CalcTextSizeA(Size, FLT_MAX, WrapWidth, Text.begin(), Text.end()); TextSizeReady = true; } return TextSize; }
+    bool                            Matches(const ImFont* font, float size, float wrap_width, const char* text, int text_len) const { return Font == font && Size == size && WrapWidth == wrap_width && Text.Size == text_len && memcmp(Text.Data, text, (size_t)text_len) == 0; }
+    IMGUI_API void                  BuildGlyphs();
+};
+
+// Cache of text layouts, keyed by font, size, wrap width and text contents.
+// Text is only cached once it is seen in two consecutive generations, so values changing every frame and scrolling text don't churn the cache.
+// Layouts not used during the last IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_AGE generations are removed by GarbageCollect(), which ImGui::NewFrame() calls once per frame.
+// Everything is discarded when the font atlas is rebuilt.
+struct IMGUI_API ImDrawTextLayoutCache
+{
+    ImPool<ImDrawTextLayout>        Layouts;        // Map uses a hash index (set directly: SetHashIndex() would allocate, and ImDrawListSharedData() clears members after constructing them)
+    ImGuiStorage                    SeenKeys[2];    // Keys of text not cached yet, seen during the current and previous generations
+    int                             Generation;
+    const ImFontAtlas*              Atlas;
+    int                             AtlasBuildCount;
+    const char*                     LastText;       // Last layout returned by GetLayout(): text is usually measured then rendered right away
+    ImPoolIdx                       LastIndex;
+
+    ImDrawTextLayoutCache()         { Layouts.Map.UseHashIndex = true; Generation = 0; Atlas = NULL; AtlasBuildCount = 0; LastText = NULL; LastIndex = -1; }
+    void                            Clear()         { Layouts.Clear(); SeenKeys[0].Clear(); SeenKeys[1].Clear(); LastText = NULL; LastIndex = -1; }
+    static bool                     IsCacheable(int text_len, float wrap_width) { return text_len <= IM_DRAWLIST_TEXT_LAYOUT_CACHE_MAX_LENGTH && (text_len >= IM_DRAWLIST_TEXT_LAYOUT_CACHE_MIN_LENGTH || wrap_width > 0.0f); }
+    ImDrawTextLayout*               GetLayout(ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end); // Return NULL if text can't be cached
+    void                            GarbageCollect();
+};
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -773,6 +1023,7 @@ struct IMGUI_API ImDrawListSharedData
     float           CircleSegmentMaxError;      // Number of circle segments to use per pixel of radius for AddCircle() etc
     ImVec4          ClipRectFullscreen;         // Value for PushClipRectFullscreen()
     ImDrawListFlags InitialFlags;               // Initial flags at the beginning of the frame (it is possible to alter flags on a per-drawlist basis afterwards)
+    bool            UseScalarKernels;           // [Debug] Use scalar code in ImDrawList primitives even when SIMD kernels are available (to compare output and performance)
 
     // [Internal] Temp write buffer
     ImVector<ImVec2> TempBuffer;
@@ -783,15 +1034,56 @@ struct IMGUI_API ImDrawListSharedData
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
 
+    // [Internal] Cache of tessellated shapes (ImDrawListFlags_ShapeCache)
+    ImDrawListShapeCacheEntry ShapeCache[IM_DRAWLIST_SHAPE_CACHE_SIZE];
+    unsigned int    ShapeCacheUseCounter;
+    int             ShapeCacheLastIndex;        // Index of last used entry, checked first
+
+    // [Internal] Cache of text layouts (ImDrawListFlags_TextLayoutCache)
+    ImDrawTextLayoutCache TextLayoutCache;
+
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
 };
 
+// Content of a draw list as last submitted to ImDrawData, to compute ImDrawData::DamageRects[]
+struct ImDrawDataDamageEntry
+{
+    const ImDrawList*       DrawList;
+    ImGuiID                 Hash;           // Hash of commands, vertices and indices. 0 when not computed, for a list which keeps changing sizes or bounds
+    int                     CmdCount, VtxCount, IdxCount, RectInstCount;    // Compared before hashing
+    bool                    HasCallbacks;   // User callbacks may render anything within their clip rectangle, so the list is always considered changed
+    bool                    Changed;        // Changed since the previous frame
+    ImRect                  Bounds;         // Bounding box of vertices (and of user callbacks clip rectangles), clipped to the commands' clip rectangles
+};
+
+// Range of ImDrawList::_TextRuns[] expanded by Render(), possibly on another thread (io.ConfigDrawListsDeferText)
+struct ImDrawTextRunsJob
+{
+    ImDrawList*             DrawList;
+    int                     RunBegin;
+    int                     RunEnd;
+};
+
+#ifndef IM_DRAWDATA_DAMAGE_RECTS_MAX
+#define IM_DRAWDATA_DAMAGE_RECTS_MAX        8   // Maximum number of rectangles in ImDrawData::DamageRects[]. Past that, the nearest rectangles are merged.
+#endif
+
 struct ImDrawDataBuilder
 {
     ImVector<ImDrawList*>*  Layers[2];      // Pointers to global layers for: regular, tooltip. LayersP[0] is owned by DrawData.
     ImVector<ImDrawList*>   LayerData1;
 
+    // Damage tracking (ImGuiBackendFlags_RendererHasDamageRects)
+    bool                    DamagePrevValid;        // Set when DamagePrevEntries[] and DamagePrevDisplay* describe the previous Render()
+    ImVec2                  DamagePrevDisplayPos;
+    ImVec2                  DamagePrevDisplaySize;
+    ImVec2                  DamagePrevFramebufferScale;
+    ImVector<ImDrawDataDamageEntry> DamagePrevEntries;
+    ImVector<ImDrawDataDamageEntry> DamageCurrEntries;
+    ImVector<const ImDrawList*> DamageUnchangedLists;   // Lists of windows which skipped refresh: their previous entry is reused
+    ImVector<ImRect>        DamageRects;            // Temporary storage before merging
+
     ImDrawDataBuilder()                     { memset(this, 0, sizeof(*this)); }
 };
 
@@ -1168,6 +1460,7 @@ enum ImGuiWindowRefreshFlags_
     ImGuiWindowRefreshFlags_TryToAvoidRefresh   = 1 << 0,   // [EXPERIMENTAL] Try to keep existing contents, USER MUST NOT HONOR BEGIN() RETURNING FALSE AND NOT APPEND.
     ImGuiWindowRefreshFlags_RefreshOnHover      = 1 << 1,   // [EXPERIMENTAL] Always refresh on hover
     ImGuiWindowRefreshFlags_RefreshOnFocus      = 1 << 2,   // [EXPERIMENTAL] Always refresh on focus
+    ImGuiWindowRefreshFlags_RefreshOnChange     = 1 << 3,   // [EXPERIMENTAL] Refresh when inputs to the window changed: style, font, position, size, scroll, collapsed/focused state, mouse and keyboard when relevant, active/hovered ids, content version.
     // Refresh policy/frequency, Load Balancing etc.
 };
 
@@ -1214,6 +1507,7 @@ struct ImGuiNextWindowData
     ImGuiWindowClass            WindowClass;
     ImVec2                      MenuBarOffsetMinVal;    // (Always on) This is not exposed publicly, so we don't clear it and it doesn't have a corresponding flag (could we? for consistency?)
     ImGuiWindowRefreshFlags     RefreshFlagsVal;
+    ImU32                       RefreshContentVersionVal;
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
     inline void ClearFlags()    { Flags = ImGuiNextWindowDataFlags_None; }
@@ -2128,16 +2422,64 @@ struct ImGuiDebugAllocEntry
     ImS16       FreeCount;
 };
 
+// Subsystems for allocation accounting (IMGUI_ENABLE_ALLOC_TAGS).
+// Allocations are tagged with the innermost IMGUI_ALLOC_TAG_SCOPE() active at the time of the MemAlloc() call.
+enum ImGuiAllocTag
+{
+    ImGuiAllocTag_Misc,                     // Untagged: anything allocated outside of the scopes below (e.g. widgets, popups, navigation, user code)
+    ImGuiAllocTag_DrawLists,                // ImDrawList buffers and channels, ImDrawData
+    ImGuiAllocTag_Windows,                  // ImGuiWindow and what Begin()/End() allocate (state storage, ID stack, child lists)
+    ImGuiAllocTag_Tables,
+    ImGuiAllocTag_InputText,
+    ImGuiAllocTag_Fonts,                    // ImFontAtlas, ImFont, glyphs and texture data (only counted when a context is current)
+    ImGuiAllocTag_Docking,
+    ImGuiAllocTag_Settings,                 // .ini data and settings of windows, tables, docking
+    ImGuiAllocTag_COUNT
+};
+
+struct ImGuiDebugAllocTagInfo
+{
+    ImS64       LiveBytes;                  // Blocks freed while a different context is current stay counted here
+    ImS64       PeakBytes;
+    int         LiveCount;
+    int         TotalAllocCount;
+    int         FrameAllocCount;            // Current frame (since NewFrame())
+    int         FrameFreeCount;
+    ImS64       FrameAllocBytes;
+    int         LastFrameAllocCount;        // Previous frame
+    int         LastFrameFreeCount;
+    ImS64       LastFrameAllocBytes;
+};
+
 struct ImGuiDebugAllocInfo
 {
     int         TotalAllocCount;            // Number of call to MemAlloc().
     int         TotalFreeCount;
     ImS16       LastEntriesIdx;             // Current index in buffer
     ImGuiDebugAllocEntry LastEntriesBuf[6]; // Track last 6 frames that had allocations
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    ImGuiAllocTag           CurrentTag;     // Set by IMGUI_ALLOC_TAG_SCOPE()
+    ImGuiDebugAllocTagInfo  Tags[ImGuiAllocTag_COUNT];
+#endif
 
     ImGuiDebugAllocInfo() { memset(this, 0, sizeof(*this)); }
 };
 
+// Helper: set the allocation tag until the end of the scope. Use with IMGUI_ALLOC_TAG_SCOPE().
+// This writes to the current context, so like the rest of Dear ImGui it is not thread-safe.
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+#define IMGUI_ALLOC_TAG_SCOPE(_TAG)     ImGuiAllocTagScope IM_CONCAT(alloc_tag_, __LINE__)(_TAG)
+struct ImGuiAllocTagScope
+{
+    ImGuiContext*   Ctx;
+    ImGuiAllocTag   BackupTag;
+    inline ImGuiAllocTagScope(ImGuiAllocTag tag);
+    inline ~ImGuiAllocTagScope();
+};
+#else
+#define IMGUI_ALLOC_TAG_SCOPE(_TAG)     ((void)0)
+#endif
+
 struct ImGuiMetricsConfig
 {
     bool        ShowDebugLog = false;
@@ -2180,6 +2522,77 @@ struct ImGuiIDStackTool
     ImGuiIDStackTool()      { memset(this, 0, sizeof(*this)); CopyToClipboardLastTime = -FLT_MAX; }
 };
 
+#ifdef IMGUI_ENABLE_PROFILER
+
+#define IMGUI_PROFILER_FRAMES_COUNT         60      // Frames kept in the ring (for the flame graph, averages and trace export)
+#define IMGUI_PROFILER_ZONES_PER_FRAME_MAX  8192    // Zones past this count are not recorded (their parent zones still are)
+
+struct ImGuiProfilerZone
+{
+    const char*             Name;
+    ImGuiID                 WindowID;                   // Set for per-window zones (Begin, End)
+    int                     Depth;
+    ImU64                   TicksStart;
+    ImU64                   TicksEnd;
+};
+
+struct ImGuiProfilerFrame
+{
+    int                     FrameCount;
+    ImU64                   TicksStart;                 // At the start of NewFrame()
+    ImU64                   TicksEnd;                   // At the end of the last top-level zone (normally Render())
+    ImVector<ImGuiProfilerZone> Zones;                  // In opening order, so parents are before their children
+};
+
+// Aggregated zone timings over the frames in the ring (for display)
+struct ImGuiProfilerZoneStats
+{
+    const char*             Name;
+    ImGuiID                 WindowID;
+    double                  TotalMs;                    // Sum over all frames, inclusive of children zones
+    double                  MaxMs;                      // Highest total in a single frame
+    int                     Calls;
+    int                     LastFrameCount;             // For MaxMs
+    double                  LastFrameMs;
+};
+
+// Lightweight CPU profiler, recording scoped zones (IMGUI_PROFILER_ZONE()) into a ring of frames.
+// - Zones are placed at the main boundaries of NewFrame(), EndFrame(), Render() and in every Begin()/End().
+// - Recording is off until Enabled is set (e.g. from Metrics/Debugger). Whether a frame records is decided in NewFrame(), so zones are always balanced.
+// - Per-window zones cost two clock reads per Begin()/End() and are recorded only when WindowZones is also set:
+//   with many small windows this is the bulk of the overhead (~5% in the 48 docked windows benchmark vs ~1% without).
+// - Compile with IMGUI_DISABLE_PROFILER (or IMGUI_DISABLE_DEBUG_TOOLS) to remove zones entirely.
+struct ImGuiProfiler
+{
+    bool                    Enabled;                    // Record zones, starting next NewFrame()
+    bool                    Paused;                     // Keep current frames for inspection
+    bool                    WindowZones;                // Also record per-window zones (Begin, End, AddRootWindowToDrawData)
+    bool                    FrameRecording;             // Current frame is being recorded
+    bool                    FrameRecordingWindows;      // Current frame is recording per-window zones
+    int                     FrameIdx;                   // Current frame in Frames[]
+    int                     FramesCount;                // Number of valid frames in Frames[]
+    ImU64                   TicksPerSecond;             // 0 until calibrated (one frame after enabling)
+    ImU64                   CalibrationTicks;
+    ImU64                   CalibrationClockTicks;
+    ImVector<int>           ZonesStack;                 // Zones open in current frame (index in Zones[])
+    ImGuiProfilerFrame      Frames[IMGUI_PROFILER_FRAMES_COUNT];
+    ImVector<ImGuiProfilerZoneStats> StatsTemp;         // [Internal] Scratch buffer for Metrics/Debugger
+    ImGuiStorage            StatsTempMap;               // [Internal] Scratch buffer for Metrics/Debugger
+    int                     ViewFrameOffset;            // [Internal] Frame shown in flame graph, 0 = most recent completed frame
+
+    ImGuiProfiler()         { memset(this, 0, sizeof(*this)); }
+};
+
+// Helper: profiler zone ended on scope exit. Use with IMGUI_PROFILER_ZONE() macros.
+struct ImGuiProfilerZoneScope
+{
+    bool                    Active;
+    inline ImGuiProfilerZoneScope(const char* name, ImGuiID window_id);
+    inline ~ImGuiProfilerZoneScope();
+};
+
+#endif // #ifdef IMGUI_ENABLE_PROFILER
+
 //-----------------------------------------------------------------------------
 // [SECTION] Generic context hooks
 //-----------------------------------------------------------------------------
@@ -2318,6 +2731,7 @@ struct ImGuiContext
     ImGuiCol                        DebugFlashStyleColorIdx;    // (Keep close to ColorStack to share cache line)
     ImVector<ImGuiColorMod>         ColorStack;                 // Stack for PushStyleColor()/PopStyleColor() - inherited by Begin()
     ImVector<ImGuiStyleMod>         StyleVarStack;              // Stack for PushStyleVar()/PopStyleVar() - inherited by Begin()
+    ImGuiID                         StyleHash;                  // Hash of g.Style for ImGuiWindowRefreshFlags_RefreshOnChange, computed on demand. 0 after NewFrame() and PushStyleXXX()/PopStyleXXX().
     ImVector<ImFont*>               FontStack;                  // Stack for PushFont()/PopFont() - inherited by Begin()
     ImVector<ImGuiFocusScopeData>   FocusScopeStack;            // Stack for PushFocusScope()/PopFocusScope() - inherited by BeginChild(), pushed into by Begin()
     ImVector<ImGuiItemFlags>        ItemFlagsStack;             // Stack for PushItemFlag()/PopItemFlag() - inherited by Begin()
@@ -2409,6 +2823,7 @@ struct ImGuiContext
 
     // Render
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
+    ImVector<ImDrawTextRunsJob> DrawTextRunsJobs;               // Temporary storage for Render() (io.ConfigDrawListsDeferText)
 
     // Drag and Drop
     bool                    DragDropActive;
@@ -2571,6 +2986,9 @@ struct ImGuiContext
     ImGuiIDStackTool        DebugIDStackTool;
     ImGuiDebugAllocInfo     DebugAllocInfo;
     ImGuiDockNode*          DebugHoveredDockNode;               // Hovered dock node.
+#ifdef IMGUI_ENABLE_PROFILER
+    ImGuiProfiler           Profiler;
+#endif
 
     // Misc
     float                   FramerateSecPerFrame[60];           // Calculate estimate of framerate for user over the last 60 frames..
@@ -2581,6 +2999,7 @@ struct ImGuiContext
     int                     WantCaptureKeyboardNextFrame;       // "
     int                     WantTextInputNextFrame;
     ImVector<char>          TempBuffer;                         // Temporary text buffer
+    ImFrameArena            FrameArena;                         // Transient per-frame allocations, see FrameAlloc()
     char                    TempKeychordName[64];
 
     ImGuiContext(ImFontAtlas* shared_font_atlas);
@@ -2673,6 +3092,7 @@ struct IMGUI_API ImGuiWindow
     ImGuiID                 TabId;                              // == window->GetID("#TAB")
     ImGuiID                 ChildId;                            // ID of corresponding item in parent window (for navigation to return from child window to parent window)
     ImGuiID                 PopupId;                            // ID in the popup stack when this window is used as a popup/menu (because we use generic Name/ID for recycling)
+    ImGuiID                 RefreshInputsHash;                  // [EXPERIMENTAL] Hash of inputs used by ImGuiWindowRefreshFlags_RefreshOnChange, from the last refresh.
     ImVec2                  Scroll;
     ImVec2                  ScrollMax;
     ImVec2                  ScrollTarget;                       // target scroll position. stored as cursor position with scrolling canceled out, so the highest point is always 0.0f. (FLT_MAX for no change)
@@ -2778,6 +3198,7 @@ public:
     ~ImGuiWindow();
 
     ImGuiID     GetID(const char* str, const char* str_end = NULL);
+    ImGuiID     GetID(const ImGuiLiteralID& lit_id);
     ImGuiID     GetID(const void* ptr);
     ImGuiID     GetID(int n);
     ImGuiID     GetIDFromPos(const ImVec2& p_abs);
@@ -3209,13 +3630,14 @@ namespace ImGui
     IMGUI_API ImGuiWindow*  FindBottomMostVisibleWindowWithinBeginStack(ImGuiWindow* window);
 
     // Windows: Idle, Refresh Policies [EXPERIMENTAL]
-    IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags);
+    IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags, ImU32 content_version = 0);
 
     // Fonts, drawing
     IMGUI_API void          SetCurrentFont(ImFont* font);
     inline ImFont*          GetDefaultFont() { ImGuiContext& g = *GImGui; return g.IO.FontDefault ? g.IO.FontDefault : g.IO.Fonts->Fonts[0]; }
     inline ImDrawList*      GetForegroundDrawList(ImGuiWindow* window) { return GetForegroundDrawList(window->Viewport); }
     IMGUI_API void          AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
+    IMGUI_API void          BuildDrawDataAlternateBuffers(ImDrawData* draw_data, bool vtx_compact, bool idx32);
 
     // Init
     IMGUI_API void          Initialize();
@@ -3672,6 +4094,7 @@ namespace ImGui
 
     // Widgets
     IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0);
+    IMGUI_API void          TextUnformattedIndexed(const char* text, const char* text_end, ImGuiTextIndex* index, ImGuiTextFlags flags = 0); // Same as TextUnformatted() for large text which is only appended to (e.g. a log), processing visible lines only. Call index->clear() if text is modified otherwise.
     IMGUI_API bool          ButtonEx(const char* label, const ImVec2& size_arg = ImVec2(0, 0), ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ArrowButtonEx(const char* str_id, ImGuiDir dir, ImVec2 size_arg, ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ImageButtonEx(ImGuiID id, ImTextureID texture_id, const ImVec2& image_size, const ImVec2& uv0, const ImVec2& uv1, const ImVec4& bg_col, const ImVec4& tint_col, ImGuiButtonFlags flags = 0);
@@ -3744,6 +4167,10 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
     IMGUI_API void          ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out);
 
+    // Transient memory (valid until the NewFrame() of the next frame, never freed individually)
+    IMGUI_API void*         FrameAlloc(size_t size, size_t align = 8);
+    IMGUI_API const char*   FrameStrdup(const char* str, const char* str_end = NULL);
+
     // Garbage collection
     IMGUI_API void          GcCompactTransientMiscBuffers();
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
@@ -3761,6 +4188,11 @@ namespace ImGui
 
     // Debug Tools
     IMGUI_API void          DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr, size_t size); // size >= 0 : alloc, size = -1 : free
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+    IMGUI_API const ImGuiDebugAllocTagInfo* DebugGetAllocTagInfo(ImGuiAllocTag tag);    // For current context
+    IMGUI_API const char*   DebugGetAllocTagName(ImGuiAllocTag tag);
+    IMGUI_API void          DebugResetAllocTagPeaks();                                  // Set peaks to current live bytes
+#endif
     IMGUI_API void          DebugDrawCursorPos(ImU32 col = IM_COL32(255, 0, 0, 255));
     IMGUI_API void          DebugDrawLineExtents(ImU32 col = IM_COL32(255, 0, 0, 255));
     IMGUI_API void          DebugDrawItemRect(ImU32 col = IM_COL32(255, 0, 0, 255));
@@ -3795,6 +4227,16 @@ namespace ImGui
     IMGUI_API void          DebugRenderKeyboardPreview(ImDrawList* draw_list);
     IMGUI_API void          DebugRenderViewportThumbnail(ImDrawList* draw_list, ImGuiViewportP* viewport, const ImRect& bb);
 
+    // Profiler
+#ifdef IMGUI_ENABLE_PROFILER
+    IMGUI_API void          ProfilerNewFrame();
+    IMGUI_API bool          ProfilerZoneBegin(const char* name, ImGuiID window_id = 0); // Prefer using IMGUI_PROFILER_ZONE() macros
+    IMGUI_API void          ProfilerZoneEnd();
+    IMGUI_API void          ProfilerExportChromeTrace(ImGuiTextBuffer* out_buf);       // Frames in the ring, as Chrome Trace Event JSON (chrome://tracing, Perfetto)
+    IMGUI_API bool          ProfilerSaveChromeTrace(const char* filename);
+    IMGUI_API void          DebugNodeProfiler(ImGuiProfiler* profiler);
+#endif
+
     // Obsolete functions
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     //inline void   SetItemUsingMouseWheel()                                            { SetItemKeyOwner(ImGuiKey_MouseWheelY); }      // Changed in 1.89
@@ -3811,6 +4253,15 @@ namespace ImGui
 
 } // namespace ImGui
 
+#ifdef IMGUI_ENABLE_ALLOC_TAGS
+inline ImGuiAllocTagScope::ImGuiAllocTagScope(ImGuiAllocTag tag)    { BackupTag = ImGuiAllocTag_Misc; Ctx = GImGui; if (Ctx) { BackupTag = Ctx->DebugAllocInfo.CurrentTag; Ctx->DebugAllocInfo.CurrentTag = tag; } }
+inline ImGuiAllocTagScope::~ImGuiAllocTagScope()                    { if (Ctx) Ctx->DebugAllocInfo.CurrentTag = BackupTag; }
+#endif
+#ifdef IMGUI_ENABLE_PROFILER
+inline ImGuiProfilerZoneScope::ImGuiProfilerZoneScope(const char* name, ImGuiID window_id) { Active = (window_id ? GImGui->Profiler.FrameRecordingWindows : GImGui->Profiler.FrameRecording) && ImGui::ProfilerZoneBegin(name, window_id); }
+inline ImGuiProfilerZoneScope::~ImGuiProfilerZoneScope()                                   { if (Active) ImGui::ProfilerZoneEnd(); }
+#endif
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] ImFontAtlas internal API
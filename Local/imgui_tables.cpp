@@ -310,6 +310,7 @@ bool    ImGui::BeginTable(const char* str_id, int columns_count, ImGuiTableFlags
 bool    ImGui::BeginTableEx(const char* name, ImGuiID id, int columns_count, ImGuiTableFlags flags, const ImVec2& outer_size, float inner_width)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Tables);
     ImGuiWindow* outer_window = GetCurrentWindow();
     if (outer_window->SkipItems) // Consistent with other tables + beneficial side effect that assert on miscalling EndTable() will be more visible.
         return false;
@@ -1330,6 +1331,7 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
 void    ImGui::EndTable()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Tables);
     ImGuiTable* table = g.CurrentTable;
     IM_ASSERT(table != NULL && "Only call EndTable() if BeginTable() returns true!");
 
@@ -2948,6 +2950,7 @@ void ImGui::TableSortSpecsSanitize(ImGuiTable* table)
 
 void ImGui::TableSortSpecsBuild(ImGuiTable* table)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Tables);
     bool dirty = table->IsSortSpecsDirty;
     if (dirty)
     {
@@ -3558,6 +3561,7 @@ static size_t TableSettingsCalcChunkSize(int columns_count)
 ImGuiTableSettings* ImGui::TableSettingsCreate(ImGuiID id, int columns_count)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     ImGuiTableSettings* settings = g.SettingsTables.alloc_chunk(TableSettingsCalcChunkSize(columns_count));
     TableSettingsInit(settings, id, columns_count, columns_count);
     return settings;
@@ -3600,6 +3604,7 @@ void ImGui::TableResetSettings(ImGuiTable* table)
 
 void ImGui::TableSaveSettings(ImGuiTable* table)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     table->IsSettingsDirty = false;
     if (table->Flags & ImGuiTableFlags_NoSavedSettings)
         return;
@@ -3656,6 +3661,7 @@ void ImGui::TableSaveSettings(ImGuiTable* table)
 void ImGui::TableLoadSettings(ImGuiTable* table)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_Settings);
     table->IsSettingsRequestLoad = false;
     if (table->Flags & ImGuiTableFlags_NoSavedSettings)
         return;
@@ -3861,6 +3867,7 @@ void ImGui::TableRemove(ImGuiTable* table)
 // Free up/compact internal Table buffers for when it gets unused
 void ImGui::TableGcCompactTransientBuffers(ImGuiTable* table)
 {
+    IMGUI_PROFILER_ZONE("TableGcCompactTransientBuffers");
     //IMGUI_DEBUG_PRINT("TableGcCompactTransientBuffers() id=0x%08X\n", table->ID);
     ImGuiContext& g = *GImGui;
     IM_ASSERT(table->MemoryCompacted == false);
@@ -3876,6 +3883,7 @@ void ImGui::TableGcCompactTransientBuffers(ImGuiTable* table)
 
 void ImGui::TableGcCompactTransientBuffers(ImGuiTableTempData* temp_data)
 {
+    IMGUI_PROFILER_ZONE("TableGcCompactTransientBuffers");
     temp_data->DrawSplitter.ClearFreeMemory();
     temp_data->LastTimeActive = -1.0f;
 }
@@ -134,6 +134,7 @@ static ImVec2   InputTextCalcTextSize(ImGuiContext* ctx, const char* text_begin,
 // [SECTION] Widgets: Text, etc.
 //-------------------------------------------------------------------------
 // - TextEx() [Internal]
+// - TextUnformattedIndexed() [Internal]
 // - TextUnformatted()
 // - Text()
 // - TextV()
@@ -257,6 +258,95 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
     }
 }
 
+// Last line of an index includes the trailing \n if any
+static const char* TextIndexGetLineEnd(ImGuiTextIndex* index, const char* text, int line_n)
+{
+    const char* line_begin = index->get_line_begin(text, line_n);
+    const char* line_end = index->get_line_end(text, line_n);
+    return (line_end > line_begin && line_end[-1] == '\n') ? line_end - 1 : line_end;
+}
+
+// Same output as TextEx() with long text, but without scanning text from the start every frame.
+// - Text appended since last call is added to 'index'. Only offsets are stored so 'text' may be reallocated (e.g. an ImGuiTextBuffer).
+// - Width of the widest line is stored in 'index' too, and only measured for new lines (unless ImGuiTextFlags_NoWidthForLargeClippedText is set).
+// - Visible lines are found from the index, so the cost per frame doesn't depend on text size.
+void ImGui::TextUnformattedIndexed(const char* text, const char* text_end, ImGuiTextIndex* index, ImGuiTextFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+    ImGuiContext& g = *GImGui;
+
+    if (text_end == NULL)
+        text_end = text + strlen(text); // FIXME-OPT
+    const int text_len = (int)(text_end - text);
+    if (text_len <= 2000 || window->DC.TextWrapPos >= 0.0f)
+    {
+        TextEx(text, text_end, flags); // Common case, and word-wrapping which we can't index
+        return;
+    }
+
+    // Index appended text
+    if (text_len < index->EndOffset)
+        index->clear();
+    index->append(text, index->EndOffset, text_len);
+    const int lines_count = index->size();
+
+    // Measure appended lines
+    ImVec2 text_size(0, 0);
+    if ((flags & ImGuiTextFlags_NoWidthForLargeClippedText) == 0)
+    {
+        if (index->MaxLineWidthFont != g.Font || index->MaxLineWidthFontSize != g.FontSize)
+        {
+            index->MaxLineWidth = 0.0f;
+            index->MaxLineWidthLines = 0;
+            index->MaxLineWidthFont = g.Font;
+            index->MaxLineWidthFontSize = g.FontSize;
+        }
+        for (int line_n = ImMax(index->MaxLineWidthLines - 1, 0); line_n < lines_count; line_n++)
+            index->MaxLineWidth = ImMax(index->MaxLineWidth, CalcTextSize(index->get_line_begin(text, line_n), TextIndexGetLineEnd(index, text, line_n)).x);
+        index->MaxLineWidthLines = lines_count;
+        text_size.x = index->MaxLineWidth;
+    }
+
+    // Lines to skip (can't skip when logging text)
+    const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+    const float line_height = GetTextLineHeight();
+    ImVec2 pos = text_pos;
+    int line_n = 0;
+    if (!g.LogEnabled)
+    {
+        int lines_skippable = (int)((window->ClipRect.Min.y - text_pos.y) / line_height);
+        if (lines_skippable > 0)
+        {
+            line_n = ImMin(lines_skippable, lines_count);
+            pos.y += line_n * line_height;
+        }
+    }
+
+    // Lines to render
+    ImRect line_rect(pos, pos + ImVec2(FLT_MAX, line_height));
+    for (; line_n < lines_count; line_n++)
+    {
+        if (IsClippedEx(line_rect, 0))
+            break;
+
+        const char* line = index->get_line_begin(text, line_n);
+        const char* line_end = TextIndexGetLineEnd(index, text, line_n);
+        text_size.x = ImMax(text_size.x, CalcTextSize(line, line_end).x);
+        RenderText(pos, line, line_end, false);
+        line_rect.Min.y += line_height;
+        line_rect.Max.y += line_height;
+        pos.y += line_height;
+    }
+    pos.y += (lines_count - line_n) * line_height;
+    text_size.y = (pos - text_pos).y;
+
+    ImRect bb(text_pos, text_pos + text_size);
+    ItemSize(text_size, 0.0f);
+    ItemAdd(bb, 0);
+}
+
 void ImGui::TextUnformatted(const char* text, const char* text_end)
 {
     TextEx(text, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
@@ -3890,11 +3980,20 @@ static ImVec2 InputTextCalcTextSize(ImGuiContext* ctx, const char* text_begin, c
     const char* s = text_begin;
     while (s < text_end)
     {
+        // Printable ASCII characters don't need decoding nor checking for line breaks
+        const char* ascii_end = ImTextSkipPrintableAscii(s, text_end);
+        if (s < ascii_end && font->IndexAdvanceX.Size >= 0x80)
+        {
+            for (; s < ascii_end; s++)
+                line_width += font->IndexAdvanceX.Data[(unsigned char)*s] * scale;
+            continue;
+        }
+
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
             s += 1;
         else
-            s += ImTextCharFromUtf8(&c, s, text_end);
+            s += ImTextDecodeUtf8(&c, s, text_end);
 
         if (c == '\n')
         {
@@ -4401,6 +4500,7 @@ void ImGui::InputTextDeactivateHook(ImGuiID id)
 //  doing UTF8 > U16 > UTF8 conversions on the go to easily interface with stb_textedit. Ideally should stay in UTF-8 all the time. See https://github.com/nothings/stb/issues/188)
 bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* callback_user_data)
 {
+    IMGUI_ALLOC_TAG_SCOPE(ImGuiAllocTag_InputText);
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return false;
@@ -4898,7 +4998,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                char* clipboard_filtered = (char*)IM_ALLOC(clipboard_len + 1);
+                char* clipboard_filtered = (char*)FrameAlloc(clipboard_len + 1, 1);
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s != 0; )
                 {
@@ -4916,7 +5016,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     stb_textedit_paste(state, state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
             }
         }
 
@@ -8008,12 +8107,19 @@ void ImGui::DebugNodeMultiSelectState(ImGuiMultiSelectState* storage)
 // - ImGuiSelectionExternalStorage
 //-------------------------------------------------------------------------
 
+// Default adapter. Compared against to detect that ids are indices, which allows UseBitset to apply ranges as bit range fills.
+static ImGuiID ImGuiSelectionBasicStorage_AdapterIndexToIndex(ImGuiSelectionBasicStorage*, int idx)
+{
+    return (ImGuiID)idx;
+}
+
 ImGuiSelectionBasicStorage::ImGuiSelectionBasicStorage()
 {
     Size = 0;
     PreserveOrder = false;
+    UseBitset = false;
     UserData = NULL;
-    AdapterIndexToStorageId = [](ImGuiSelectionBasicStorage*, int idx) { return (ImGuiID)idx; };
+    AdapterIndexToStorageId = ImGuiSelectionBasicStorage_AdapterIndexToIndex;
     _SelectionOrder = 1; // Always >0
 }
 
@@ -8022,17 +8128,29 @@ void ImGuiSelectionBasicStorage::Clear()
     Size = 0;
     _SelectionOrder = 1; // Always >0
     _Storage.Data.resize(0);
+    if (_Storage.UseHashIndex)
+        _Storage.BuildHashIndex();
+    if (_Bits.Size > 0)
+        memset(_Bits.Data, 0, (size_t)_Bits.size_in_bytes());
 }
 
 void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
 {
     ImSwap(Size, r.Size);
+    ImSwap(UseBitset, r.UseBitset);
     ImSwap(_SelectionOrder, r._SelectionOrder);
     _Storage.Data.swap(r._Storage.Data);
+    _Storage.IndexKeys.swap(r._Storage.IndexKeys);
+    _Storage.IndexPos.swap(r._Storage.IndexPos);
+    ImSwap(_Storage.IndexZeroKey, r._Storage.IndexZeroKey);
+    ImSwap(_Storage.UseHashIndex, r._Storage.UseHashIndex);
+    _Bits.swap(r._Bits);
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
 {
+    if (id < (ImGuiID)_Bits.Size * 32)
+        return IM_BITARRAY_TESTBIT(_Bits.Data, id);
     return _Storage.GetInt(id, 0) != 0;
 }
 
@@ -8047,6 +8165,31 @@ static int IMGUI_CDECL PairComparerByValueInt(const void* lhs, const void* rhs)
 // (e.g. store unselected vs compact down, compact down on demand, use raw ImVector<ImGuiID> instead of ImGuiStorage...)
 bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID* out_id)
 {
+    if (UseBitset)
+    {
+        // Iterator is the position of the next candidate: bits first (word scans), then hash set pairs.
+        const int bits_count = _Bits.Size * 32;
+        int pos = (int)(intptr_t)*opaque_it;
+        for (; pos < bits_count; pos = (pos + 32) & ~31)
+            if (ImU32 word = _Bits.Data[pos >> 5] & (~(ImU32)0 << (pos & 31)))
+            {
+                const int bit_n = (pos & ~31) + ImCountTrailingZeroes(word);
+                *opaque_it = (void*)(intptr_t)(bit_n + 1);
+                *out_id = (ImGuiID)bit_n;
+                return true;
+            }
+        for (; pos - bits_count < _Storage.Data.Size; pos++)
+            if (_Storage.Data.Data[pos - bits_count].val_i != 0)
+            {
+                *opaque_it = (void*)(intptr_t)(pos + 1);
+                *out_id = _Storage.Data.Data[pos - bits_count].key;
+                return true;
+            }
+        *opaque_it = (void*)(intptr_t)pos;
+        *out_id = 0;
+        return false;
+    }
+
     ImGuiStoragePair* it = (ImGuiStoragePair*)*opaque_it;
     ImGuiStoragePair* it_end = _Storage.Data.Data + _Storage.Data.Size;
     if (PreserveOrder && it == NULL && it_end != NULL)
@@ -8067,6 +8210,17 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
 
 void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 {
+    if (id < (ImGuiID)_Bits.Size * 32)
+    {
+        if (selected != IM_BITARRAY_TESTBIT(_Bits.Data, id))
+        {
+            if (selected) { ImBitArraySetBit(_Bits.Data, (int)id); Size++; }
+            else { ImBitArrayClearBit(_Bits.Data, (int)id); Size--; }
+        }
+        return;
+    }
+    if (UseBitset && !_Storage.UseHashIndex)
+        _Storage.SetHashIndex(true);
     int* p_int = _Storage.GetIntRef(id, 0);
     if (selected && *p_int == 0) { *p_int = _SelectionOrder++; Size++; }
     else if (!selected && *p_int != 0) { *p_int = 0; Size--; }
@@ -8094,6 +8248,78 @@ static void ImGuiSelectionBasicStorage_BatchFinish(ImGuiSelectionBasicStorage* s
         storage->BuildSortByKey(); // When done selecting: sort everything
 }
 
+// Set or clear bits in [n..n2), return the number of bits which changed value
+static int ImGuiSelectionBasicStorage_BitsetAssignRange(ImU32* arr, int n, int n2, bool selected)
+{
+    int changes = 0;
+    while (n < n2)
+    {
+        const int a_mod = (n & 31);
+        const int b_mod = (n2 - (n & ~31) >= 32) ? 32 : (n2 & 31);
+        const ImU32 mask = (ImU32)(((ImU64)1 << b_mod) - 1) & ~(ImU32)(((ImU64)1 << a_mod) - 1);
+        const ImU32 word = arr[n >> 5];
+        changes += ImCountSetBits((selected ? ~word : word) & mask);
+        arr[n >> 5] = selected ? (word | mask) : (word & ~mask);
+        n = (n + 32) & ~31;
+    }
+    return changes;
+}
+
+// Grow the bit array to cover [0..items_count), moving ids which were stored in the hash set.
+static void ImGuiSelectionBasicStorage_BitsetReserve(ImGuiSelectionBasicStorage* selection, int items_count)
+{
+    ImGuiStorage* storage = &selection->_Storage;
+    if (!storage->UseHashIndex)
+        storage->SetHashIndex(true);
+    const int old_bits_count = selection->_Bits.Size * 32;
+    if (items_count <= old_bits_count)
+        return;
+    selection->_Bits.resize((items_count + 31) >> 5, 0);
+    const int new_bits_count = selection->_Bits.Size * 32;
+    for (ImGuiStoragePair& pair : storage->Data)
+        if (pair.val_i != 0 && pair.key >= (ImGuiID)old_bits_count && pair.key < (ImGuiID)new_bits_count)
+        {
+            ImBitArraySetBit(selection->_Bits.Data, (int)pair.key);
+            pair.val_i = 0;
+        }
+}
+
+// UseBitset version of ApplyRequests(). With the default adapter ids are indices, so ranges are applied one 32-bit word at a time.
+static void ImGuiSelectionBasicStorage_BitsetApplyRequests(ImGuiSelectionBasicStorage* selection, ImGuiMultiSelectIO* ms_io)
+{
+    IM_ASSERT(!selection->PreserveOrder && "PreserveOrder is not supported with UseBitset!");
+    ImGuiSelectionBasicStorage_BitsetReserve(selection, ms_io->ItemsCount);
+    const bool ids_are_indices = (selection->AdapterIndexToStorageId == ImGuiSelectionBasicStorage_AdapterIndexToIndex);
+    for (ImGuiSelectionRequest& req : ms_io->Requests)
+    {
+        int idx_first = 0, idx_last = -1;
+        if (req.Type == ImGuiSelectionRequestType_SetAll)
+        {
+            selection->Clear();
+            if (req.Selected)
+                idx_last = ms_io->ItemsCount - 1;
+        }
+        else if (req.Type == ImGuiSelectionRequestType_SetRange)
+        {
+            idx_first = (int)req.RangeFirstItem;
+            idx_last = (int)req.RangeLastItem;
+        }
+        if (idx_first > idx_last)
+            continue;
+        if (ids_are_indices)
+        {
+            IM_ASSERT(idx_first >= 0 && idx_last < selection->_Bits.Size * 32);
+            const int changes = ImGuiSelectionBasicStorage_BitsetAssignRange(selection->_Bits.Data, idx_first, idx_last + 1, req.Selected);
+            selection->Size += req.Selected ? changes : -changes;
+        }
+        else
+        {
+            for (int idx = idx_first; idx <= idx_last; idx++)
+                selection->SetItemSelected(selection->GetStorageIdFromIndex(idx), req.Selected);
+        }
+    }
+}
+
 // Apply requests coming from BeginMultiSelect() and EndMultiSelect().
 // - Enable 'Demo->Tools->Debug Log->Selection' to see selection requests as they happen.
 // - Honoring SetRange requests requires that you can iterate/interpolate between RangeFirstItem and RangeLastItem.
@@ -8117,6 +8343,11 @@ void ImGuiSelectionBasicStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
     // Other scheme may handle SetAll differently.
     IM_ASSERT(ms_io->ItemsCount != -1 && "Missing value for items_count in BeginMultiSelect() call!");
     IM_ASSERT(AdapterIndexToStorageId != NULL);
+    if (UseBitset)
+    {
+        ImGuiSelectionBasicStorage_BitsetApplyRequests(this, ms_io);
+        return;
+    }
 
     // This is optimized/specialized to cope with very large selections (e.g. 100k+ items)
     // - A simpler version could call SetItemSelected() directly instead of ImGuiSelectionBasicStorage_BatchSetItemSelected() + ImGuiSelectionBasicStorage_BatchFinish().